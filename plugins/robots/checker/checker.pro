@@ -17,4 +17,5 @@ TEMPLATE = subdirs
 SUBDIRS = \
 	twoDModelRunner \
 	patcher \
+	trajectoryConverter \
 	scripts \
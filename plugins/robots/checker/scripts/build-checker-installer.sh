@@ -157,6 +157,7 @@ rsync -avR $qRealDir/./libtrik*.so* \
 # Copying checker itself
 cp -fP $qRealDir/2D-model .
 cp -fP $qRealDir/patcher .
+cp -fP $qRealDir/trajectoryConverter .
 cp -fP $qRealDir/check-solution.sh .
 
 #Now copy all the denendencies for all the executables into single target folder
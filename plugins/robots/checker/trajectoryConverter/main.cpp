@@ -0,0 +1,86 @@
+/* Copyright 2018 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QFile>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QTextStream>
+
+#include "trajectoryStream.h"
+
+const QString description = QObject::tr("Converts binary trajectory written by 2D-model with "
+		"--trajectory-format binary into the JSON trajectory");
+
+int main(int argc, char *argv[])
+{
+	QCoreApplication app(argc, argv);
+	QCoreApplication::setApplicationName("trajectoryConverter");
+	QCoreApplication::setApplicationVersion("1.0");
+
+	QCommandLineParser parser;
+	parser.setApplicationDescription(description);
+	parser.addHelpOption();
+	parser.addVersionOption();
+	parser.addPositionalArgument("binary-trajectory", QObject::tr("Binary trajectory file."));
+	parser.addPositionalArgument("json-trajectory", QObject::tr("File where JSON trajectory will be written."));
+
+	parser.process(app);
+
+	const QStringList positionalArgs = parser.positionalArguments();
+	if (positionalArgs.size() != 2) {
+		parser.showHelp();
+	}
+
+	QFile input(positionalArgs[0]);
+	if (!input.open(QIODevice::ReadOnly)) {
+		QTextStream(stderr) << input.errorString() << endl;
+		return 1;
+	}
+
+	QFile output(positionalArgs[1]);
+	if (!output.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+		QTextStream(stderr) << output.errorString() << endl;
+		return 1;
+	}
+
+	// The output is exactly what 2D-model writes in JSON mode, so existing trajectory consumers can read it.
+	twoDModel::TrajectoryReader reader(input);
+	bool firstObject = true;
+	QJsonObject object;
+	while (true) {
+		switch (reader.next(object)) {
+		case twoDModel::TrajectoryReader::Event::start:
+			firstObject = true;
+			output.write("[\n");
+			break;
+		case twoDModel::TrajectoryReader::Event::end:
+			output.write("]\n");
+			break;
+		case twoDModel::TrajectoryReader::Event::object:
+			if (!firstObject) {
+				output.write(", ");
+			}
+
+			output.write(QJsonDocument(object).toJson());
+			firstObject = false;
+			break;
+		case twoDModel::TrajectoryReader::Event::finished:
+			return 0;
+		case twoDModel::TrajectoryReader::Event::error:
+			QTextStream(stderr) << reader.errorString() << endl;
+			return 2;
+		}
+	}
+}
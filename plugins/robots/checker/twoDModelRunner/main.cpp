@@ -22,8 +22,10 @@
 
 #include <qrkernel/logging.h>
 #include <qrkernel/platformInfo.h>
+#include <twoDModel/engine/twoDModelEngineFacade.h>
 
 #include "runner.h"
+#include "parallelRunner.h"
 
 const int maxLogSize = 10 * 1024 * 1024;  // 10 MB
 
@@ -31,9 +33,14 @@ const QString description = QObject::tr(
 		"Emulates robot`s behaviour on TRIK Studio 2D model separately from programming environment. "\
 		"Passed .qrs will be interpreted just like when 'Run' button was pressed in TRIK Studio. \n"\
 		"In background mode the session will be terminated just after the execution ended and return code "
-		"will then contain binary information about program correctness."
+		"will then contain binary information about program correctness. "
+		"In headless mode 2D model window is not created at all, it is the fastest way to check solutions. "
+		"In batch mode the save file is opened once and checked on each field from the given folder in background, "
+		"report and trajectory options then specify folders where files for each field will be written.\n"
 		"Example: \n") +
-		"    2D-model -b --platform minimal --report report.json --trajectory trajectory.fifo example.qrs";
+		"    2D-model -b --headless --platform minimal --report report.json --trajectory trajectory.fifo example.qrs\n"
+		"    2D-model --headless --platform minimal --fields fields/example --report reports/example "
+		"--trajectory trajectories/example --jobs 4 example.qrs";
 
 void loadTranslators(const QString &locale)
 {
@@ -69,6 +76,12 @@ void initLogging()
 
 int main(int argc, char *argv[])
 {
+	// QApplication removes arguments it handles itself (like -platform) from argv, but worker processes need them.
+	QStringList originalArguments;
+	for (int i = 1; i < argc; ++i) {
+		originalArguments << QString::fromLocal8Bit(argv[i]);
+	}
+
 	qReal::PlatformInfo::enableHiDPISupport();
 	QApplication app(argc, argv);
 	QCoreApplication::setApplicationName("2D-model");
@@ -81,6 +94,7 @@ int main(int argc, char *argv[])
 	parser.addVersionOption();
 	parser.addPositionalArgument("qrs-file", QObject::tr("Save file to be interpreted."));
 	QCommandLineOption backgroundOption({"b", "background"}, QObject::tr("Run emulation in background."));
+	QCommandLineOption headlessOption("headless", QObject::tr("Run emulation without 2D model window. Implies background mode."));
 	QCommandLineOption platformOption("platform"
 			, QObject::tr("Use this option set to \"minimal\" to disable connection to X server"), "minimal");
 	QCommandLineOption reportOption("report", QObject::tr("A path to file where checker results will be written (JSON)")
@@ -89,15 +103,34 @@ int main(int argc, char *argv[])
 				" written. The writing will not be performed not immediately, each trajectory point will be written"\
 				" just when obtained by checker, so FIFOs are recommended to be targets for this option.")
 			, "path-to-trajectory", "trajectory.fifo");
+	QCommandLineOption trajectoryFormatOption("trajectory-format", QObject::tr("The format of trajectory: \"json\" "\
+				"(default) or \"binary\". Binary trajectory is much smaller and cheaper to write, but it is written in "\
+				"big blocks, so it is not suitable for FIFOs. It can be converted into JSON by trajectoryConverter.")
+			, "format", "json");
 	QCommandLineOption inputOption("input", QObject::tr("Inputs for JavaScript solution")// probably others too
 			, "path-to-input", "inputs.txt");
 	QCommandLineOption modeOption("mode", QObject::tr("Interpret mode"), "mode", "diagram");
+	QCommandLineOption jobsOption("jobs", QObject::tr("The number of processes checking fields simultaneously "\
+				"in batch mode")
+			, "jobs", "1");
+	QCommandLineOption shardOption("shard", QObject::tr("Check only fields with index K modulo N in batch mode, "\
+				"used internally to split fields between processes")
+			, "K/N");
+	QCommandLineOption fieldsOption("fields", QObject::tr("A path to folder with XML files of 2D model fields. If set, "\
+				"the save file will be checked on each of them in background, inputs for each field are taken from "\
+				"the text file with the same name")
+			, "path-to-fields");
 	parser.addOption(backgroundOption);
+	parser.addOption(headlessOption);
 	parser.addOption(platformOption);
 	parser.addOption(reportOption);
 	parser.addOption(trajectoryOption);
+	parser.addOption(trajectoryFormatOption);
 	parser.addOption(inputOption);
 	parser.addOption(modeOption);
+	parser.addOption(fieldsOption);
+	parser.addOption(jobsOption);
+	parser.addOption(shardOption);
 
 	qsrand(time(0));
 	initLogging();
@@ -114,13 +147,58 @@ int main(int argc, char *argv[])
 	}
 
 	const QString qrsFile = positionalArgs.first();
-	const bool backgroundMode = parser.isSet(backgroundOption);
+	const bool backgroundMode = parser.isSet(backgroundOption) || parser.isSet(headlessOption);
 	const QString report = parser.isSet(reportOption) ? parser.value(reportOption) : QString();
 	const QString trajectory = parser.isSet(trajectoryOption) ? parser.value(trajectoryOption) : QString();
+	const QString trajectoryFormatName = parser.value(trajectoryFormatOption);
+	if (trajectoryFormatName != "json" && trajectoryFormatName != "binary") {
+		parser.showHelp(1);
+	}
+
+	const twoDModel::TrajectoryFormat trajectoryFormat = trajectoryFormatName == "binary"
+			? twoDModel::TrajectoryFormat::binary
+			: twoDModel::TrajectoryFormat::json;
 	const QString input = parser.isSet(inputOption) ? parser.value(inputOption) : QString();
 	const QString mode = parser.isSet(modeOption) ? parser.value(modeOption) : QString("diagram");
-	twoDModel::Runner runner(report, trajectory, input, mode);
-	if (!runner.interpret(qrsFile, backgroundMode)) {
+	// Must be set before plugins are loaded, 2D model engines decide if they need the window when created.
+	twoDModel::engine::TwoDModelEngineFacade::setHeadless(parser.isSet(headlessOption));
+	const bool batchMode = parser.isSet(fieldsOption);
+	const int jobs = parser.value(jobsOption).toInt();
+	if (batchMode && jobs > 1) {
+		// Each process loads the save once and checks its own share of fields, this one only waits for them.
+		QStringList arguments;
+		for (int i = 0; i < originalArguments.size(); ++i) {
+			if (originalArguments[i] == "--jobs") {
+				++i;
+			} else if (!originalArguments[i].startsWith("--jobs=")) {
+				arguments << originalArguments[i];
+			}
+		}
+
+		const bool stopOnFail = !QDir(parser.value(fieldsOption)).exists("no-stop-on-fail");
+		twoDModel::ParallelRunner parallelRunner(arguments, jobs, stopOnFail);
+		parallelRunner.start();
+		const int exitCode = app.exec();
+		QLOG_INFO() << "------------------- APPLICATION FINISHED -------------------";
+		return exitCode;
+	}
+
+	// In batch mode report and trajectory are folders, files in them are created for each field by runner.
+	twoDModel::Runner runner(batchMode ? QString() : report, batchMode ? QString() : trajectory, input, mode
+			, trajectoryFormat);
+	if (batchMode) {
+		const QStringList shard = parser.value(shardOption).split("/");
+		if (shard.size() == 2) {
+			runner.setShard(shard[0].toInt(), shard[1].toInt());
+		}
+
+		if (!runner.interpretOnFields(qrsFile, parser.value(fieldsOption)
+				, report.isEmpty() ? "reports" : report
+				, trajectory.isEmpty() ? "trajectories" : trajectory))
+		{
+			return 2;
+		}
+	} else if (!runner.interpret(qrsFile, backgroundMode)) {
 		return 2;
 	}
 
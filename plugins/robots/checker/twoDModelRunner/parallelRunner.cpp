@@ -0,0 +1,83 @@
+/* Copyright 2018 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "parallelRunner.h"
+
+#include <QtCore/QCoreApplication>
+
+#include <qrkernel/logging.h>
+
+using namespace twoDModel;
+
+/// Crash of checker is its internal error, such exit codes are greater than 100.
+const int crashExitCode = 101;
+
+ParallelRunner::ParallelRunner(const QStringList &arguments, int jobs, bool stopOnFail)
+	: mArguments(arguments)
+	, mJobs(jobs)
+	, mStopOnFail(stopOnFail)
+{
+}
+
+void ParallelRunner::start()
+{
+	for (int i = 0; i < mJobs; ++i) {
+		QProcess * const process = new QProcess(this);
+		process->setProcessChannelMode(QProcess::ForwardedChannels);
+		connect(process, static_cast<void(QProcess::*)(int, QProcess::ExitStatus)>(&QProcess::finished)
+				, this, [this, process](int exitCode, QProcess::ExitStatus status) {
+			onFinished(process, exitCode, status);
+		});
+
+		// A process that failed to start emits no finished() signal, so it is considered failed here.
+		connect(process, &QProcess::errorOccurred, this, [this, process](QProcess::ProcessError error) {
+			if (error == QProcess::FailedToStart) {
+				QLOG_ERROR() << "Failed to start checker process" << process->arguments() << process->errorString();
+				onFinished(process, crashExitCode, QProcess::NormalExit);
+			}
+		});
+
+		const QStringList arguments = QStringList(mArguments) << "--shard" << QString("%1/%2").arg(i).arg(mJobs);
+		QLOG_INFO() << "Starting checker process" << arguments;
+		mProcesses << process;
+		++mRunning;
+		process->start(QCoreApplication::applicationFilePath(), arguments);
+	}
+}
+
+void ParallelRunner::onFinished(QProcess *process, int exitCode, QProcess::ExitStatus status)
+{
+	--mRunning;
+	if (mKilled.contains(process)) {
+		// Was stopped because of other process failure, its result does not matter.
+		exitCode = 0;
+	} else if (status == QProcess::CrashExit) {
+		QLOG_ERROR() << "Checker process crashed" << process->arguments();
+		exitCode = crashExitCode;
+	}
+
+	if (exitCode != 0 && mStopOnFail) {
+		for (QProcess * const other : mProcesses) {
+			if (other->state() != QProcess::NotRunning && !mKilled.contains(other)) {
+				mKilled << other;
+				other->kill();
+			}
+		}
+	}
+
+	mExitCode = qMax(mExitCode, exitCode);
+	if (mRunning == 0) {
+		QCoreApplication::exit(mExitCode);
+	}
+}
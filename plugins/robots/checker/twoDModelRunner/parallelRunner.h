@@ -0,0 +1,53 @@
+/* Copyright 2018 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QObject>
+#include <QtCore/QProcess>
+#include <QtCore/QSet>
+#include <QtCore/QStringList>
+
+namespace twoDModel {
+
+/// Splits batch checking between several 2D model processes, each of them checks its own share of fields.
+/// Every process has its own world, robots, timeline and interpreter, so they are completely isolated
+/// and may be simulated on different cores simultaneously.
+class ParallelRunner : public QObject
+{
+	Q_OBJECT
+
+public:
+	/// @param arguments Command line arguments of the batch session without program name and jobs option.
+	/// @param jobs The number of processes to run simultaneously.
+	/// @param stopOnFail If true then all processes will be stopped as soon as one of them reports failure.
+	ParallelRunner(const QStringList &arguments, int jobs, bool stopOnFail);
+
+	/// Launches the processes. When all of them finished application exits with the biggest code returned by them,
+	/// so it is 0 only if the program was correct on all fields.
+	void start();
+
+private:
+	void onFinished(QProcess *process, int exitCode, QProcess::ExitStatus status);
+
+	const QStringList mArguments;
+	const int mJobs;
+	const bool mStopOnFail;
+	QList<QProcess *> mProcesses;  // Has ownership via Qt parent-child system.
+	QSet<QProcess *> mKilled;
+	int mRunning = 0;
+	int mExitCode = 0;
+};
+
+}
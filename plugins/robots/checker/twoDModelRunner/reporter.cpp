@@ -21,11 +21,15 @@
 
 #include <qrutils/outFile.h>
 
+#include "trajectoryStream.h"
+
 using namespace twoDModel;
 
-Reporter::Reporter(const QString &messagesFile, const QString &trajectoryFile)
+Reporter::Reporter(const QString &messagesFile, const QString &trajectoryFile, TrajectoryFormat trajectoryFormat)
 	: mMessagesFile(new utils::OutFile(messagesFile))
-	, mTrajectoryFile(new utils::OutFile(trajectoryFile))
+	, mTrajectoryFile(trajectoryFormat == TrajectoryFormat::json ? new utils::OutFile(trajectoryFile) : nullptr)
+	, mTrajectoryWriter(trajectoryFormat == TrajectoryFormat::binary && !trajectoryFile.isEmpty()
+			? new TrajectoryWriter(trajectoryFile) : nullptr)
 {
 }
 
@@ -52,15 +56,25 @@ void Reporter::onInterpretationStart()
 {
 	mFirstMessage = true;
 	report("[\n", mTrajectoryFile);
+	if (mTrajectoryWriter) {
+		mTrajectoryWriter->writeStart();
+	}
 }
 
 void Reporter::onInterpretationEnd()
 {
 	report("]\n", mTrajectoryFile);
+	if (mTrajectoryWriter) {
+		mTrajectoryWriter->writeEnd();
+	}
 }
 
 void Reporter::newTrajectoryPoint(const QString &robotId, int timestamp, const QPointF &position, qreal rotation)
 {
+	if (mTrajectoryWriter) {
+		mTrajectoryWriter->writePoint(robotId, timestamp, position, rotation);
+	}
+
 	if (!mTrajectoryFile.isNull()) {
 		QJsonObject transition;
 		transition["robotId"] = robotId;
@@ -79,6 +93,11 @@ void Reporter::newTrajectoryPoint(const QString &robotId, int timestamp, const Q
 void Reporter::newDeviceState(const QString &robotId, int timestamp, const QString &deviceType
 		, const QString &devicePort, const QString &property, const QVariant &value)
 {
+	if (mTrajectoryWriter) {
+		mTrajectoryWriter->writeDeviceState(robotId, timestamp, deviceType, devicePort, property
+				, variantToJson(value));
+	}
+
 	if (!mTrajectoryFile.isNull()) {
 		QJsonObject modification;
 		modification["robotId"] = robotId;
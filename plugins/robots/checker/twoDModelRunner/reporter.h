@@ -23,6 +23,8 @@ class OutFile;
 
 namespace twoDModel {
 
+class TrajectoryWriter;
+
 /// Represents the type of the message showed to user.
 enum class Level
 {
@@ -32,6 +34,16 @@ enum class Level
 	, error
 };
 
+/// Format of the trajectory file written by the reporter.
+enum class TrajectoryFormat
+{
+	/// JSON array of objects, each object is written and flushed as soon as obtained, so the file may be a FIFO.
+	json = 0
+	/// Compact binary stream described in trajectoryStream.h, written in big blocks. Can be converted into JSON
+	/// by trajectoryConverter.
+	, binary
+};
+
 /// Collects information about the interpretation process and writes it into the given file as JSON report.
 class Reporter : public QObject
 {
@@ -43,7 +55,9 @@ public:
 	/// @param trajectoryFile If non-empty the information about robot`s movement will be stored there
 	/// during the interpetation (so the factical data write will not be performed in one moment, it will be written
 	/// in chunks, each chunk with the new robot transition).
-	Reporter(const QString &messagesFile, const QString &trajectoryFile);
+	/// @param trajectoryFormat The format of \a trajectoryFile.
+	Reporter(const QString &messagesFile, const QString &trajectoryFile
+			, TrajectoryFormat trajectoryFormat = TrajectoryFormat::json);
 
 	~Reporter() override;
 
@@ -91,6 +105,7 @@ private:
 	QList<QPair<Level, QString>> mMessages;
 	const QScopedPointer<utils::OutFile> mMessagesFile;
 	const QScopedPointer<utils::OutFile> mTrajectoryFile;
+	const QScopedPointer<TrajectoryWriter> mTrajectoryWriter;
 	bool mFirstMessage;
 };
 
@@ -14,18 +14,22 @@
 
 #include "runner.h"
 
+#include <QtCore/QDir>
 #include <QtCore/QFile>
 #include <QtCore/QJsonDocument>
 #include <QtCore/QJsonObject>
 #include <QtCore/QJsonValue>
 #include <QtWidgets/QApplication>
+#include <QtXml/QDomDocument>
 
+#include <qrkernel/logging.h>
+#include <twoDModel/engine/twoDModelEngineFacade.h>
 #include <twoDModel/engine/view/twoDModelWidget.h>
 #include <twoDModel/engine/model/model.h>
 
 using namespace twoDModel;
 
-Runner::Runner(const QString &report, const QString &trajectory)
+Runner::Runner(const QString &report, const QString &trajectory, TrajectoryFormat trajectoryFormat)
 	: mProjectManager(mQRealFacade.models())
 	, mMainWindow(mErrorReporter, mQRealFacade.events()
 			, mProjectManager, mQRealFacade.models().graphicalModelAssistApi())
@@ -39,20 +43,35 @@ Runner::Runner(const QString &report, const QString &trajectory)
 			, mSceneCustomizer
 			, mQRealFacade.events()
 			, mTextManager)
-	, mReporter(report, trajectory)
+	, mReporter(new Reporter(report, trajectory, trajectoryFormat))
+	, mTrajectoryFormat(trajectoryFormat)
 {
 	mPluginFacade.init(mConfigurator);
 	for (const QString &defaultSettingsFile : mPluginFacade.defaultSettingsFiles()) {
 		qReal::SettingsManager::loadDefaultSettings(defaultSettingsFile);
 	}
 
-	connect(&mErrorReporter, &qReal::ConsoleErrorReporter::informationAdded, &mReporter, &Reporter::addInformation);
-	connect(&mErrorReporter, &qReal::ConsoleErrorReporter::errorAdded, &mReporter, &Reporter::addError);
-	connect(&mErrorReporter, &qReal::ConsoleErrorReporter::criticalAdded, &mReporter, &Reporter::addError);
+	// Reporter is recreated for each field in batch mode, so messages are passed to the current one.
+	const auto addInformation = [this](const QString &message) {
+		if (mReporter) {
+			mReporter->addInformation(message);
+		}
+	};
+
+	const auto addError = [this](const QString &message) {
+		if (mReporter) {
+			mReporter->addError(message);
+		}
+	};
+
+	connect(&mErrorReporter, &qReal::ConsoleErrorReporter::informationAdded, this, addInformation);
+	connect(&mErrorReporter, &qReal::ConsoleErrorReporter::errorAdded, this, addError);
+	connect(&mErrorReporter, &qReal::ConsoleErrorReporter::criticalAdded, this, addError);
 }
 
-Runner::Runner(const QString &report, const QString &trajectory, const QString &input, const QString &mode)
-	: Runner(report, trajectory)
+Runner::Runner(const QString &report, const QString &trajectory, const QString &input, const QString &mode
+		, TrajectoryFormat trajectoryFormat)
+	: Runner(report, trajectory, trajectoryFormat)
 
 {
 	mInputsFile = input;
@@ -61,8 +80,10 @@ Runner::Runner(const QString &report, const QString &trajectory, const QString &
 
 Runner::~Runner()
 {
-	mReporter.onInterpretationEnd();
-	mReporter.reportMessages();
+	if (mReporter) {
+		mReporter->onInterpretationEnd();
+		mReporter->reportMessages();
+	}
 }
 
 bool Runner::interpret(const QString &saveFile, bool background)
@@ -71,15 +92,6 @@ bool Runner::interpret(const QString &saveFile, bool background)
 		return false;
 	}
 
-	/// @todo: A bit hacky way to get 2D model window. Actually we must not have need in this.
-	/// GUI must be separated from logic and not appear here at all.
-	QList<view::TwoDModelWidget *> twoDModelWindows;
-	for (QWidget * const widget : QApplication::allWidgets()) {
-		if (view::TwoDModelWidget * const twoDModelWindow = dynamic_cast<view::TwoDModelWidget *>(widget)) {
-			twoDModelWindows << twoDModelWindow;
-		}
-	}
-
 	if (background) {
 		connect(&mPluginFacade.eventsForKitPlugins(), &kitBase::EventsForKitPluginInterface::interpretationStopped
 				, this, [this]() {
@@ -87,16 +99,74 @@ bool Runner::interpret(const QString &saveFile, bool background)
 		});
 	}
 
-	for (view::TwoDModelWidget * const twoDModelWindow : twoDModelWindows) {
-		connect(twoDModelWindow, &view::TwoDModelWidget::widgetClosed, &mMainWindow
-				, [this]() { this->mMainWindow.emulateClose(); });
-		twoDModelWindow->model().timeline().setImmediateMode(background);
-		for (const model::RobotModel *robotModel : twoDModelWindow->model().robotModels()) {
+	connectTwoDModels(background);
+	return start();
+}
+
+bool Runner::interpretOnFields(const QString &saveFile, const QString &fieldsDirectory
+		, const QString &reportsDirectory, const QString &trajectoriesDirectory)
+{
+	if (!mProjectManager.open(saveFile)) {
+		return false;
+	}
+
+	const QDir fields(fieldsDirectory);
+	const QFileInfoList allFields = fields.entryInfoList({"*.xml"}, QDir::Files, QDir::Name);
+	for (int i = mShard; i < allFields.size(); i += mShardsCount) {
+		mFields << allFields[i];
+	}
+
+	mStopOnFail = !fields.exists("no-stop-on-fail");
+	mReportsDirectory = reportsDirectory;
+	mTrajectoriesDirectory = trajectoriesDirectory;
+	QDir().mkpath(mReportsDirectory);
+	QDir().mkpath(mTrajectoriesDirectory);
+
+	// The reporter created in constructor is not used, each field gets its own one.
+	mReporter.reset();
+
+	connect(&mPluginFacade.eventsForKitPlugins(), &kitBase::EventsForKitPluginInterface::interpretationStopped
+			, this, [this]() {
+			QTimer::singleShot(0, this, &Runner::onFieldChecked);
+	});
+
+	connectTwoDModels(true);
+	QTimer::singleShot(0, this, &Runner::checkNextField);
+	return true;
+}
+
+void Runner::setShard(int shard, int shardsCount)
+{
+	mShard = shard;
+	mShardsCount = qMax(1, shardsCount);
+}
+
+void Runner::connectTwoDModels(bool background)
+{
+	for (engine::TwoDModelEngineFacade * const twoDModel : engine::TwoDModelEngineFacade::instances()) {
+		twoDModel->model().timeline().setFastForwardMode(background);
+		twoDModel->model().setEventSkipping(background);
+		for (const model::RobotModel *robotModel : twoDModel->model().robotModels()) {
 			connectRobotModel(robotModel);
 		}
+
+		// Fields of team tasks bring their own robots, they are added to the model when the field is loaded.
+		connect(&twoDModel->model(), &model::Model::robotAdded, this, &Runner::connectRobotModel
+				, Qt::UniqueConnection);
+	}
+
+	// There are no 2D model windows in headless mode, so this is only needed when the session is shown.
+	for (QWidget * const widget : QApplication::allWidgets()) {
+		if (view::TwoDModelWidget * const twoDModelWindow = dynamic_cast<view::TwoDModelWidget *>(widget)) {
+			connect(twoDModelWindow, &view::TwoDModelWidget::widgetClosed, &mMainWindow
+					, [this]() { this->mMainWindow.emulateClose(); });
+		}
 	}
+}
 
-	mReporter.onInterpretationStart();
+bool Runner::start()
+{
+	mReporter->onInterpretationStart();
 	if (mMode == "script") {
 		return mPluginFacade.interpretCode(mInputsFile);
 	} else if (mMode == "diagram") {
@@ -106,6 +176,60 @@ bool Runner::interpret(const QString &saveFile, bool background)
 	return true;
 }
 
+void Runner::checkNextField()
+{
+	if (mFields.isEmpty() || (mFailed && mStopOnFail)) {
+		mMainWindow.emulateClose(mFailed ? 1 : 0);
+		return;
+	}
+
+	const QFileInfo field = mFields.takeFirst();
+	QLOG_INFO() << "Checking field" << field.absoluteFilePath();
+	mReporter.reset(new Reporter(QDir(mReportsDirectory).filePath(field.completeBaseName())
+			, QDir(mTrajectoriesDirectory).filePath(field.completeBaseName()), mTrajectoryFormat));
+	mInputsFile = field.absoluteDir().filePath(field.completeBaseName() + ".txt");
+
+	QFile fieldFile(field.absoluteFilePath());
+	QDomDocument world;
+	QString errorMessage;
+	int errorLine = 0;
+	int errorColumn = 0;
+	if (!fieldFile.open(QIODevice::ReadOnly | QIODevice::Text)
+			|| !world.setContent(&fieldFile, &errorMessage, &errorLine, &errorColumn)) {
+		mReporter->onInterpretationStart();
+		mReporter->addError(QString("%1:%2:%3: %4").arg(field.fileName(), QString::number(errorLine)
+				, QString::number(errorColumn), errorMessage));
+		onFieldChecked();
+		return;
+	}
+
+	// Blobs are stored in the save file, fields refer to them.
+	QDomDocument blobs;
+	blobs.setContent(mQRealFacade.models().logicalRepoApi().metaInformation("blobs").toString());
+
+	for (engine::TwoDModelEngineFacade * const twoDModel : engine::TwoDModelEngineFacade::instances()) {
+		twoDModel->model().timeline().reset();
+		twoDModel->loadWorld(world, blobs);
+	}
+
+	if (!start()) {
+		onFieldChecked();
+	}
+}
+
+void Runner::onFieldChecked()
+{
+	if (!mReporter) {
+		return;
+	}
+
+	mReporter->onInterpretationEnd();
+	mReporter->reportMessages();
+	mFailed |= mReporter->lastMessageIsError();
+	mReporter.reset();
+	checkNextField();
+}
+
 void Runner::connectRobotModel(const model::RobotModel *robotModel)
 {
 	connect(robotModel, &model::RobotModel::positionRecalculated
@@ -123,7 +247,11 @@ void Runner::connectRobotModel(const model::RobotModel *robotModel)
 
 void Runner::onRobotRided(const QPointF &newPosition, const qreal newRotation)
 {
-	mReporter.newTrajectoryPoint(
+	if (!mReporter) {
+		return;
+	}
+
+	mReporter->newTrajectoryPoint(
 			static_cast<model::RobotModel *>(sender())->info().robotId()
 			, mPluginFacade.interpreter().timeElapsed()
 			, newPosition
@@ -136,7 +264,11 @@ void Runner::onDeviceStateChanged(const QString &robotId
 		, const QString &property
 		, const QVariant &value)
 {
-	mReporter.newDeviceState(robotId
+	if (!mReporter) {
+		return;
+	}
+
+	mReporter->newDeviceState(robotId
 			, mPluginFacade.interpreter().timeElapsed()
 			, device->deviceInfo().name()
 			, device->port().name()
@@ -147,5 +279,5 @@ void Runner::onDeviceStateChanged(const QString &robotId
 
 void Runner::close()
 {
-	mMainWindow.emulateClose(mReporter.lastMessageIsError() ? 1 : 0);
+	mMainWindow.emulateClose(mReporter->lastMessageIsError() ? 1 : 0);
 }
@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <QtCore/QFileInfo>
 #include <QtCore/QScopedPointer>
 
 #include <qrgui/systemFacade/systemFacade.h>
@@ -42,14 +43,18 @@ public:
 	/// Constructor.
 	/// @param report A path to a file where JSON report about the session will be written after it ends.
 	/// @param trajectory A path to a file where robot`s trajectory will be written during the session.
-	Runner(const QString &report, const QString &trajectory);
+	/// @param trajectoryFormat The format the trajectory is written in.
+	Runner(const QString &report, const QString &trajectory
+			, TrajectoryFormat trajectoryFormat = TrajectoryFormat::json);
 
 	/// Constructor.
 	/// @param report A path to a file where JSON report about the session will be written after it ends.
 	/// @param trajectory A path to a file where robot`s trajectory will be written during the session.
 	/// @param input A path to a file where JSON with inputs for JavaScript.
 	/// @param mode Interpret mode.
-	Runner(const QString &report, const QString &trajectory, const QString &input, const QString &mode);
+	/// @param trajectoryFormat The format the trajectory is written in.
+	Runner(const QString &report, const QString &trajectory, const QString &input, const QString &mode
+			, TrajectoryFormat trajectoryFormat = TrajectoryFormat::json);
 
 	~Runner();
 
@@ -59,10 +64,33 @@ public:
 	/// will be closed immediately after the interpretation stopped.
 	bool interpret(const QString &saveFile, bool background);
 
+	/// Starts checking the given save file on a set of fields in background. The save file is opened only once,
+	/// then for each field world and robots are reset, the program is interpreted and separate report and trajectory
+	/// are written. Fields are checked in the alphabetical order, the session will be closed after the last one
+	/// with non-zero code if the program failed at least on one field.
+	/// @param saveFile QReal save file (qrs) that will be opened and interpreted.
+	/// @param fieldsDirectory A directory with XML files with 2D model fields. Inputs for JavaScript solution
+	/// are taken from the text file with the same base name as a field, if exists. If the directory contains
+	/// "no-stop-on-fail" file then checking continues after failure, otherwise it stops at the first failed field.
+	/// @param reportsDirectory A directory where report for each field will be written into a file with the same
+	/// base name as a field.
+	/// @param trajectoriesDirectory A directory where robot`s trajectory on each field will be written into a file
+	/// with the same base name as a field.
+	bool interpretOnFields(const QString &saveFile, const QString &fieldsDirectory
+			, const QString &reportsDirectory, const QString &trajectoriesDirectory);
+
+	/// Makes batch mode check only a share of fields: the ones which have index \a shard modulo \a shardsCount
+	/// in the alphabetical order. Used to split fields between several processes checking them simultaneously.
+	void setShard(int shard, int shardsCount);
+
 private slots:
 	void close();
 
 private:
+	void connectTwoDModels(bool background);
+	bool start();
+	void checkNextField();
+	void onFieldChecked();
 	void connectRobotModel(const model::RobotModel *robotModel);
 	void onRobotRided(const QPointF &newPosition, const qreal newRotation);
 	void onDeviceStateChanged(const QString &robotId, const kitBase::robotModel::robotParts::Device *device
@@ -77,9 +105,18 @@ private:
 	qReal::gui::editor::SceneCustomizer mSceneCustomizer;
 	qReal::PluginConfigurator mConfigurator;
 	interpreterCore::RobotsPluginFacade mPluginFacade;
-	Reporter mReporter;
+	QScopedPointer<Reporter> mReporter;
 	QString mInputsFile;
 	QString mMode;
+	TrajectoryFormat mTrajectoryFormat;
+
+	QList<QFileInfo> mFields;
+	QString mReportsDirectory;
+	QString mTrajectoriesDirectory;
+	int mShard = 0;
+	int mShardsCount = 1;
+	bool mStopOnFail = true;
+	bool mFailed = false;
 };
 
 }
@@ -0,0 +1,250 @@
+/* Copyright 2018 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "trajectoryStream.h"
+
+#include <QtCore/QDataStream>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QObject>
+
+using namespace twoDModel;
+using namespace trajectory;
+
+static const char signature[] = "TRJB";
+static const int signatureSize = 4;
+static const QDataStream::Version streamVersion = QDataStream::Qt_5_0;
+
+/// Records are written into the file when this many bytes are buffered.
+static const int bufferSize = 1 << 16;
+
+TrajectoryWriter::TrajectoryWriter(const QString &fileName)
+	: mFile(fileName)
+{
+	if (!mFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+		return;
+	}
+
+	QDataStream stream(&mBuffer, QIODevice::WriteOnly | QIODevice::Append);
+	stream.setVersion(streamVersion);
+	stream.writeRawData(signature, signatureSize);
+	stream << version;
+}
+
+TrajectoryWriter::~TrajectoryWriter()
+{
+	flush();
+}
+
+bool TrajectoryWriter::isOpen() const
+{
+	return mFile.isOpen();
+}
+
+void TrajectoryWriter::writeStart()
+{
+	writeRecord(RecordType::start, QByteArray());
+}
+
+void TrajectoryWriter::writeEnd()
+{
+	writeRecord(RecordType::end, QByteArray());
+	flush();
+}
+
+void TrajectoryWriter::writePoint(const QString &robotId, int timestamp, const QPointF &position, qreal rotation)
+{
+	const quint32 robot = intern(robotId);
+
+	QByteArray payload;
+	QDataStream stream(&payload, QIODevice::WriteOnly);
+	stream.setVersion(streamVersion);
+	stream << robot << static_cast<qint32>(timestamp)
+			<< static_cast<double>(position.x()) << static_cast<double>(position.y())
+			<< static_cast<double>(rotation);
+	writeRecord(RecordType::point, payload);
+}
+
+void TrajectoryWriter::writeDeviceState(const QString &robotId, int timestamp, const QString &deviceType
+		, const QString &devicePort, const QString &property, const QJsonValue &value)
+{
+	const quint32 robot = intern(robotId);
+	const quint32 device = intern(deviceType);
+	const quint32 port = intern(devicePort);
+	const quint32 propertyName = intern(property);
+
+	QByteArray payload;
+	QDataStream stream(&payload, QIODevice::WriteOnly);
+	stream.setVersion(streamVersion);
+	stream << robot << device << port << propertyName << static_cast<qint32>(timestamp)
+			<< QJsonDocument(QJsonArray({ value })).toJson(QJsonDocument::Compact);
+	writeRecord(RecordType::deviceState, payload);
+}
+
+void TrajectoryWriter::flush()
+{
+	if (mFile.isOpen() && !mBuffer.isEmpty()) {
+		mFile.write(mBuffer);
+		mFile.flush();
+	}
+
+	mBuffer.clear();
+}
+
+quint32 TrajectoryWriter::intern(const QString &string)
+{
+	const auto existing = mStrings.constFind(string);
+	if (existing != mStrings.constEnd()) {
+		return existing.value();
+	}
+
+	const quint32 index = static_cast<quint32>(mStrings.size());
+	mStrings.insert(string, index);
+
+	QByteArray payload;
+	QDataStream stream(&payload, QIODevice::WriteOnly);
+	stream.setVersion(streamVersion);
+	stream << index << string.toUtf8();
+	writeRecord(RecordType::string, payload);
+	return index;
+}
+
+void TrajectoryWriter::writeRecord(RecordType type, const QByteArray &payload)
+{
+	if (!mFile.isOpen()) {
+		return;
+	}
+
+	QDataStream stream(&mBuffer, QIODevice::WriteOnly | QIODevice::Append);
+	stream.setVersion(streamVersion);
+	stream << static_cast<quint8>(type) << payload;
+	if (mBuffer.size() >= bufferSize) {
+		flush();
+	}
+}
+
+TrajectoryReader::TrajectoryReader(QIODevice &device)
+	: mDevice(device)
+	, mHeaderRead(false)
+{
+}
+
+TrajectoryReader::Event TrajectoryReader::next(QJsonObject &object)
+{
+	QDataStream stream(&mDevice);
+	stream.setVersion(streamVersion);
+
+	if (!mHeaderRead) {
+		char header[signatureSize];
+		quint16 streamFormatVersion = 0;
+		if (stream.readRawData(header, signatureSize) != signatureSize
+				|| QByteArray(header, signatureSize) != QByteArray(signature, signatureSize)) {
+			return fail(QObject::tr("Not a binary trajectory stream"));
+		}
+
+		stream >> streamFormatVersion;
+		if (stream.status() != QDataStream::Ok || streamFormatVersion > version) {
+			return fail(QObject::tr("Unsupported binary trajectory format version"));
+		}
+
+		mHeaderRead = true;
+	}
+
+	while (!mDevice.atEnd()) {
+		quint8 type = 0;
+		QByteArray payload;
+		stream >> type >> payload;
+		if (stream.status() != QDataStream::Ok) {
+			return fail(QObject::tr("Unexpected end of trajectory stream"));
+		}
+
+		QDataStream record(payload);
+		record.setVersion(streamVersion);
+		switch (static_cast<RecordType>(type)) {
+		case RecordType::start:
+			return Event::start;
+		case RecordType::end:
+			return Event::end;
+		case RecordType::string: {
+			quint32 index = 0;
+			QByteArray string;
+			record >> index >> string;
+			if (record.status() != QDataStream::Ok || index != static_cast<quint32>(mStrings.size())) {
+				return fail(QObject::tr("Corrupted string record in trajectory stream"));
+			}
+
+			mStrings << QString::fromUtf8(string);
+			break;
+		}
+		case RecordType::point: {
+			quint32 robot = 0;
+			qint32 timestamp = 0;
+			double x = 0;
+			double y = 0;
+			double rotation = 0;
+			record >> robot >> timestamp >> x >> y >> rotation;
+			if (record.status() != QDataStream::Ok || robot >= static_cast<quint32>(mStrings.size())) {
+				return fail(QObject::tr("Corrupted trajectory point record"));
+			}
+
+			object = QJsonObject();
+			object["robotId"] = mStrings[robot];
+			object["timestamp"] = timestamp;
+			object["x"] = x;
+			object["y"] = y;
+			object["rotation"] = rotation;
+			return Event::object;
+		}
+		case RecordType::deviceState: {
+			quint32 robot = 0;
+			quint32 device = 0;
+			quint32 port = 0;
+			quint32 property = 0;
+			qint32 timestamp = 0;
+			QByteArray value;
+			record >> robot >> device >> port >> property >> timestamp >> value;
+			const quint32 stringsCount = static_cast<quint32>(mStrings.size());
+			if (record.status() != QDataStream::Ok || robot >= stringsCount || device >= stringsCount
+					|| port >= stringsCount || property >= stringsCount) {
+				return fail(QObject::tr("Corrupted device state record"));
+			}
+
+			object = QJsonObject();
+			object["robotId"] = mStrings[robot];
+			object["timestamp"] = timestamp;
+			object["device"] = mStrings[device];
+			object["port"] = mStrings[port];
+			object["property"] = mStrings[property];
+			object["value"] = QJsonDocument::fromJson(value).array().at(0);
+			return Event::object;
+		}
+		default:
+			// Records of newer versions of the format are skipped.
+			break;
+		}
+	}
+
+	return Event::finished;
+}
+
+QString TrajectoryReader::errorString() const
+{
+	return mErrorString;
+}
+
+TrajectoryReader::Event TrajectoryReader::fail(const QString &message)
+{
+	mErrorString = message;
+	return Event::error;
+}
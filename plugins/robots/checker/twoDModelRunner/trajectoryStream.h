@@ -0,0 +1,132 @@
+/* Copyright 2018 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QFile>
+#include <QtCore/QHash>
+#include <QtCore/QJsonObject>
+#include <QtCore/QJsonValue>
+#include <QtCore/QPointF>
+#include <QtCore/QStringList>
+
+namespace twoDModel {
+
+/// Binary trajectory stream. It starts with "TRJB" signature and format version (quint16), then records follow.
+/// Each record is a record type (quint8) and its payload as length-prefixed byte array, so readers may skip
+/// records they do not know. Everything is written by QDataStream in big endian.
+/// Robot ids, device types, ports and property names are written only once in string records, other records
+/// refer to them by numbers.
+namespace trajectory {
+
+/// Types of records in binary trajectory stream.
+enum class RecordType : quint8
+{
+	/// Interpretation started. No payload.
+	start = 1
+	/// Interpretation finished. No payload.
+	, end
+	/// Defines a string: number (quint32) and the string itself (UTF-8 byte array).
+	, string
+	/// Robot moved: robot id (string number), timestamp (qint32), x, y and rotation (double).
+	, point
+	/// Device property changed: robot id, device type, port and property name (string numbers),
+	/// timestamp (qint32) and the new value as compact JSON array with one element.
+	, deviceState
+};
+
+/// Current version of the binary trajectory format.
+const quint16 version = 1;
+
+}
+
+/// Writes binary trajectory stream into a file. Records are accumulated in memory and written in big blocks,
+/// so writing a record costs no system calls.
+class TrajectoryWriter
+{
+public:
+	/// Opens \a fileName for writing, the file is truncated.
+	explicit TrajectoryWriter(const QString &fileName);
+
+	/// Writes buffered records.
+	~TrajectoryWriter();
+
+	/// Returns true if the file was successfully opened.
+	bool isOpen() const;
+
+	/// Writes the mark of interpretation start.
+	void writeStart();
+
+	/// Writes the mark of interpretation end and flushes the stream.
+	void writeEnd();
+
+	/// Writes a new position of a robot.
+	void writePoint(const QString &robotId, int timestamp, const QPointF &position, qreal rotation);
+
+	/// Writes new value of some robot`s device property.
+	void writeDeviceState(const QString &robotId, int timestamp, const QString &deviceType
+			, const QString &devicePort, const QString &property, const QJsonValue &value);
+
+	/// Writes buffered records into the file.
+	void flush();
+
+private:
+	quint32 intern(const QString &string);
+	void writeRecord(trajectory::RecordType type, const QByteArray &payload);
+
+	QFile mFile;
+	QByteArray mBuffer;
+	QHash<QString, quint32> mStrings;
+};
+
+/// Reads binary trajectory stream written by TrajectoryWriter.
+class TrajectoryReader
+{
+public:
+	/// Type of an event read from the stream.
+	enum class Event
+	{
+		/// Interpretation started.
+		start
+		/// Interpretation finished.
+		, end
+		/// Robot moved or its device state changed, the event is described by JSON object.
+		, object
+		/// The stream is over.
+		, finished
+		/// The stream is corrupted or has unsupported format, see errorString().
+		, error
+	};
+
+	/// @param device Opened device the stream will be read from.
+	explicit TrajectoryReader(QIODevice &device);
+
+	/// Reads the next event. If it is an object, it is stored into \a object exactly in the form JSON trajectory
+	/// has it: robotId, timestamp, x, y and rotation keys for robot moves, robotId, timestamp, device, port,
+	/// property and value for device states.
+	Event next(QJsonObject &object);
+
+	/// Returns description of the error if stream reading failed.
+	QString errorString() const;
+
+private:
+	Event fail(const QString &message);
+
+	QIODevice &mDevice;
+	QStringList mStrings;
+	bool mHeaderRead;
+	QString mErrorString;
+};
+
+}
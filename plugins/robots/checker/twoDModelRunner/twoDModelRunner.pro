@@ -18,7 +18,7 @@ CONFIG += cmdline
 CONFIG -= app_bundle
 include(../../../../global.pri)
 
-QT += widgets
+QT += widgets xml
 
 includes(plugins/robots/interpreters/interpreterCore \
 		plugins/robots/common/kitBase \
@@ -39,8 +39,12 @@ TRANSLATIONS = \
 HEADERS += \
 	$$PWD/runner.h \
 	$$PWD/reporter.h \
+	$$PWD/trajectoryStream.h \
+	$$PWD/parallelRunner.h \
 
 SOURCES += \
 	$$PWD/main.cpp \
 	$$PWD/runner.cpp \
 	$$PWD/reporter.cpp \
+	$$PWD/trajectoryStream.cpp \
+	$$PWD/parallelRunner.cpp \
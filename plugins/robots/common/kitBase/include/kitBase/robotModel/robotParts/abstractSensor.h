@@ -30,7 +30,7 @@ class ROBOTS_KIT_BASE_EXPORT AbstractSensor : public Device
 {
 	Q_OBJECT
 	Q_CLASSINFO("direction", "input")
-	Q_PROPERTY(bool locked READ isLocked WRITE setLocked)
+	Q_PROPERTY(bool locked READ isLocked WRITE setLocked NOTIFY lockedChanged)
 
 public:
 	/// Constructor, takes device type info and port on which this sensor is configured.
@@ -61,6 +61,9 @@ signals:
 	/// every time new data is ready, regardless of "read" calls.
 	void newData(const QVariant &data);
 
+	/// Emitted when the sensor state gets locked or unlocked for writing.
+	void lockedChanged(bool locked);
+
 private:
 	bool mIsLocked;
 };
@@ -29,7 +29,7 @@ class ROBOTS_KIT_BASE_EXPORT Motor : public Device
 	Q_CLASSINFO("friendlyName", tr("Motor"))
 	Q_CLASSINFO("direction", "output")
 
-	Q_PROPERTY(int power READ power WRITE on)
+	Q_PROPERTY(int power READ power WRITE on NOTIFY powerChanged)
 
 public:
 	/// Constructor, takes device type info and port on which this motor is configured.
@@ -51,6 +51,10 @@ public:
 	/// may be noted in advanced physics mode, related to breaking).
 	virtual void off();
 
+signals:
+	/// Emitted when the motor is turned on with some other speed than before.
+	void powerChanged(int power);
+
 private:
 	int mSpeed;
 };
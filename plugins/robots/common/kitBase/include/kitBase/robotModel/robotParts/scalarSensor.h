@@ -26,7 +26,7 @@ namespace robotParts {
 class ROBOTS_KIT_BASE_EXPORT ScalarSensor : public AbstractSensor
 {
 	Q_OBJECT
-	Q_PROPERTY(int value READ lastData WRITE setLastData)
+	Q_PROPERTY(int value READ lastData WRITE setLastData NOTIFY newData)
 
 public:
 	/// Constructor, takes device type info and port on which this sensor is configured.
@@ -30,7 +30,7 @@ class ROBOTS_KIT_BASE_EXPORT VectorSensor : public AbstractSensor
 {
 	Q_OBJECT
 
-	Q_PROPERTY(QVector<int> value READ lastData WRITE setLastData)
+	Q_PROPERTY(QVector<int> value READ lastData WRITE setLastData NOTIFY newData)
 
 public:
 	/// Constructor, takes device type info and port on which this sensor is configured.
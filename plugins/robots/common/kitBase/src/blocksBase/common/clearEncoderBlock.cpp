@@ -34,7 +34,7 @@ void ClearEncoderBlock::run()
 	// Emitting done() immediately will switch current block right during SensorVariablesUpdater
 	// doing his job. This may cause bad side effects.
 	// Without it, clearEncoder effects may be delayed
-	QTimer::singleShot(0, this,  SLOT(doneNextBlock()));
+	QMetaObject::invokeMethod(this, "doneNextBlock", Qt::QueuedConnection);
 }
 
 void ClearEncoderBlock::doneNextBlock()
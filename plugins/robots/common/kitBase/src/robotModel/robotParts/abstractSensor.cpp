@@ -29,5 +29,8 @@ bool AbstractSensor::isLocked() const
 
 void AbstractSensor::setLocked(bool locked)
 {
-	mIsLocked = locked;
+	if (mIsLocked != locked) {
+		mIsLocked = locked;
+		emit lockedChanged(locked);
+	}
 }
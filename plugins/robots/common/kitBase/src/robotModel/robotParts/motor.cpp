@@ -30,7 +30,10 @@ int Motor::power() const
 
 void Motor::on(int speed)
 {
-	mSpeed = speed;
+	if (mSpeed != speed) {
+		mSpeed = speed;
+		emit powerChanged(speed);
+	}
 }
 
 void Motor::stop()
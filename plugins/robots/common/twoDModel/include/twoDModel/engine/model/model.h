@@ -88,6 +88,12 @@ public:
 	/// Activates or deactivates constraints checker.
 	void setConstraintsEnabled(bool enabled);
 
+	/// Turns on or off skipping of idle ticks. When all robots are standing still with stopped motors and nothing
+	/// moves in the world, physics is not recalculated. In fast-forward mode timeline then jumps to the nearest
+	/// moment when something can happen: some timer fires or some constraint may be satisfied. Timers, constraints
+	/// and position notifications go exactly as in step-by-step modeling.
+	void setEventSkipping(bool enabled);
+
 signals:
 	/// Emitted each time when some user actions lead to world model modifications
 	/// @param xml World model description in xml format
@@ -113,6 +119,12 @@ private:
 	int findModel(const twoDModel::robotModel::TwoDRobotModel &robotModel);
 	void initPhysics();
 
+	/// Returns true if all robots stand still with stopped motors and nothing moves in the world.
+	bool isIdle() const;
+
+	/// Returns the timestamp before which nothing can happen in the world unless some timer fires.
+	quint64 idleUntil() const;
+
 	Settings mSettings;
 	WorldModel mWorldModel;
 	Timeline mTimeline;
@@ -121,6 +133,7 @@ private:
 	qReal::ErrorReporterInterface *mErrorReporter;  // Doesn`t take ownership.
 	physics::PhysicsEngineBase *mRealisticPhysicsEngine;  // Takes ownership.
 	physics::PhysicsEngineBase *mSimplePhysicsEngine;  // Takes ownership.
+	bool mEventSkipping;
 };
 
 }
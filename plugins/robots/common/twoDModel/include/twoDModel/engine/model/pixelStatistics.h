@@ -0,0 +1,55 @@
+/* Copyright 2018 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QVector>
+#include <QtGui/QRgb>
+
+#include "twoDModel/twoDModelDeclSpec.h"
+
+namespace twoDModel {
+namespace model {
+
+/// Reductions over RGB32 pixel buffers used by light, color and line sensors of 2D model.
+/// Uses SSE2 instructions when they are available for the target, otherwise falls back to plain loops.
+/// Both implementations give exactly the same results.
+class TWO_D_MODEL_EXPORT PixelStatistics
+{
+public:
+	/// Number of colors distinguished by EV3 and NXT color sensors.
+	static const int paletteSize = 8;
+
+	/// Returns palette colors in order of color sensor readings: black, blue, green, yellow, red, white, cyan and
+	/// magenta. So the color with index i is reported by color sensor as i + 1.
+	static const uint *palette();
+
+	/// Returns the sum of brightnesses of \a count pixels, brightness of each pixel is
+	/// 0.2126 R + 0.7152 G + 0.0722 B truncated to integer.
+	static quint64 brightnessSum(const QRgb *pixels, int count);
+
+	/// Counts pixels exactly matching palette colors. Returns paletteSize + 1 numbers, the last one is a number of
+	/// pixels of all other colors.
+	static QVector<int> paletteHistogram(const QRgb *pixels, int count);
+
+	/// Returns a number of non-transparent pixels whose red, green and blue channels differ from the channels
+	/// of \a color less than by \a tolerance. Sum of indices of such pixels is stored into \a indicesSum.
+	static int closeColorsCount(const QRgb *pixels, int count, QRgb color, int tolerance, qint64 &indicesSum);
+
+	/// Returns the average color of non-transparent pixels or white if there are none.
+	static QRgb averageColor(const QRgb *pixels, int count);
+};
+
+}
+}
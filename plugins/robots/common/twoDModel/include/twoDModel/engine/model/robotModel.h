@@ -155,8 +155,20 @@ public:
 	/// Sets a physical engine. Robot recalculates its position using this engine.
 	void setPhysicalEngine(physics::PhysicsEngineBase &engine);
 
+	/// Returns true if robot stands still and will stand still while its motors are not started, so one more
+	/// step of recalculateParams() will change nothing except notifying about the same position.
+	bool isIdle() const;
+
+	/// If @arg skip is true then robot will not recalculate its parameters on ticks when both robot and
+	/// physical engine are idle. Observable behaviour is exactly the same as with recalculation.
+	void setIdleStepsSkipping(bool skip);
+
 public slots:
 	void recalculateParams();
+
+	/// Does on the skipped idle tick what recalculateParams() does when robot is idle: notifies about
+	/// the same position.
+	void skipIdleStep();
 	void nextFragment();
 
 signals:
@@ -228,6 +240,8 @@ private:
 	physics::PhysicsEngineBase *mPhysicsEngine;  // Does not take ownership
 
 	items::StartPosition *mStartPositionMarker;  // Transfers ownership to QGraphicsScene
+
+	bool mIdleStepsSkipping;
 };
 
 }
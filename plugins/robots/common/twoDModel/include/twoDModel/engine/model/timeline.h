@@ -14,7 +14,14 @@
 
 #pragma once
 
+#include <functional>
+
 #include <QtCore/QTimer>
+#include <QtCore/QMap>
+#include <QtCore/QHash>
+#include <QtCore/QSet>
+#include <QtCore/QPair>
+#include <QtCore/QMutex>
 
 #include <qrutils/interpreter/stopReason.h>
 #include <utils/timelineInterface.h>
@@ -22,9 +29,13 @@
 #include "constants.h"
 #include "twoDModel/twoDModelDeclSpec.h"
 
+class QThread;
+
 namespace twoDModel {
 namespace model {
 
+class ModelTimer;
+
 /// A timeline returning 2D-model time in ms
 class TWO_D_MODEL_EXPORT Timeline : public QObject, public utils::TimelineInterface
 {
@@ -37,6 +48,7 @@ public:
 
 	static const int normalSpeedFactor = 5;
 	static const int immediateSpeedFactor = 100000000;
+	static const int defaultEventsProcessingInterval = 100;
 
 	explicit Timeline(QObject *parent = nullptr);
 
@@ -53,6 +65,43 @@ public:
 	/// Thus the immediate process modeling may be performed in background.
 	void setImmediateMode(bool immediateMode);
 
+	/// If @arg fastForward is true then timeline will advance model time in a tight loop as fast as possible
+	/// without returning to event loop between ticks. Before each tick posted events are delivered (that is where
+	/// interpreted program reacts on the previous tick), so ticks and program reactions go in exactly the same
+	/// order as in immediate mode. Full events processing (timers, sockets, GUI) is performed not more often than
+	/// once per @arg eventsProcessingInterval ms of real time, so code reacting on model ticks shall defer its work
+	/// with queued calls, not with zero-interval QTimer which would fire a host-speed-dependent number of ticks late.
+	void setFastForwardMode(bool fastForward, int eventsProcessingInterval = defaultEventsProcessingInterval);
+
+	/// Sets the function returning the timestamp before which nothing can happen in the world by itself, i.e. until
+	/// some timer fires or somebody reacts on events. In fast-forward mode timeline asks it when the previous tick
+	/// caused no events and all threads working with model time wait for timers (see beginWaiting()). Then ticks
+	/// before the returned timestamp, the expiration of the nearest timer and the next frame are skipped: only
+	/// idleTick() is emitted on them. Empty @arg idleUntil (default) turns skipping off.
+	void setIdleTicksSkipping(const std::function<quint64()> &idleUntil);
+
+	/// Tells timeline that the calling thread will do nothing until @arg timer times out. Must be called before
+	/// the timer is started. If the thread resumes for another reason, it must call endWaiting().
+	/// Threads that produce or start timers are considered working until they wait for them,
+	/// ticks are never skipped while such thread works.
+	void beginWaiting(utils::AbstractTimer *timer);
+
+	/// Tells timeline that the calling thread resumed its work.
+	void endWaiting();
+
+	/// Tells timeline that a thread which will work with model time is being started. Such thread may act at any
+	/// moment before it produces or starts its first timer and so becomes known to timeline, ticks are never
+	/// skipped until then. Interpreters call it right before they start their threads.
+	void expectThread();
+
+	/// Tells timeline that threads announced with expectThread() will not come, for example, because the program
+	/// is over before they worked with model time.
+	void forgetExpectedThreads();
+
+	/// Returns model time to zero, so the next start will look exactly like the first one.
+	/// Does nothing if timeline is ticking at the moment.
+	void reset();
+
 public slots:
 	void start();
 	void stop(qReal::interpretation::StopReason reason);
@@ -64,6 +113,10 @@ signals:
 	void tick();
 	void nextFrame();
 
+	/// Emitted instead of tick() on the tick which was skipped because nothing could happen in the world on it,
+	/// timestamp() already returns the timestamp of that tick. See setIdleTicksSkipping().
+	void idleTick();
+
 	/// Emitted just before timeline will emit its first tick.
 	/// @param reason The reason why the interpretation stopped.
 	void started();
@@ -80,13 +133,41 @@ signals:
 
 private slots:
 	void onTimer();
+	void fastForward();
 	void gotoNextFrame();
 	utils::AbstractTimer *produceTimerImpl();
 
+	/// Forgets the finished thread which was working with model time.
+	void forgetThread();
+
 private:
+	friend class ModelTimer;
+
 	static const int defaultRealTimeInterval = 0;
 	static const int ticksPerCycle = 3;
 
+	/// Puts \a timer into the queue so that it will fire on the first tick when \a ms pass.
+	/// Timer is rescheduled if it is already in the queue.
+	void scheduleTimer(ModelTimer *timer, int ms);
+
+	/// Removes \a timer from the queue if it is there.
+	void unscheduleTimer(ModelTimer *timer);
+
+	/// Fires timers that expire on the current tick in the order of their creation.
+	void fireTimers();
+
+	/// Advances model time by one cycle notifying subscribers and expired timers.
+	void nextTick();
+
+	/// Advances model time through the ticks on which nothing can happen in the world, see setIdleTicksSkipping().
+	void skipIdleTicks();
+
+	/// Remembers @arg thread as working with model time if it is not the thread of timeline. New thread is counted
+	/// as one of expected ones, see expectThread(). Must be called with mTimersMutex locked.
+	void registerThread(QThread *thread);
+
+	bool eventFilter(QObject *object, QEvent *event) override;
+
 	QTimer mTimer;
 	int mSpeedFactor;
 	int mCyclesCount;
@@ -94,6 +175,25 @@ private:
 	bool mIsStarted;
 	quint64 mTimestamp;
 	int mFrameLength = defaultFrameLength;
+	bool mFastForward = false;
+	bool mIsFastForwarding = false;
+	int mEventsProcessingInterval = defaultEventsProcessingInterval;
+
+	/// Scheduled timers ordered by the timestamp of the tick they expire on and then by their ids.
+	/// Timers may be started from script threads, so queue access is guarded by mTimersMutex.
+	QMap<QPair<quint64, quint64>, ModelTimer *> mTimersQueue;
+	QHash<const ModelTimer *, quint64> mTimerTimestamps;
+	quint64 mTimersCount = 0;
+	QMutex mTimersMutex;
+
+	std::function<quint64()> mIdleUntil;
+	int mDeliveredEventsCount = 0;
+
+	/// Threads other than the thread of timeline which work with model time, those of them that wait for timers
+	/// and the number of started threads that are not known yet, guarded by mTimersMutex too.
+	QSet<QThread *> mThreads;
+	QSet<QThread *> mWaitingThreads;
+	int mExpectedThreadsCount = 0;
 };
 
 }
@@ -44,6 +44,9 @@ class RegionItem;
 
 namespace model {
 
+class WallsIndex;
+class RobotTrace;
+
 class TWO_D_MODEL_EXPORT WorldModel : public QObject
 {
 	Q_OBJECT
@@ -88,8 +91,8 @@ public:
 	/// Returns a list of image items in the world model.
 	const QMap<QString, items::ImageItem *> &imageItems() const;
 
-	/// Returns a list of trace items on the floor.
-	const QList<QGraphicsLineItem *> &trace() const;
+	/// Returns robot traces drawn on the floor.
+	RobotTrace &trace() const;
 
 	/// Appends \a wall into world model.
 	void addWall(items::WallItem *wall);
@@ -215,8 +218,9 @@ signals:
 	/// Emitted each time when model is appended with some new item.
 	void regionItemAdded(items::RegionItem *item);
 
-	/// Emitted each time when model is appended with some new item.
-	void traceItemAdded(QGraphicsLineItem *item);
+	/// Emitted each time when robot trace was appended or cleared.
+	/// @param rect The area of the floor where the trace has changed.
+	void robotTraceChanged(const QRectF &rect);
 
 	/// Emitted each time when some item was removed from the 2D model world.
 	void itemRemoved(QGraphicsItem *item);
@@ -234,10 +238,11 @@ signals:
 	void backgroundImageItemAdded(items::ImageItem *item);
 
 private:
-	/// Returns true if ray intersects some wall.
-	bool checkRangeDistance(const int distance, const QPointF &position
-			, const qreal direction, const qreal scanningAngle, const QPainterPath &wallPath) const;
-	QPainterPath buildSolidItemsPath() const;
+	/// Returns united path of solid items (walls, skittles and balls) which may intersect with \a area.
+	QPainterPath buildSolidItemsPath(const QRectF &area) const;
+
+	/// Returns outlines of solid items (walls, skittles and balls) which may intersect with \a area.
+	QList<QPolygonF> buildSolidItemsPolygons(const QRectF &area) const;
 
 	void createBackgroundImageItem(const QDomElement &element);
 
@@ -253,14 +258,13 @@ private:
 	QMap<QString, items::RegionItem *> mRegions;
 	QMap<QString, Image*> mImages; // takes ownership
 	QMap<QString, int> mOrder;
-	QList<QGraphicsLineItem *> mRobotTrace;
+	QScopedPointer<RobotTrace> mRobotTrace;
 	Image *mBackgroundImage = nullptr;
 	QRect mBackgroundRect;
 	QScopedPointer<QDomDocument> mXmlFactory;
+	QScopedPointer<WallsIndex> mWallsIndex;
 	qReal::ErrorReporterInterface *mErrorReporter;  // Doesn`t take ownership.
 };
 
 }
 }
-
-Q_DECLARE_METATYPE(QGraphicsLineItem *)
@@ -15,7 +15,10 @@
 #pragma once
 
 #include <QtCore/QString>
+#include <QtCore/QList>
 #include <QtCore/QScopedPointer>
+#include <QtCore/QSharedPointer>
+#include <QtCore/QMap>
 
 #include "twoDModel/robotModel/twoDRobotModel.h"
 #include "twoDModel/engine/twoDModelControlInterface.h"
@@ -31,6 +34,7 @@ namespace twoDModel {
 
 namespace model {
 class Model;
+class RobotModel;
 }
 namespace view {
 class TwoDModelWidget;
@@ -62,6 +66,23 @@ public:
 
 	TwoDModelEngineInterface &engine();
 
+	/// Returns the model of 2D emulator managed by this facade.
+	model::Model &model();
+
+	/// Replaces the world and robots state with the given ones just like when a save with them is opened.
+	void loadWorld(const QDomDocument &worldModel, const QDomDocument &blobs);
+
+	/// Makes facades created after this call work in headless mode (or in usual one if \a headless is false).
+	/// Headless facades do not create 2D model window and dock, the world is loaded directly into the model
+	/// and the simulation runs without any scene views. Used by checker where nobody looks at the screen.
+	static void setHeadless(bool headless);
+
+	/// Returns true if facades are created in headless mode now.
+	static bool isHeadless();
+
+	/// Returns all facades existing at the moment.
+	static QList<TwoDModelEngineFacade *> instances();
+
 public slots:
 	void onStartInterpretation() override;
 	void onStopInterpretation(qReal::interpretation::StopReason reason) override;
@@ -72,9 +93,10 @@ private:
 	const QString mRobotModelName;
 
 	QScopedPointer<model::Model> mModel;
-	QScopedPointer<view::TwoDModelWidget> mView;
+	QScopedPointer<view::TwoDModelWidget> mView;  // Null in headless mode.
 	QScopedPointer<TwoDModelEngineInterface> mApi;
-	utils::SmartDock *mDock;  // Transfers ownership to main window indirectly
+	QMap<model::RobotModel *, QSharedPointer<TwoDModelEngineInterface>> mRobotsApis;  // APIs of additional robots.
+	utils::SmartDock *mDock;  // Transfers ownership to main window indirectly, null in headless mode.
 
 	qReal::TabInfo::TabType mCurrentTabInfo; // temp hack
 };
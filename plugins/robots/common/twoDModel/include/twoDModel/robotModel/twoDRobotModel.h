@@ -51,6 +51,9 @@ public:
 	/// Configures 2D model window`s engine for using it in 2D model devices emulators.
 	void setEngine(engine::TwoDModelEngineInterface &engine);
 
+	/// Forgets the engine configured by setEngine(), must be called before that engine is destroyed.
+	void resetEngine();
+
 	/// @todo move physical constants here
 
 	/// Returns a path to an image that is used for robot item.
@@ -14,9 +14,12 @@
 
 #include "constraintsChecker.h"
 
+#include <QtCore/QMetaProperty>
+
 #include <qrutils/stringUtils.h>
-#include <qrgui/plugins/toolPluginInterface/usedInterfaces/errorReporterInterface.h>
+#include <qrutils/graphicsUtils/abstractItem.h>
 #include <utils/objectsSet.h>
+#include <qrgui/plugins/toolPluginInterface/usedInterfaces/errorReporterInterface.h>
 
 #include "details/constraintsParser.h"
 #include "details/event.h"
@@ -26,6 +29,8 @@
 #include "src/engine/items/ballItem.h"
 #include "src/engine/items/colorFieldItem.h"
 #include "src/engine/items/regions/regionItem.h"
+#include "src/engine/items/regions/boundRegion.h"
+#include "src/engine/model/robotTrace.h"
 
 
 using namespace twoDModel::constraints;
@@ -33,10 +38,13 @@ using namespace twoDModel::constraints;
 ConstraintsChecker::ConstraintsChecker(qReal::ErrorReporterInterface &errorReporter, model::Model &model)
 	: mErrorReporter(errorReporter)
 	, mModel(model)
-	, mParser(new details::ConstraintsParser(mEvents, mVariables, mObjects, mModel.timeline(), mStatus))
+	, mParser(new details::ConstraintsParser(mEvents, mVariables, mObjects, mBindingsRevision
+			, mModel.timeline(), mStatus))
 	, mParsedSuccessfully(false)
 	, mSuccessTriggered(false)
 	, mFailTriggered(false)
+	, mBindingsRevision(0)
+	, mConditionsRevision(0)
 	, mEnabled(true)
 {
 	connect(&mStatus, &details::StatusReporter::success, this, [this](bool deferred) {
@@ -50,6 +58,10 @@ ConstraintsChecker::ConstraintsChecker(qReal::ErrorReporterInterface &errorRepor
 	connect(&mStatus, &details::StatusReporter::fail, this, [this]() { mFailTriggered = true; });
 	connect(&mStatus, &details::StatusReporter::fail, this, &ConstraintsChecker::fail);
 	connect(&mStatus, &details::StatusReporter::checkerError, this, &ConstraintsChecker::checkerError);
+	connect(&mStatus, &details::StatusReporter::stateChanged, this, &ConstraintsChecker::invalidateConditions);
+	connect(&mStatus, &details::StatusReporter::objectRead, this, [this](QObject *object) {
+		mReadObjects.insert(object);
+	});
 
 	connect(&mModel.timeline(), &model::Timeline::started, this, &ConstraintsChecker::programStarted);
 	connect(&mModel.timeline(), &model::Timeline::stopped, this, &ConstraintsChecker::programFinished);
@@ -58,7 +70,8 @@ ConstraintsChecker::ConstraintsChecker(qReal::ErrorReporterInterface &errorRepor
 
 	bindToWorldModelObjects();
 	bindToRobotObjects();
-	mObjects["trace"] = new utils::ObjectsSet<QGraphicsLineItem *>(mModel.worldModel().trace(), this);
+	mObjects["trace"] = &mModel.worldModel().trace();
+	++mBindingsRevision;
 }
 
 ConstraintsChecker::~ConstraintsChecker()
@@ -76,6 +89,7 @@ bool ConstraintsChecker::parseConstraints(const QDomElement &constraintsXml)
 	qDeleteAll(mEvents);
 	mEvents.clear();
 	mActiveEvents.clear();
+	mQuietEvents.clear();
 	mVariables.clear();
 
 	mCurrentXml = constraintsXml;
@@ -99,12 +113,152 @@ void ConstraintsChecker::checkConstraints()
 		return;
 	}
 
+	const qint64 timestamp = static_cast<qint64>(mModel.timeline().timestamp());
 	QListIterator<details::Event *> iterator(mActiveEvents);
 	while (iterator.hasNext()) {
-		iterator.next()->check();
+		details::Event * const event = iterator.next();
+		if (isQuiet(event, timestamp)) {
+			continue;
+		}
+
+		mReadObjects.clear();
+		const bool fired = event->check();
+		bool observed = !fired && !event->hasVolatileCondition();
+		for (QObject * const object : mReadObjects) {
+			observed = observe(object) && observed;
+		}
+
+		if (observed) {
+			mQuietEvents[event] = qMakePair(mConditionsRevision, timestamp);
+			for (QObject * const object : mReadObjects) {
+				mDependentEvents[object].insert(event);
+			}
+		} else {
+			mQuietEvents.remove(event);
+		}
+	}
+}
+
+bool ConstraintsChecker::isQuiet(details::Event * const event, qint64 timestamp) const
+{
+	const auto quiet = mQuietEvents.constFind(event);
+	if (quiet == mQuietEvents.constEnd() || quiet.value().first != mConditionsRevision) {
+		return false;
+	}
+
+	// Condition may change its value only when some timer expires.
+	const qint64 nextTimeout = event->nextTimeout(quiet.value().second);
+	return nextTimeout < 0 || nextTimeout > timestamp;
+}
+
+qint64 ConstraintsChecker::nextCheckTimestamp() const
+{
+	if (!mEnabled) {
+		return -1;
+	}
+
+	const qint64 nextTick = static_cast<qint64>(mModel.timeline().timestamp()) + model::Timeline::timeInterval;
+	qint64 result = -1;
+	for (details::Event * const event : mActiveEvents) {
+		const auto quiet = mQuietEvents.constFind(event);
+		if (quiet == mQuietEvents.constEnd() || quiet.value().first != mConditionsRevision) {
+			return nextTick;
+		}
+
+		const qint64 nextTimeout = event->nextTimeout(quiet.value().second);
+		if (nextTimeout >= 0 && (result < 0 || nextTimeout < result)) {
+			result = nextTimeout;
+		}
+	}
+
+	return result;
+}
+
+void ConstraintsChecker::invalidateConditions()
+{
+	++mConditionsRevision;
+	mDependentEvents.clear();
+}
+
+void ConstraintsChecker::invalidateObject(QObject *object)
+{
+	for (details::Event * const event : mDependentEvents.take(object)) {
+		mQuietEvents.remove(event);
 	}
 }
 
+bool ConstraintsChecker::observe(QObject *object)
+{
+	const auto observed = mObservedObjects.constFind(object);
+	if (observed != mObservedObjects.constEnd()) {
+		return observed.value();
+	}
+
+	const auto onChanged = &ConstraintsChecker::onObservedObjectChanged;
+	bool notifies = true;
+	if (auto robot = dynamic_cast<model::RobotModel *>(object)) {
+		mRobotPositions[robot] = qMakePair(robot->position(), robot->rotation());
+		connect(robot, &model::RobotModel::positionRecalculated, this
+				, [this, robot](const QPointF &position, const qreal rotation) {
+			const QPair<QPointF, qreal> state(position, rotation);
+			if (mRobotPositions.value(robot) != state) {
+				mRobotPositions[robot] = state;
+				invalidateObject(robot);
+			}
+		});
+		connect(robot, &model::RobotModel::positionChanged, this, onChanged);
+		connect(robot, &model::RobotModel::rotationChanged, this, onChanged);
+	} else if (auto item = dynamic_cast<graphicsUtils::AbstractItem *>(object)) {
+		// Properties of items are their geometry, pen and brush.
+		connect(item, &graphicsUtils::AbstractItem::positionChanged, this, onChanged);
+		connect(item, &graphicsUtils::AbstractItem::x1Changed, this, onChanged);
+		connect(item, &graphicsUtils::AbstractItem::y1Changed, this, onChanged);
+		connect(item, &graphicsUtils::AbstractItem::x2Changed, this, onChanged);
+		connect(item, &graphicsUtils::AbstractItem::y2Changed, this, onChanged);
+		connect(item, &graphicsUtils::AbstractItem::penChanged, this, onChanged);
+		connect(item, &graphicsUtils::AbstractItem::brushChanged, this, onChanged);
+		connect(item, &QGraphicsObject::xChanged, this, onChanged);
+		connect(item, &QGraphicsObject::yChanged, this, onChanged);
+		connect(item, &QGraphicsObject::rotationChanged, this, onChanged);
+	} else if (auto region = dynamic_cast<items::RegionItem *>(object)) {
+		// Bound regions follow their items without any notification.
+		notifies = !dynamic_cast<items::BoundRegion *>(region);
+		connect(region, &QGraphicsObject::xChanged, this, onChanged);
+		connect(region, &QGraphicsObject::yChanged, this, onChanged);
+		connect(region, &QGraphicsObject::rotationChanged, this, onChanged);
+	} else if (dynamic_cast<utils::ObjectsSetBase *>(object)) {
+		// Collections (like the robot trace) grow without notifications.
+		notifies = false;
+	} else {
+		// Other objects are observed by notify signals of their properties, if all of them have ones.
+		const QMetaObject * const metaObject = object->metaObject();
+		const QMetaMethod slot = staticMetaObject.method(staticMetaObject.indexOfSlot("onObservedObjectChanged()"));
+		for (int i = QObject::staticMetaObject.propertyCount(); i < metaObject->propertyCount(); ++i) {
+			const QMetaProperty property = metaObject->property(i);
+			if (!property.hasNotifySignal()) {
+				notifies = false;
+				break;
+			}
+
+			connect(object, property.notifySignal(), this, slot, Qt::UniqueConnection);
+		}
+	}
+
+	mObservedObjects[object] = notifies;
+	connect(object, &QObject::destroyed, this, [this, object]() {
+		invalidateObject(object);
+		mObservedObjects.remove(object);
+		mRobotPositions.remove(object);
+	});
+
+	return notifies;
+}
+
+void ConstraintsChecker::onObservedObjectChanged()
+{
+	invalidateObject(sender());
+}
+
 void ConstraintsChecker::setEnabled(bool enabled)
 {
 	mEnabled = enabled;
@@ -119,6 +273,8 @@ void ConstraintsChecker::reportParserError(const QString &message)
 void ConstraintsChecker::prepareEvents()
 {
 	mActiveEvents.clear();
+	mQuietEvents.clear();
+	mDependentEvents.clear();
 	for (details::Event * const event : mEvents) {
 		connect(event, &details::Event::settedUp, this, &ConstraintsChecker::setUpEvent, Qt::UniqueConnection);
 		connect(event, &details::Event::dropped, this, &ConstraintsChecker::dropEvent, Qt::UniqueConnection);
@@ -136,6 +292,7 @@ void ConstraintsChecker::prepareEvents()
 
 void ConstraintsChecker::setUpEvent()
 {
+	invalidateConditions();
 	if (details::Event * const event = dynamic_cast<details::Event *>(sender())) {
 		if (!mActiveEvents.contains(event)) {
 			mActiveEvents << event;
@@ -148,6 +305,7 @@ void ConstraintsChecker::setUpEvent()
 
 void ConstraintsChecker::dropEvent()
 {
+	invalidateConditions();
 	if (details::Event * const event = dynamic_cast<details::Event *>(sender())) {
 		mActiveEvents.removeAll(event);
 	}
@@ -170,6 +328,9 @@ void ConstraintsChecker::bindToWorldModelObjects()
 		for (const QString &key : mObjects.keys(dynamic_cast<QObject *>(item))) {
 			mObjects.remove(key);
 		}
+
+		++mBindingsRevision;
+		invalidateConditions();
 	});
 }
 
@@ -189,16 +350,24 @@ void ConstraintsChecker::bindToRobotObjects()
 				}
 			}
 		}
+
+		++mBindingsRevision;
+		invalidateConditions();
 	});
 }
 
 void ConstraintsChecker::bindObject(const QString &id, QObject * const object)
 {
 	mObjects[id] = object;
+	++mBindingsRevision;
+	invalidateConditions();
 	connect(object, &QObject::destroyed, this, [=]() {
 		for (const QString &key : mObjects.keys(object)) {
 			mObjects.remove(key);
 		}
+
+		++mBindingsRevision;
+		invalidateConditions();
 	});
 }
 
@@ -219,6 +388,8 @@ void ConstraintsChecker::bindRobotObject(twoDModel::model::RobotModel * const ro
 	{
 		Q_UNUSED(isLoading)
 		mObjects.remove(portName(robotId, robot, port));
+		++mBindingsRevision;
+		invalidateConditions();
 	});
 }
 
@@ -226,6 +397,8 @@ void ConstraintsChecker::bindDeviceObject(const QString &robotId
 		, model::RobotModel * const robot, const kitBase::robotModel::PortInfo &port)
 {
 	mObjects[portName(robotId, robot, port)] = robot->info().configuration().device(port);
+	++mBindingsRevision;
+	invalidateConditions();
 }
 
 QString ConstraintsChecker::firstUnusedRobotId() const
@@ -14,6 +14,8 @@
 
 #pragma once
 
+#include <QtCore/QHash>
+#include <QtCore/QPointF>
 #include <QtCore/QSet>
 #include <QtXml/QDomElement>
 
@@ -50,6 +52,9 @@ class ConstraintsParser;
 /// any number of times (each timeline tick for example). If some constraints violated fail() signal will be emitted.
 /// If checker thinks that robot`s behaviour is correct and the goal is reached success() signal will be emitted.
 /// Also always checkerError() can be emitted if checker program contains runtime errors.
+/// Events whose conditions read only variables, states of events, timers and objects that notify about their changes
+/// are not rechecked while none of those changed and no timer expired since the last check that did not fire them.
+/// Objects without such notifications (the robot trace, for example) make conditions reading them checked each tick.
 class ConstraintsChecker : public QObject
 {
 	Q_OBJECT
@@ -76,6 +81,10 @@ public:
 	/// Enables or disables checker. Checker will be still disabled if true passed here but constraints list is empty.
 	void setEnabled(bool enabled);
 
+	/// Returns the timestamp of the nearest check on which some event may fire even if nothing changes in the world
+	/// till then (the next tick if some event must be checked each tick) or -1 if no event can fire so.
+	qint64 nextCheckTimestamp() const;
+
 signals:
 	/// Emitted when program execution meets <success/> trigger. That means that robot successfully accomplished its
 	/// task without violation any constraint.
@@ -88,6 +97,10 @@ signals:
 	/// Emitted when checker program written incorrectly with the reason as parameter.
 	void checkerError(const QString &message);
 
+private slots:
+	/// Called when some observed object notifies about its change.
+	void onObservedObjectChanged();
+
 private:
 	void reportParserError(const QString &message);
 
@@ -96,6 +109,18 @@ private:
 	void setUpEvent();
 	void dropEvent();
 
+	/// Called when variables, objects or events states change, so all conditions must be rechecked.
+	void invalidateConditions();
+
+	/// Returns true if the last check of \a event did not fire it and it can not fire now either.
+	bool isQuiet(details::Event * const event, qint64 timestamp) const;
+
+	/// Makes events whose conditions read \a object on their last check be rechecked.
+	void invalidateObject(QObject *object);
+
+	/// Subscribes to changes of \a object, returns false if the object does not notify about all its changes.
+	bool observe(QObject *object);
+
 	void bindToWorldModelObjects();
 	void bindToRobotObjects();
 	void bindObject(const QString &id, QObject * const object);
@@ -123,9 +148,24 @@ private:
 	details::Events mEvents;
 	details::Variables mVariables;
 	details::Objects mObjects;
+	/// Incremented each time some object is bound or unbound.
+	quint64 mBindingsRevision;
 
 	QList<details::Event *> mActiveEvents;
 
+	/// Non-volatile events that were not fired on their last check with conditions revision and timestamp of it.
+	QHash<details::Event *, QPair<quint64, qint64>> mQuietEvents;
+	quint64 mConditionsRevision;
+
+	/// Objects read by the event being checked now.
+	QSet<QObject *> mReadObjects;
+	/// Quiet events that must be rechecked when the object changes.
+	QHash<QObject *, QSet<details::Event *>> mDependentEvents;
+	/// Objects the checker subscribed to, mapped to true if they notify about all their changes.
+	QHash<QObject *, bool> mObservedObjects;
+	/// Last known positions and rotations of robots, they report each recalculation even if nothing moved.
+	QHash<QObject *, QPair<QPointF, qreal>> mRobotPositions;
+
 	QDomElement mCurrentXml;
 	bool mEnabled;
 };
@@ -116,6 +116,8 @@ Condition ConditionsFactory::inside(const QString &objectId, const QString &regi
 			return false;
 		}
 
+		emit mStatus.objectRead(region);
+		emit mStatus.objectRead(object);
 		if (QGraphicsObject * const graphicsObject = dynamic_cast<QGraphicsObject *>(object)) {
 			return region->containsItem(graphicsObject);
 		}
@@ -138,6 +140,7 @@ Condition ConditionsFactory::inside(const QString &objectId, const QString &regi
 			}
 
 			if (model::RobotModel * const robotModel = dynamic_cast<model::RobotModel *>(mObjects[robotId])) {
+				emit mStatus.objectRead(robotModel);
 				const QPointF devicePosition = robotModel->configuration().position(device->port());
 				const QPointF deviceRelativeToCenter = devicePosition
 						+ robotModel->position() - robotModel->rotationCenter();
@@ -189,6 +192,8 @@ Condition ConditionsFactory::timerCondition(int timeout, bool forceDrop, const V
 		*lastSetUpTimestamp = timestamp().toLongLong();
 	});
 
+	event.addTimer(lastSetUpTimestamp, timeout);
+
 	return [timeout, forceDrop, timestamp, &event, lastSetUpTimestamp]() {
 		const bool timeElapsed = *lastSetUpTimestamp >= 0 && timestamp().toLongLong() - *lastSetUpTimestamp >= timeout;
 		if (timeElapsed && forceDrop) {
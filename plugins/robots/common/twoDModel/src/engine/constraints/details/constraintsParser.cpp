@@ -24,6 +24,7 @@ using namespace twoDModel::constraints::details;
 ConstraintsParser::ConstraintsParser(Events &events
 		, Variables &variables
 		, const Objects &objects
+		, const quint64 &bindingsRevision
 		, const utils::TimelineInterface &timeline
 		, StatusReporter &status)
 	: mEvents(events)
@@ -32,7 +33,8 @@ ConstraintsParser::ConstraintsParser(Events &events
 	, mTimeline(timeline)
 	, mTriggers(mEvents, mVariables, status)
 	, mConditions(mEvents, mVariables, mObjects, status)
-	, mValues(mVariables, mObjects, status)
+	, mValues(mVariables, mObjects, bindingsRevision, status)
+	, mVolatileCondition(false)
 {
 }
 
@@ -67,11 +69,23 @@ bool ConstraintsParser::parse(const QString &constraintsXml)
 bool ConstraintsParser::parse(const QDomElement &constraintsXml)
 {
 	mErrors.clear();
+	mEventReferences.clear();
 	if (constraintsXml.isNull()) {
 		return true;
 	}
 
-	return parseConstraints(constraintsXml);
+	if (!parseConstraints(constraintsXml)) {
+		return false;
+	}
+
+	// Checking unknown event reports an error each time, so it can not be skipped.
+	for (const QPair<Event *, QString> &reference : mEventReferences) {
+		if (!mEvents.contains(reference.second)) {
+			reference.first->setVolatileCondition(true);
+		}
+	}
+
+	return true;
 }
 
 bool ConstraintsParser::parseConstraints(const QDomElement &constraints)
@@ -163,11 +177,13 @@ Event *ConstraintsParser::parseEventTag(const QDomElement &element)
 
 	Event * const result = new Event(id(element), mConditions.constant(true), trigger, dropsOnFire, setUpInitially);
 
+	beginCondition();
 	const Condition condition = conditionName == "condition"
 			? parseConditionTag(conditionTag, *result)
 			: parseConditionsTag(conditionTag, *result);
 
 	result->setCondition(condition);
+	endCondition(*result);
 
 	return result;
 }
@@ -193,7 +209,9 @@ Event *ConstraintsParser::parseConstraintTag(const QDomElement &element)
 
 	Event * const result = new Event(id(element), mConditions.constant(true), trigger, true, true);
 
+	beginCondition();
 	Condition condition = parseConditionsAlternative(element.firstChildElement(), *result);
+	endCondition(*result);
 
 	if (checkOnce) {
 		const Value timestamp = mValues.timestamp(mTimeline);
@@ -378,6 +396,7 @@ Condition ConstraintsParser::parseEventSettedDroppedTag(const QDomElement &eleme
 	}
 
 	const QString id = element.attribute("id");
+	mConditionEventReferences << id;
 	return element.tagName().toLower() == "settedup"
 			? mConditions.settedUp(id)
 			: mConditions.dropped(id);
@@ -397,6 +416,8 @@ Condition ConstraintsParser::parseTimerTag(const QDomElement &element, Event &ev
 
 Condition ConstraintsParser::parseUsingTag(const QDomElement &element, Event &event)
 {
+	// Triggers in "using" are executed on each check.
+	markConditionVolatile();
 	if (!assertChildrenMoreThan(element, 1)) {
 		return mConditions.constant(true);
 	}
@@ -713,6 +734,25 @@ Value ConstraintsParser::parseObjectStateTag(const QDomElement &element)
 	return mValues.objectState(element.attribute("object"));
 }
 
+void ConstraintsParser::beginCondition()
+{
+	mVolatileCondition = false;
+	mConditionEventReferences.clear();
+}
+
+void ConstraintsParser::endCondition(Event &event)
+{
+	event.setVolatileCondition(mVolatileCondition);
+	for (const QString &id : mConditionEventReferences) {
+		mEventReferences << qMakePair(&event, id);
+	}
+}
+
+void ConstraintsParser::markConditionVolatile()
+{
+	mVolatileCondition = true;
+}
+
 QString ConstraintsParser::id(const QDomElement &element) const
 {
 	const QString attribute = element.attribute("id");
@@ -45,6 +45,7 @@ public:
 	ConstraintsParser(Events &events
 		, Variables &variables
 		, const Objects &objects
+		, const quint64 &bindingsRevision
 		, const utils::TimelineInterface &timeline
 		, StatusReporter &status);
 
@@ -104,6 +105,15 @@ private:
 	Value parseUnaryValueTag(const QDomElement &element);
 	Value parseBinaryValueTag(const QDomElement &element);
 
+	/// Starts collecting what the condition that is going to be parsed reads.
+	void beginCondition();
+
+	/// Marks \a event according to what its just parsed condition reads.
+	void endCondition(Event &event);
+
+	/// Marks the condition being parsed as volatile, see Event::hasVolatileCondition().
+	void markConditionVolatile();
+
 	QString id(const QDomElement &element) const;
 	int intAttribute(const QDomElement &element, const QString &attributeName, int defaultValue = -1);
 	qreal doubleAttribute(const QDomElement &element, const QString &attributeName, qreal defaultValue = 0.0);
@@ -128,6 +138,12 @@ private:
 	const TriggersFactory mTriggers;
 	const ConditionsFactory mConditions;
 	const ValuesFactory mValues;
+
+	bool mVolatileCondition;
+	QStringList mConditionEventReferences;
+
+	/// Events and ids of events whose states their conditions read.
+	QList<QPair<Event *, QString>> mEventReferences;
 };
 
 }
@@ -42,6 +42,12 @@ signals:
 
 	/// Emitted when checker program written incorrectly with the reason as parameter.
 	void checkerError(const QString &message);
+
+	/// Emitted when some trigger modified variables or state of some object.
+	void stateChanged();
+
+	/// Emitted when some value or condition reads the state of @arg object.
+	void objectRead(QObject *object);
 };
 
 /// Represents logical operations that can be used for concatenating conditions.
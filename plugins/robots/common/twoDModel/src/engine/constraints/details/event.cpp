@@ -27,6 +27,7 @@ Event::Event(const QString &id
 	, mTrigger(trigger)
 	, mDropsOnFire(dropsOnFire)
 	, mIsSettedInitially(isSettedInitially)
+	, mVolatileCondition(false)
 {
 }
 
@@ -57,10 +58,10 @@ void Event::drop()
 	emit dropped();
 }
 
-void Event::check()
+bool Event::check()
 {
 	if (!mIsAlive || !mCondition()) {
-		return;
+		return false;
 	}
 
 	emit fired();
@@ -68,9 +69,43 @@ void Event::check()
 	if (mDropsOnFire) {
 		drop();
 	}
+
+	return true;
 }
 
 void Event::setCondition(const Condition &condition)
 {
 	mCondition = condition;
 }
+
+bool Event::hasVolatileCondition() const
+{
+	return mVolatileCondition;
+}
+
+void Event::setVolatileCondition(bool isVolatile)
+{
+	mVolatileCondition = isVolatile;
+}
+
+void Event::addTimer(const QSharedPointer<qint64> &setUpTimestamp, int timeout)
+{
+	mTimers << qMakePair(setUpTimestamp, timeout);
+}
+
+qint64 Event::nextTimeout(qint64 timestamp) const
+{
+	qint64 result = -1;
+	for (const QPair<QSharedPointer<qint64>, int> &timer : mTimers) {
+		if (*timer.first < 0) {
+			continue;
+		}
+
+		const qint64 timeout = *timer.first + timer.second;
+		if (timeout > timestamp && (result < 0 || timeout < result)) {
+			result = timeout;
+		}
+	}
+
+	return result;
+}
@@ -14,6 +14,8 @@
 
 #pragma once
 
+#include <QtCore/QSharedPointer>
+
 #include "defines.h"
 
 namespace twoDModel {
@@ -61,12 +63,29 @@ public:
 	/// (if dropsOnFire flag in constructor setted with true).
 	/// The event can still be dropped in case when condition is not satisfied. That is made for example
 	/// by "timer" condition with forceDrop flag setted to true.
-	void check();
+	/// Returns true if the event was fired.
+	bool check();
 
 	/// Sets new condition to this event. This may be useful when condition instantiation requires the event instance
 	/// (like in case of "timer" condition).
 	void setCondition(const Condition &condition);
 
+	/// Returns true if the condition has side effects or refers to unknown events. Such condition must be evaluated
+	/// on each check. Other conditions may change their value only when variables, events or objects they read change
+	/// or some timer expires.
+	bool hasVolatileCondition() const;
+
+	/// Marks the condition of this event as volatile, see hasVolatileCondition().
+	void setVolatileCondition(bool isVolatile);
+
+	/// Registers "timer" used in the condition. The timer expires \a timeout ms after \a setUpTimestamp,
+	/// negative \a setUpTimestamp means that the timer is not started.
+	void addTimer(const QSharedPointer<qint64> &setUpTimestamp, int timeout);
+
+	/// Returns the earliest timestamp later than \a timestamp when some started timer of condition expires
+	/// or -1 if there is no such timer.
+	qint64 nextTimeout(qint64 timestamp) const;
+
 signals:
 	/// Emitted when this event was setted up by someone even if event was already alive.
 	void settedUp();
@@ -85,6 +104,8 @@ private:
 	const Trigger mTrigger;
 	bool mDropsOnFire;
 	const bool mIsSettedInitially;
+	bool mVolatileCondition;
+	QList<QPair<QSharedPointer<qint64>, int>> mTimers;
 };
 
 }
@@ -51,7 +51,10 @@ Trigger TriggersFactory::combined(const QList<Trigger> &triggers) const
 
 Trigger TriggersFactory::setVariable(const QString &name, const Value &value) const
 {
-	return [this, name, value]() { mVariables[name] = value(); };
+	return [this, name, value]() {
+		mVariables[name] = value();
+		emit mStatus.stateChanged();
+	};
 }
 
 Trigger TriggersFactory::setObjectState(const Value &object, const QString &property, const Value &value) const
@@ -70,6 +73,7 @@ Trigger TriggersFactory::setObjectState(const Value &object, const QString &prop
 		}
 
 		objectInstance->setProperty(qPrintable(property), value());
+		emit mStatus.stateChanged();
 	};
 }
 
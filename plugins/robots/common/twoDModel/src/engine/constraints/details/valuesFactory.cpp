@@ -24,9 +24,11 @@ using namespace twoDModel::constraints::details;
 
 const QString typeOfNull = "undefined";
 
-ValuesFactory::ValuesFactory(Variables &variables, const Objects &objects, StatusReporter &status)
+ValuesFactory::ValuesFactory(Variables &variables, const Objects &objects, const quint64 &bindingsRevision
+		, StatusReporter &status)
 	: mVariables(variables)
 	, mObjects(objects)
+	, mBindingsRevision(bindingsRevision)
 	, mStatus(status)
 {
 }
@@ -58,8 +60,8 @@ Value ValuesFactory::stringValue(const QString &value) const
 
 Value ValuesFactory::variableValue(const QString &name) const
 {
-	return [this, name]() {
-		const QStringList parts = name.split('.');
+	const QStringList parts = name.split('.');
+	return [this, parts]() {
 		if (parts.isEmpty()) {
 			reportError(QObject::tr("Requesting variable value with empty name"));
 			return QVariant();
@@ -90,26 +92,22 @@ Value ValuesFactory::typeOf(const QString &objectId) const
 
 Value ValuesFactory::objectState(const QString &path) const
 {
-	return [this, path]() {
-		const QStringList parts = path.split('.', QString::SkipEmptyParts);
+	const QStringList parts = path.split('.', QString::SkipEmptyParts);
+	const QSharedPointer<ResolvedPath> resolvedPath(new ResolvedPath);
+	return [this, parts, resolvedPath]() {
 		if (parts.isEmpty()) {
 			reportError(QObject::tr("Object path is empty!"));
 			return QVariant();
 		}
 
-		QString objectId = parts.first();
-		if (!mObjects.contains(objectId)) {
-			reportError(QObject::tr("No such object: %1").arg(objectId));
-			return QVariant();
-		}
-
-		int lastObjectPart = 1;
-		while (lastObjectPart < parts.count() && mObjects.contains(objectId + "." + parts[lastObjectPart])) {
-			objectId += "." + parts[lastObjectPart];
-			++lastObjectPart;
+		// Any binding or unbinding may change the object the path refers to, so it is found again after them.
+		if (!resolvedPath->resolved || resolvedPath->bindingsRevision != mBindingsRevision) {
+			if (!resolve(parts, *resolvedPath)) {
+				return QVariant();
+			}
 		}
 
-		return propertyChain(QVariant::fromValue<QObject *>(mObjects[objectId]), parts.mid(lastObjectPart), objectId);
+		return read(*resolvedPath);
 	};
 }
 
@@ -190,6 +188,76 @@ Value ValuesFactory::boundingRect(const Value &items) const
 	};
 }
 
+bool ValuesFactory::resolve(const QStringList &parts, ResolvedPath &path) const
+{
+	path.resolved = false;
+	QString objectId = parts.first();
+	if (!mObjects.contains(objectId)) {
+		reportError(QObject::tr("No such object: %1").arg(objectId));
+		return false;
+	}
+
+	int lastObjectPart = 1;
+	while (lastObjectPart < parts.count() && mObjects.contains(objectId + "." + parts[lastObjectPart])) {
+		objectId += "." + parts[lastObjectPart];
+		++lastObjectPart;
+	}
+
+	path.resolved = true;
+	path.bindingsRevision = mBindingsRevision;
+	path.objectId = objectId;
+	path.object = mObjects[objectId];
+	path.properties = parts.mid(lastObjectPart);
+	path.metaProperties.fill(QPair<const QMetaObject *, int>(nullptr, -1), path.properties.count());
+	return true;
+}
+
+QVariant ValuesFactory::read(ResolvedPath &path) const
+{
+	// Alias of the object whose property is read on the step with the given index, needed only for error messages.
+	const auto objectAlias = [&path](int step) {
+		QStringList parts = path.properties.mid(0, step);
+		parts.prepend(path.objectId);
+		return parts.join('.');
+	};
+
+	QVariant currentValue = QVariant::fromValue<QObject *>(path.object);
+	for (int i = 0; i < path.properties.count(); ++i) {
+		const QString &property = path.properties[i];
+		if (!currentValue.canConvert<QObject *>()) {
+			// Values of other types have few properties and they are fast to get.
+			currentValue = propertyOf(currentValue, property, objectAlias(i));
+		} else if (QObject * const object = currentValue.value<QObject *>()) {
+			emit mStatus.objectRead(object);
+			QPair<const QMetaObject *, int> &metaProperty = path.metaProperties[i];
+			if (metaProperty.first != object->metaObject()) {
+				const QMetaObject * const metaObject = object->metaObject();
+				metaProperty = qMakePair(metaObject, metaObject->indexOfProperty(qPrintable(property)));
+			}
+
+			if (metaProperty.second < 0) {
+				reportError(QObject::tr("Object \"%1\" has no property \"%2\"").arg(objectAlias(i), property));
+				return QVariant();
+			}
+
+			currentValue = metaProperty.first->property(metaProperty.second).read(object);
+		} else {
+			return QVariant();
+		}
+
+		if (!currentValue.isValid()) {
+			return QVariant();
+		}
+	}
+
+	if (path.properties.isEmpty() && path.object) {
+		// The object itself is the value, for example a collection.
+		emit mStatus.objectRead(path.object);
+	}
+
+	return currentValue;
+}
+
 QVariant ValuesFactory::propertyChain(const QVariant &value
 		, const QStringList &propertyChain, const QString &objectAlias) const
 {
@@ -257,6 +325,7 @@ QVariant ValuesFactory::propertyOf(const QObject *object, const QString &propert
 		return QVariant();
 	}
 
+	emit mStatus.objectRead(const_cast<QObject *>(object));
 	const int index = object->metaObject()->indexOfProperty(qPrintable(property));
 	if (index < 0) {
 		ok && (*ok = false);
@@ -331,7 +400,9 @@ void ValuesFactory::iterate(const QVariant &collection, const std::function<void
 {
 	if (collection.canConvert<utils::ObjectsSetBase *>()) {
 		// A good iteration, without copying. Object sets are good for large collections.
-		collection.value<utils::ObjectsSetBase *>()->iterate(visitor);
+		utils::ObjectsSetBase * const set = collection.value<utils::ObjectsSetBase *>();
+		emit mStatus.objectRead(set);
+		set->iterate(visitor);
 	} else if (collection.canConvert<QVariantList>()) {
 		// Warning: the whole list will be copied here!
 		for (const QVariant &item : collection.value<QVariantList>()) {
@@ -14,6 +14,9 @@
 
 #pragma once
 
+#include <QtCore/QSharedPointer>
+#include <QtCore/QVector>
+
 #include "defines.h"
 
 namespace utils {
@@ -28,7 +31,10 @@ namespace details {
 class ValuesFactory
 {
 public:
-	ValuesFactory(Variables &variables, const Objects &objects, StatusReporter &status);
+	/// @param bindingsRevision - counter that is incremented each time some object is bound or unbound,
+	///        the objects found for objectState() are cached until it changes.
+	ValuesFactory(Variables &variables, const Objects &objects, const quint64 &bindingsRevision
+			, StatusReporter &status);
 
 	/// Produces functor that always returns QVariant().
 	Value invalidValue() const;
@@ -57,6 +63,8 @@ public:
 	/// via Qt reflection.
 	/// If no object found in global map or on some stage object does not contain desired property
 	/// checker error will be emitted.
+	/// The path is splitted only once, the object and indices of Qt properties are resolved on the first call
+	/// and then reused while global objects map and types of objects in the chain stay the same.
 	Value objectState(const QString &path) const;
 
 	/// Produces functor that returns a number of milliseconds passed from some point (no matter what point).
@@ -98,6 +106,22 @@ public:
 	Value boundingRect(const Value &items) const;
 
 private:
+	/// Object and meta-properties found for objectState() path.
+	struct ResolvedPath
+	{
+		/// True if the object was found when bindings had the given revision.
+		bool resolved = false;
+		quint64 bindingsRevision = 0;
+		QString objectId;
+		QObject *object = nullptr;
+		QStringList properties;
+		/// Meta-object and index of property for each of the properties that was read from QObject.
+		QVector<QPair<const QMetaObject *, int>> metaProperties;
+	};
+
+	bool resolve(const QStringList &parts, ResolvedPath &path) const;
+	QVariant read(ResolvedPath &path) const;
+
 	QVariant propertyChain(const QVariant &value, const QStringList &properties, const QString &objectAlias) const;
 	QVariant propertyOf(const QVariant &value, const QString &property, const QString &objectAlias) const;
 	QVariant propertyOf(const QVariant &value, const QString &property
@@ -112,6 +136,7 @@ private:
 
 	Variables &mVariables;
 	const Objects &mObjects;
+	const quint64 &mBindingsRevision;
 	StatusReporter &mStatus;
 };
 
@@ -0,0 +1,43 @@
+/* Copyright 2018 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "sensorSolidItem.h"
+
+using namespace twoDModel::items;
+
+QPolygonF SensorSolidItem::collidingPolygon() const
+{
+	/// @todo: returning different polygons based on sensor type
+	return QPolygonF(QRectF(-7, -7, 15, 15));
+}
+
+qreal SensorSolidItem::mass() const
+{
+	return 0.01; /// @todo
+}
+
+qreal SensorSolidItem::friction() const
+{
+	return 0.0;
+}
+
+bool SensorSolidItem::isCircle() const
+{
+	return true;
+}
+
+SolidItem::BodyType SensorSolidItem::bodyType() const
+{
+	return BodyType::DYNAMIC;
+}
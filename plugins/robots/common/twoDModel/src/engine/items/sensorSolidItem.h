@@ -0,0 +1,35 @@
+/* Copyright 2018 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include "solidItem.h"
+
+namespace twoDModel {
+namespace items {
+
+/// Physical body of a sensor mounted on a robot. Does not depend on the scene, so the same body is used
+/// by sensor items on the scene and by headless models that have no sensor items at all.
+class SensorSolidItem : public SolidItem
+{
+public:
+	QPolygonF collidingPolygon() const override;
+	qreal mass() const override;
+	qreal friction() const override;
+	bool isCircle() const override;
+	BodyType bodyType() const override;
+};
+
+}
+}
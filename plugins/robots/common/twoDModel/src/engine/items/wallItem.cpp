@@ -36,6 +36,14 @@ WallItem::WallItem(const QPointF &begin, const QPointF &end)
 	setFlags(ItemIsSelectable | ItemIsMovable | ItemSendsScenePositionChanges);
 	setPrivateData();
 	setAcceptDrops(true);
+
+	// Keeping colliding path actual without waiting for repaint, world model indexes walls by it.
+	connect(this, &AbstractItem::positionChanged, this, &WallItem::recalculateBorders);
+	connect(this, &AbstractItem::x1Changed, this, &WallItem::recalculateBorders);
+	connect(this, &AbstractItem::y1Changed, this, &WallItem::recalculateBorders);
+	connect(this, &AbstractItem::x2Changed, this, &WallItem::recalculateBorders);
+	connect(this, &AbstractItem::y2Changed, this, &WallItem::recalculateBorders);
+	recalculateBorders();
 }
 
 WallItem *WallItem::clone() const
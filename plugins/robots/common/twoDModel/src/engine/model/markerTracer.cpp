@@ -0,0 +1,64 @@
+/* Copyright 2018 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+
+#include "markerTracer.h"
+
+#include <QtGui/QPen>
+#include <QtGui/QTransform>
+
+#include "twoDModel/engine/model/robotModel.h"
+#include "twoDModel/engine/model/worldModel.h"
+
+using namespace twoDModel::model;
+
+/// The same as the width of the trace drawn by robot item.
+const int defaultTraceWidth = 6;
+
+MarkerTracer::MarkerTracer(RobotModel &robotModel, WorldModel &worldModel)
+	: QObject(&robotModel)
+	, mRobotModel(robotModel)
+	, mWorldModel(worldModel)
+	, mMarkerPoint(0, robotModel.info().size().height() / 2)  // Marker is situated behind the robot
+	, mPosition(robotModel.position())
+	, mRotation(robotModel.rotation())
+{
+	connect(&mRobotModel, &RobotModel::robotRided, this, &MarkerTracer::ride);
+	connect(&mRobotModel, &RobotModel::positionChanged, this, [this](const QPointF &position) {
+		mPosition = position;
+	});
+	connect(&mRobotModel, &RobotModel::rotationChanged, this, [this](qreal rotation) {
+		mRotation = rotation;
+	});
+}
+
+void MarkerTracer::ride(const QPointF &newPosition, qreal rotation)
+{
+	const QPointF oldMarker = markerPosition(mPosition, mRotation);
+	mPosition = newPosition;
+	mRotation = rotation;
+	const QPointF newMarker = markerPosition(mPosition, mRotation);
+	QPen pen;
+	pen.setColor(mRobotModel.markerColor());
+	pen.setWidth(defaultTraceWidth);
+	mWorldModel.appendRobotTrace(pen, oldMarker, newMarker);
+}
+
+QPointF MarkerTracer::markerPosition(const QPointF &position, qreal rotation) const
+{
+	// Robot item is rotated around robot`s rotation center, so is this transform.
+	const QPointF origin = mRobotModel.info().rotationCenter();
+	return QTransform().translate(position.x() + origin.x(), position.y() + origin.y())
+			.rotate(rotation).translate(-origin.x(), -origin.y()).map(mMarkerPoint);
+}
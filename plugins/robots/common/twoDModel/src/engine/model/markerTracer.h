@@ -0,0 +1,51 @@
+/* Copyright 2018 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+
+#pragma once
+
+#include <QtCore/QObject>
+#include <QtCore/QPointF>
+
+namespace twoDModel {
+namespace model {
+
+class RobotModel;
+class WorldModel;
+
+/// Draws the trace of robot`s marker into the world model when there is no robot item on a scene that does it.
+/// Marker position is computed exactly like robot item computes it, so traces are the same with and without GUI.
+/// Becomes a child of the given robot model.
+class MarkerTracer : public QObject
+{
+	Q_OBJECT
+
+public:
+	MarkerTracer(RobotModel &robotModel, WorldModel &worldModel);
+
+private:
+	void ride(const QPointF &newPosition, qreal rotation);
+
+	/// Returns marker position in scene coordinates when robot is at \a position rotated by \a rotation degrees.
+	QPointF markerPosition(const QPointF &position, qreal rotation) const;
+
+	RobotModel &mRobotModel;
+	WorldModel &mWorldModel;
+	QPointF mMarkerPoint;
+	QPointF mPosition;
+	qreal mRotation;
+};
+
+}
+}
@@ -14,6 +14,8 @@
 
 #include "twoDModel/engine/model/model.h"
 
+#include <limits>
+
 #include <qrkernel/settingsManager.h>
 #include <qrgui/plugins/toolPluginInterface/usedInterfaces/errorReporterInterface.h>
 #include <kitBase/interpreterControlInterface.h>
@@ -34,6 +36,7 @@ Model::Model(QObject *parent)
 	, mErrorReporter(nullptr)
 	, mRealisticPhysicsEngine(nullptr)
 	, mSimplePhysicsEngine(nullptr)
+	, mEventSkipping(false)
 {
 	initPhysics();
 	connect(&mSettings, &Settings::physicsChanged, this, &Model::resetPhysics);
@@ -56,15 +59,13 @@ void Model::init(qReal::ErrorReporterInterface &errorReporter
 		errorReporter.addInformation(tr("The task is accomplished!"));
 		// Stopping cannot be performed immediately because we still have constraints to check in event loop
 		// and they need scene to be alive (in checker stopping interpretation means deleting all).
-		QTimer::singleShot(0, &interpreterControl,
-				[&interpreterControl](){ interpreterControl.stopAllInterpretation(); });
+		QMetaObject::invokeMethod(&interpreterControl, "stopAllInterpretation", Qt::QueuedConnection);
 	});
 	connect(mChecker.data(), &constraints::ConstraintsChecker::fail, this, [&](const QString &message) {
 		errorReporter.addError(message);
 		// Stopping cannot be performed immediately because we still have constraints to check in event loop
 		// and they need scene to be alive (in checker stopping interpretation means deleting all).
-		QTimer::singleShot(0, &interpreterControl,
-				[&interpreterControl](){ interpreterControl.stopAllInterpretation(); });
+		QMetaObject::invokeMethod(&interpreterControl, "stopAllInterpretation", Qt::QueuedConnection);
 	});
 	connect(mChecker.data(), &constraints::ConstraintsChecker::checkerError
 			, this, [&errorReporter](const QString &message) {
@@ -213,10 +214,12 @@ void Model::addRobotModel(robotModel::TwoDRobotModel &robotModel, const QPointF
 	connect(&mTimeline, &Timeline::stopped, mRealisticPhysicsEngine, &physics::PhysicsEngineBase::clearForcesAndStop);
 
 	connect(&mTimeline, &Timeline::tick, robot, &RobotModel::recalculateParams);
+	connect(&mTimeline, &Timeline::idleTick, robot, &RobotModel::skipIdleStep);
 	connect(&mTimeline, &Timeline::nextFrame, robot, &RobotModel::nextFragment);
 	connect(&mTimeline, &Timeline::nextFrame, mRealisticPhysicsEngine, &physics::PhysicsEngineBase::nextFrame);
 
 	robot->setPhysicalEngine(mSettings.realisticPhysics() ? *mRealisticPhysicsEngine : *mSimplePhysicsEngine);
+	robot->setIdleStepsSkipping(mEventSkipping);
 
 	mRobotModels.append(robot);
 
@@ -261,6 +264,16 @@ void Model::setConstraintsEnabled(bool enabled)
 	mChecker->setEnabled(enabled);
 }
 
+void Model::setEventSkipping(bool enabled)
+{
+	mEventSkipping = enabled;
+	for (RobotModel * const robot : mRobotModels) {
+		robot->setIdleStepsSkipping(enabled);
+	}
+
+	mTimeline.setIdleTicksSkipping(enabled ? [this]() { return idleUntil(); } : std::function<quint64()>());
+}
+
 void Model::resetPhysics()
 {
 	auto engine = mSettings.realisticPhysics() ? mRealisticPhysicsEngine : mSimplePhysicsEngine;
@@ -295,11 +308,35 @@ void Model::initPhysics()
 	connect(&mTimeline, &Timeline::nextFrame, this, [this](){ mRealisticPhysicsEngine->nextFrame();	});
 }
 
+bool Model::isIdle() const
+{
+	for (const RobotModel * const robot : mRobotModels) {
+		if (!robot->isIdle()) {
+			return false;
+		}
+	}
+
+	return (mSettings.realisticPhysics() ? mRealisticPhysicsEngine : mSimplePhysicsEngine)->isIdle();
+}
+
+quint64 Model::idleUntil() const
+{
+	const quint64 nextTick = mTimeline.timestamp() + Timeline::timeInterval;
+	if (!isIdle()) {
+		return nextTick;
+	}
+
+	const qint64 nextCheck = mChecker ? mChecker->nextCheckTimestamp() : -1;
+	return nextCheck < 0 ? std::numeric_limits<quint64>::max() : qMax(nextTick, static_cast<quint64>(nextCheck));
+}
+
 void Model::recalculatePhysicsParams()
 {
-	if (mSettings.realisticPhysics()) {
-		mRealisticPhysicsEngine->recalculateParameters(Timeline::timeInterval);
-	} else {
-		mSimplePhysicsEngine->recalculateParameters(Timeline::timeInterval);
+	auto engine = mSettings.realisticPhysics() ? mRealisticPhysicsEngine : mSimplePhysicsEngine;
+	if (mEventSkipping && isIdle()) {
+		// Nothing can move in the world, so recalculation would change nothing.
+		return;
 	}
+
+	engine->recalculateParameters(Timeline::timeInterval);
 }
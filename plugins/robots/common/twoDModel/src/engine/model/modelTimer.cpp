@@ -16,19 +16,20 @@
 
 using namespace twoDModel::model;
 
-ModelTimer::ModelTimer(const Timeline *timeline)
+ModelTimer::ModelTimer(Timeline *timeline, quint64 id)
 	: mTimeline(timeline)
-	, mTimeToWait(0)
+	, mId(id)
 	, mListening(false)
-	, mTimePast(0)
 	, mInterval(0)
 	, mRepeatable(false)
 {
-	connect(timeline, SIGNAL(tick()), this, SLOT(onTick()));
 }
 
 ModelTimer::~ModelTimer()
 {
+	if (mTimeline) {
+		mTimeline->unscheduleTimer(this);
+	}
 }
 
 bool ModelTimer::isTicking() const
@@ -41,6 +42,11 @@ int ModelTimer::interval() const
 	return mInterval;
 }
 
+quint64 ModelTimer::id() const
+{
+	return mId;
+}
+
 void ModelTimer::start()
 {
 	start(mInterval);
@@ -49,26 +55,23 @@ void ModelTimer::start()
 void ModelTimer::start(int ms)
 {
 	mInterval = ms;
-	mTimeToWait = ms;
-	mTimePast = 0;
 	mListening = true;
+	if (mTimeline) {
+		mTimeline->scheduleTimer(this, ms);
+	}
 }
 
 void ModelTimer::stop()
 {
-	mTimeToWait = 0;
-	mTimePast = 0;
 	mListening = false;
+	if (mTimeline) {
+		mTimeline->unscheduleTimer(this);
+	}
 }
 
-void ModelTimer::onTick()
+void ModelTimer::fire()
 {
-	if (!mListening) {
-		return;
-	}
-
-	mTimePast += Timeline::timeInterval;
-	if (mTimePast >= mTimeToWait) {
+	if (mListening) {
 		mListening = false;
 		onTimeout();
 	}
@@ -91,4 +94,3 @@ void ModelTimer::onTimeout()
 		start();
 	}
 }
-
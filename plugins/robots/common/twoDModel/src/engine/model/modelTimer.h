@@ -14,6 +14,8 @@
 
 #pragma once
 
+#include <QtCore/QPointer>
+
 #include <utils/abstractTimer.h>
 
 #include "twoDModel/engine/model/timeline.h"
@@ -21,13 +23,15 @@
 namespace twoDModel {
 namespace model {
 
-/// Timer implementation for 2D model. Used in TimerBlock and BeepBlock
+/// Timer implementation for 2D model. Used in TimerBlock and BeepBlock.
+/// Timer does not listen to timeline ticks itself, it is put into the timeline queue and timeline fires it
+/// on the tick when its timeout is reached.
 class ModelTimer : public utils::AbstractTimer
 {
 	Q_OBJECT
 
 public:
-	explicit ModelTimer(const Timeline *timeline /* Doesn`t take ownership */);
+	ModelTimer(Timeline *timeline /* Doesn`t take ownership */, quint64 id);
 	~ModelTimer() override;
 
 	bool isTicking() const override;
@@ -38,15 +42,21 @@ public:
 	void setInterval(int ms) override;
 	void setRepeatable(bool repeatable) override;
 
+	/// Returns the number of the timer in order of creation, timers expiring on the same tick fire in this order.
+	quint64 id() const;
+
 private slots:
 	void onTimeout() override;
-	void onTick();
 
 private:
-	const Timeline *mTimeline;
-	int mTimeToWait;
+	friend class Timeline;
+
+	/// Called by timeline when timer timeout is reached.
+	void fire();
+
+	QPointer<Timeline> mTimeline;
+	const quint64 mId;
 	bool mListening;
-	int mTimePast;
 	int mInterval;
 	bool mRepeatable;
 };
@@ -50,8 +50,6 @@ Box2DPhysicsEngine::Box2DPhysicsEngine (const WorldModel &worldModel
 	: PhysicsEngineBase(worldModel, robots)
 	, mPixelsInCm(worldModel.pixelsInCm() * scaleCoeff)
 	, mWorld(new b2World(b2Vec2(0, 0)))
-	, mPrevPosition(b2Vec2(0, 0))
-	, mPrevAngle(0)
 {
 	connect(&worldModel, &model::WorldModel::wallAdded, this, &Box2DPhysicsEngine::itemAdded);
 	connect(&worldModel, &model::WorldModel::skittleAdded, this, &Box2DPhysicsEngine::itemAdded);
@@ -65,6 +63,8 @@ Box2DPhysicsEngine::~Box2DPhysicsEngine(){
 	}
 
 	mBox2DRobots.clear();
+	mPrevPositions.clear();
+	mPrevAngles.clear();
 	mRightWheels.clear();
 	mLeftWheels.clear();
 	mBox2DResizableItems.clear();
@@ -77,7 +77,7 @@ QVector2D Box2DPhysicsEngine::positionShift(model::RobotModel &robot) const
 		return QVector2D();
 	}
 
-	return QVector2D(positionToScene(mBox2DRobots[&robot]->getBody()->GetPosition() - mPrevPosition));
+	return QVector2D(positionToScene(mBox2DRobots[&robot]->getBody()->GetPosition() - mPrevPositions[&robot]));
 }
 
 qreal Box2DPhysicsEngine::rotation(model::RobotModel &robot) const
@@ -86,7 +86,7 @@ qreal Box2DPhysicsEngine::rotation(model::RobotModel &robot) const
 		return 0;
 	}
 
-	return angleToScene(mBox2DRobots[&robot]->getBody()->GetAngle() - mPrevAngle);
+	return angleToScene(mBox2DRobots[&robot]->getBody()->GetAngle() - mPrevAngles[&robot]);
 }
 
 void Box2DPhysicsEngine::onPressedReleasedSelectedItems(bool active)
@@ -109,8 +109,8 @@ void Box2DPhysicsEngine::addRobot(model::RobotModel * const robot)
 	PhysicsEngineBase::addRobot(robot);
 	addRobot(robot, robot->rotationCenter(), robot->rotation());
 
-	mPrevPosition = mBox2DRobots[robot]->getBody()->GetPosition();
-	mPrevAngle = mBox2DRobots[robot]->getBody()->GetAngle();
+	mPrevPositions[robot] = mBox2DRobots[robot]->getBody()->GetPosition();
+	mPrevAngles[robot] = mBox2DRobots[robot]->getBody()->GetAngle();
 
 	connect(robot, &model::RobotModel::positionChanged, this, [&] (const QPointF &newPos) {
 		onRobotStartPositionChanged(newPos, dynamic_cast<model::RobotModel *>(sender()));
@@ -122,40 +122,66 @@ void Box2DPhysicsEngine::addRobot(model::RobotModel * const robot)
 
 	QTimer::singleShot(10, [=]() {
 		mScene = dynamic_cast<view::TwoDModelScene *>(robot->startPositionMarker()->scene());
+		if (!mScene) {
+			// Headless model, nobody can drag the robot and there are no sensor items on a scene, so sensor bodies
+			// are built right from the sensors configuration.
+			for (const kitBase::robotModel::PortInfo &port : robot->info().availablePorts()) {
+				reinitConfiguredSensor(robot, port);
+			}
+
+			model::SensorsConfiguration &configuration = robot->configuration();
+			connect(&configuration, &model::SensorsConfiguration::deviceAdded, this
+					, [=](const kitBase::robotModel::PortInfo &port) { reinitConfiguredSensor(robot, port); });
+			connect(&configuration, &model::SensorsConfiguration::deviceRemoved, this
+					, [=](const kitBase::robotModel::PortInfo &port) { reinitConfiguredSensor(robot, port); });
+			connect(&configuration, &model::SensorsConfiguration::positionChanged, this
+					, [=](const kitBase::robotModel::PortInfo &port) {
+				if (mBox2DRobots.contains(robot)) {
+					mBox2DRobots[robot]->reinitSensor(port);
+				}
+			});
+
+			connect(robot, &model::RobotModel::deserialized, this, [=](const QPointF &newPos, qreal newAngle) {
+				onMouseReleased(newPos, newAngle, robot);
+			});
+			return;
+		}
 
 		connect(mScene->robot(*robot), &view::RobotItem::mouseInteractionStopped, this, [=]() {
 			view::RobotItem *rItem = mScene->robot(*robot);
 			if (rItem != nullptr) {
-				onMouseReleased(rItem->pos(), rItem->rotation());
+				onMouseReleased(rItem->pos(), rItem->rotation(), robot);
 			}
 		});
 
-		connect(mScene->robot(*robot), &view::RobotItem::mouseInteractionStarted
-				, this, &Box2DPhysicsEngine::onMousePressed);
+		connect(mScene->robot(*robot), &view::RobotItem::mouseInteractionStarted, this, [=]() {
+			onMousePressed(robot);
+		});
 
-		connect(mScene->robot(*robot), &view::RobotItem::recoverRobotPosition
-				, this, &Box2DPhysicsEngine::onRecoverRobotPosition);
+		connect(mScene->robot(*robot), &view::RobotItem::recoverRobotPosition, this, [=](const QPointF &pos) {
+			onRecoverRobotPosition(pos, robot);
+		});
 
 		connect(mScene->robot(*robot), &view::RobotItem::sensorAdded, this, [&](twoDModel::view::SensorItem *sensor) {
 			auto rItem = dynamic_cast<view::RobotItem *>(sender());
 			auto model = &rItem->robotModel();
-			mRobotSensors[model].insert(sensor);
-			mBox2DRobots[model]->addSensor(*sensor);
+			mBox2DRobots[model]->addSensor(sensor->port(), *sensor);
 		});
 		connect(mScene->robot(*robot), &view::RobotItem::sensorRemoved, this, [&](twoDModel::view::SensorItem *sensor) {
 			auto rItem = dynamic_cast<view::RobotItem *>(sender());
 			auto model = &rItem->robotModel();
-			mRobotSensors[model].remove(sensor);
-			mBox2DRobots[model]->removeSensor(*sensor);
+			mBox2DRobots[model]->removeSensor(sensor->port());
 		});
 		connect(mScene->robot(*robot), &view::RobotItem::sensorUpdated
 				, this, [&](twoDModel::view::SensorItem *sensor) {
 			auto rItem = dynamic_cast<view::RobotItem *>(sender());
 			auto model = &rItem->robotModel();
-			mBox2DRobots[model]->reinitSensor(*sensor);
+			mBox2DRobots[model]->reinitSensor(sensor->port());
 		});
 
-		connect(robot, &model::RobotModel::deserialized, this, &Box2DPhysicsEngine::onMouseReleased);
+		connect(robot, &model::RobotModel::deserialized, this, [=](const QPointF &newPos, qreal newAngle) {
+			onMouseReleased(newPos, newAngle, robot);
+		});
 	});
 }
 
@@ -170,6 +196,21 @@ void Box2DPhysicsEngine::addRobot(model::RobotModel * const robot, const QPointF
 	mRightWheels[robot] = mBox2DRobots[robot]->getWheelAt(1);
 }
 
+void Box2DPhysicsEngine::reinitConfiguredSensor(model::RobotModel * const robot
+		, const kitBase::robotModel::PortInfo &port)
+{
+	if (!mBox2DRobots.contains(robot)) {
+		return;
+	}
+
+	const kitBase::robotModel::DeviceInfo device = robot->configuration().type(port);
+	if (device.isNull() || !device.simulated()) {
+		mBox2DRobots[robot]->removeSensor(port);
+	} else {
+		mBox2DRobots[robot]->addSensor(port, mSensorBody);
+	}
+}
+
 void Box2DPhysicsEngine::onRobotStartPositionChanged(const QPointF &newPos, model::RobotModel *robot)
 {
 	if (!mBox2DRobots.contains(robot)) {
@@ -189,28 +230,34 @@ void Box2DPhysicsEngine::onRobotStartAngleChanged(const qreal newAngle, model::R
 	mBox2DRobots[robot]->setRotation(angleToBox2D(newAngle));
 }
 
-void Box2DPhysicsEngine::onMouseReleased(const QPointF &newPos, qreal newAngle)
+void Box2DPhysicsEngine::onMouseReleased(const QPointF &newPos, qreal newAngle, model::RobotModel *robot)
 {
-	Box2DRobot *robot = mBox2DRobots.first();
+	if (!mBox2DRobots.contains(robot)) {
+		return;
+	}
 
-	robot->finishStopping();
-	onRobotStartPositionChanged(newPos, robot->getRobotModel());
-	onRobotStartAngleChanged(newAngle, robot->getRobotModel());
+	mBox2DRobots[robot]->finishStopping();
+	onRobotStartPositionChanged(newPos, robot);
+	onRobotStartAngleChanged(newAngle, robot);
 
 	onPressedReleasedSelectedItems(true);
 }
 
-void Box2DPhysicsEngine::onMousePressed()
+void Box2DPhysicsEngine::onMousePressed(model::RobotModel *robot)
 {
-	for (Box2DRobot *robot: mBox2DRobots){
-		robot->startStopping();
+	if (mBox2DRobots.contains(robot)) {
+		mBox2DRobots[robot]->startStopping();
 	}
 
 	onPressedReleasedSelectedItems(false);
 }
 
-void Box2DPhysicsEngine::onRecoverRobotPosition(const QPointF &pos)
+void Box2DPhysicsEngine::onRecoverRobotPosition(const QPointF &pos, model::RobotModel *robot)
 {
+	if (!mBox2DRobots.contains(robot)) {
+		return;
+	}
+
 	clearForcesAndStop();
 
 	auto stop = [=](b2Body *body){
@@ -218,11 +265,11 @@ void Box2DPhysicsEngine::onRecoverRobotPosition(const QPointF &pos)
 		body->SetLinearVelocity({0, 0});
 	};
 
-	stop(mBox2DRobots.first()->getBody());
-	stop(mBox2DRobots.first()->getWheelAt(0)->getBody());
-	stop(mBox2DRobots.first()->getWheelAt(1)->getBody());
+	stop(mBox2DRobots[robot]->getBody());
+	stop(mBox2DRobots[robot]->getWheelAt(0)->getBody());
+	stop(mBox2DRobots[robot]->getWheelAt(1)->getBody());
 
-	onMouseReleased(pos, mBox2DRobots.keys().first()->startPositionMarker()->rotation());
+	onMouseReleased(pos, robot->startPositionMarker()->rotation(), robot);
 }
 
 void Box2DPhysicsEngine::removeRobot(model::RobotModel * const robot)
@@ -230,6 +277,8 @@ void Box2DPhysicsEngine::removeRobot(model::RobotModel * const robot)
 	PhysicsEngineBase::removeRobot(robot);
 	delete mBox2DRobots[robot];
 	mBox2DRobots.remove(robot);
+	mPrevPositions.remove(robot);
+	mPrevAngles.remove(robot);
 	mLeftWheels.remove(robot);
 	mRightWheels.remove(robot);
 }
@@ -238,14 +287,14 @@ void Box2DPhysicsEngine::recalculateParameters(qreal timeInterval)
 {
 	const int velocityIterations = 10;
 	const int positionIterations = 6;
-
-	model::RobotModel * const robot = mRobots.first();
-	if (mBox2DRobots[robot]) {
-		b2Body *rBody = mBox2DRobots[robot]->getBody();
-		float32 secondsInterval = timeInterval / 1000.0f;
-
-		if (mBox2DRobots[robot]->isStopping()){
-			mBox2DRobots[robot]->stop();
+	const float32 secondsInterval = timeInterval / 1000.0f;
+
+	// All robots live in the same world, so wheels of every robot are driven first and then the world is stepped
+	// once, letting robots push each other.
+	for (Box2DRobot * const box2DRobot : mBox2DRobots) {
+		model::RobotModel * const robot = box2DRobot->getRobotModel();
+		if (box2DRobot->isStopping()) {
+			box2DRobot->stop();
 		} else {
 			// sAdpt is the speed adaptation coefficient for physics engines
 			const int sAdpt = 10;
@@ -256,36 +305,41 @@ void Box2DPhysicsEngine::recalculateParameters(qreal timeInterval)
 			mRightWheels[robot]->keepConstantSpeed(speed2);
 		}
 
-		mPrevPosition = rBody->GetPosition();
-		mPrevAngle = rBody->GetAngle();
+		mPrevPositions[robot] = box2DRobot->getBody()->GetPosition();
+		mPrevAngles[robot] = box2DRobot->getBody()->GetAngle();
+	}
 
-		mWorld->Step(secondsInterval, velocityIterations, positionIterations);
+	const QVector<float32> stateBeforeStep = worldState();
+	mWorld->Step(secondsInterval, velocityIterations, positionIterations);
+	mWorldState = worldState();
+	mLastStepChangedWorld = mWorldState != stateBeforeStep;
 
 #ifdef BOX2D_DEBUG_PATH
-		delete debugPathBox2D;
-		QPainterPath path;
+	delete debugPathBox2D;
+	QPainterPath path;
 
-		for(QGraphicsItem *item : mBox2DDynamicItems.keys()) {
-			if (auto solidItem = dynamic_cast<items::SolidItem *>(item)) {
-				QPolygonF localCollidingPolygon = solidItem->collidingPolygon();
-				qreal lsceneAngle = angleToScene(mBox2DDynamicItems[item]->getRotation());
-				QMatrix m;
-				m.rotate(lsceneAngle);
+	for(QGraphicsItem *item : mBox2DDynamicItems.keys()) {
+		if (auto solidItem = dynamic_cast<items::SolidItem *>(item)) {
+			QPolygonF localCollidingPolygon = solidItem->collidingPolygon();
+			qreal lsceneAngle = angleToScene(mBox2DDynamicItems[item]->getRotation());
+			QMatrix m;
+			m.rotate(lsceneAngle);
 
-				QPointF firstP = localCollidingPolygon.at(0);
-				localCollidingPolygon.translate(-firstP.x(), -firstP.y());
+			QPointF firstP = localCollidingPolygon.at(0);
+			localCollidingPolygon.translate(-firstP.x(), -firstP.y());
 
-				QPainterPath lpath;
-				lpath.addPolygon(localCollidingPolygon);
-				QPainterPath lpathTR = m.map(lpath);
-				lpathTR.translate(firstP.x(), firstP.y());
+			QPainterPath lpath;
+			lpath.addPolygon(localCollidingPolygon);
+			QPainterPath lpathTR = m.map(lpath);
+			lpathTR.translate(firstP.x(), firstP.y());
 
-				path.addPath(lpathTR);
-			}
+			path.addPath(lpathTR);
 		}
+	}
 
-		qreal angleRobot= angleToScene(mBox2DRobots[robot]->getBody()->GetAngle());
-		QPointF posRobot = positionToScene(mBox2DRobots[robot]->getBody()->GetPosition());
+	for (Box2DRobot * const box2DRobot : mBox2DRobots) {
+		qreal angleRobot= angleToScene(box2DRobot->getBody()->GetAngle());
+		QPointF posRobot = positionToScene(box2DRobot->getBody()->GetPosition());
 		QGraphicsRectItem *rect1 = new QGraphicsRectItem(-25, -25, 60, 50);
 		QGraphicsRectItem *rect2 = new QGraphicsRectItem(-10, -6, 20, 10);
 		QGraphicsRectItem *rect3 = new QGraphicsRectItem(-10, -6, 20, 10);
@@ -294,11 +348,11 @@ void Box2DPhysicsEngine::recalculateParameters(qreal timeInterval)
 		rect1->setRotation(angleRobot);
 		rect1->setPos(posRobot);
 		rect2->setTransformOriginPoint(0, 0);
-		rect2->setRotation(angleToScene(mBox2DRobots[robot]->getWheelAt(0)->getBody()->GetAngle()));
-		rect2->setPos(positionToScene(mBox2DRobots[robot]->getWheelAt(0)->getBody()->GetPosition()));
+		rect2->setRotation(angleToScene(box2DRobot->getWheelAt(0)->getBody()->GetAngle()));
+		rect2->setPos(positionToScene(box2DRobot->getWheelAt(0)->getBody()->GetPosition()));
 		rect3->setTransformOriginPoint(0, 0);
-		rect3->setRotation(angleToScene(mBox2DRobots[robot]->getWheelAt(1)->getBody()->GetAngle()));
-		rect3->setPos(positionToScene(mBox2DRobots[robot]->getWheelAt(1)->getBody()->GetPosition()));
+		rect3->setRotation(angleToScene(box2DRobot->getWheelAt(1)->getBody()->GetAngle()));
+		rect3->setPos(positionToScene(box2DRobot->getWheelAt(1)->getBody()->GetPosition()));
 		mScene->addItem(rect1);
 		mScene->addItem(rect2);
 		mScene->addItem(rect3);
@@ -310,26 +364,26 @@ void Box2DPhysicsEngine::recalculateParameters(qreal timeInterval)
 
 
 //		 uncomment it for watching mutual position of robot and wheels (polygon form)
-//		path.addPolygon(mBox2DRobots[robot]->getDebuggingPolygon());
-//		path.addPolygon(mBox2DRobots[robot]->getWheelAt(0)->mDebuggingDrawPolygon);
-//		path.addPolygon(mBox2DRobots[robot]->getWheelAt(1)->mDebuggingDrawPolygon);
+//		path.addPolygon(box2DRobot->getDebuggingPolygon());
+//		path.addPolygon(box2DRobot->getWheelAt(0)->mDebuggingDrawPolygon);
+//		path.addPolygon(box2DRobot->getWheelAt(1)->mDebuggingDrawPolygon);
 
-		const QMap<const view::SensorItem *, Box2DItem *> sensors = mBox2DRobots[robot]->getSensors();
+		const QMap<kitBase::robotModel::PortInfo, Box2DItem *> sensors = box2DRobot->getSensors();
 		for (Box2DItem * sensor : sensors.values()) {
 			const b2Vec2 position = sensor->getBody()->GetPosition();
 			QPointF scenePos = positionToScene(position);
 			path.addEllipse(scenePos, 10, 10);
 		}
+	}
 
-		debugPathBox2D = new QGraphicsPathItem(path);
-		debugPathBox2D->setBrush(Qt::blue);
-		debugPathBox2D->setPen(QPen(QColor(Qt::red)));
-		debugPathBox2D->setZValue(101);
-		mScene->addItem(debugPathBox2D);
-		mScene->update();
+	debugPathBox2D = new QGraphicsPathItem(path);
+	debugPathBox2D->setBrush(Qt::blue);
+	debugPathBox2D->setPen(QPen(QColor(Qt::red)));
+	debugPathBox2D->setZValue(101);
+	mScene->addItem(debugPathBox2D);
+	mScene->update();
 
 #endif
-	}
 }
 
 void Box2DPhysicsEngine::wakeUp()
@@ -366,6 +420,28 @@ bool Box2DPhysicsEngine::isRobotStuck() const
 	return false;
 }
 
+bool Box2DPhysicsEngine::isIdle() const
+{
+	// Wheels of robots are driven each step even with stopped motors and that wakes bodies up, so sleeping of bodies
+	// tells nothing. But a step is a function of the world state and motor speeds, so if the last step did not
+	// change the world and nobody did it after, the next step with stopped motors will not change it either.
+	return !mLastStepChangedWorld && worldState() == mWorldState;
+}
+
+QVector<float32> Box2DPhysicsEngine::worldState() const
+{
+	QVector<float32> result;
+	result.reserve(mWorld->GetBodyCount() * 6);
+	for (const b2Body *body = mWorld->GetBodyList(); body; body = body->GetNext()) {
+		if (body->GetType() != b2_staticBody) {
+			result << body->GetPosition().x << body->GetPosition().y << body->GetAngle()
+					<< body->GetLinearVelocity().x << body->GetLinearVelocity().y << body->GetAngularVelocity();
+		}
+	}
+
+	return result;
+}
+
 void Box2DPhysicsEngine::onPixelsInCmChanged(qreal value)
 {
 	mPixelsInCm = value * scaleCoeff;
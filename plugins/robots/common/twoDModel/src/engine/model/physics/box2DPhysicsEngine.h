@@ -15,10 +15,13 @@
 
 #include "physicsEngineBase.h"
 
+#include <QtCore/QVector>
+
 #include <Box2D/Common/b2Math.h>
 #include <qrutils/mathUtils/geometry.h>
 
 #include "twoDModel/engine/model/worldModel.h"
+#include "src/engine/items/sensorSolidItem.h"
 
 class b2World;
 class b2Body;
@@ -57,6 +60,7 @@ public:
 	void nextFrame() override;
 	void clearForcesAndStop() override;
 	bool isRobotStuck() const override;
+	bool isIdle() const override;
 
 	float pxToCm(qreal px) const;
 	b2Vec2 pxToCm(const QPointF &posInPx) const;
@@ -80,9 +84,9 @@ public slots:
 	void onItemDragged(graphicsUtils::AbstractItem *item);
 	void onRobotStartPositionChanged(const QPointF &newPos, twoDModel::model::RobotModel *robot);
 	void onRobotStartAngleChanged(const qreal newAngle, twoDModel::model::RobotModel *robot);
-	void onMouseReleased(const QPointF &newPos, qreal newAngle);
-	void onMousePressed();
-	void onRecoverRobotPosition(const QPointF &pos);
+	void onMouseReleased(const QPointF &newPos, qreal newAngle, twoDModel::model::RobotModel *robot);
+	void onMousePressed(twoDModel::model::RobotModel *robot);
+	void onRecoverRobotPosition(const QPointF &pos, twoDModel::model::RobotModel *robot);
 
 protected:
 	void onPixelsInCmChanged(qreal value) override;
@@ -94,6 +98,13 @@ private:
 
 	bool itemTracked(QGraphicsItem * const item);
 
+	/// Adds, replaces or removes the body of the sensor on \a port according to the sensors configuration of \a robot.
+	/// Used by headless models which have no sensor items to take bodies from.
+	void reinitConfiguredSensor(RobotModel * const robot, const kitBase::robotModel::PortInfo &port);
+
+	/// Returns positions, angles and velocities of all non-static bodies of the world in order of the body list.
+	QVector<float32> worldState() const;
+
 	twoDModel::view::TwoDModelScene *mScene; // Doesn't take ownership
 	qreal mPixelsInCm;
 	QScopedPointer<b2World> mWorld;
@@ -103,10 +114,13 @@ private:
 	QMap<RobotModel *, parts::Box2DWheel *> mRightWheels;  // Takes ownership on b2WheelJoint instances
 	QMap<QGraphicsItem *, parts::Box2DItem *> mBox2DResizableItems;  // Takes ownership on b2Body instances
 	QMap<QGraphicsItem *, parts::Box2DItem *> mBox2DDynamicItems;  // Takes ownership on b2Body instances
-	QMap<RobotModel *, QSet<twoDModel::view::SensorItem *>> mRobotSensors; // Doesn't take ownership
+	const items::SensorSolidItem mSensorBody;  // Form of sensor bodies of headless models.
+
+	QMap<RobotModel *, b2Vec2> mPrevPositions;  // Robot body positions before the last world step.
+	QMap<RobotModel *, float32> mPrevAngles;  // Robot body angles before the last world step.
 
-	b2Vec2 mPrevPosition;
-	float32 mPrevAngle;
+	QVector<float32> mWorldState;  // State of the world after the last step.
+	bool mLastStepChangedWorld = true;
 };
 
 }
@@ -13,10 +13,12 @@
  * limitations under the License. */
 #include "box2DRobot.h"
 
+#include <QtGui/QTransform>
+
 #include <Box2D/Box2D.h>
 
 #include "src/engine/model/physics/box2DPhysicsEngine.h"
-#include "src/engine/view/scene/rangeSensorItem.h"
+#include "src/engine/items/solidItem.h"
 #include "twoDModel/engine/model/robotModel.h"
 #include "twoDModel/engine/model/constants.h"
 #include "box2DWheel.h"
@@ -107,18 +109,30 @@ bool Box2DRobot::isStopping()
 	return mIsStopping;
 }
 
-void Box2DRobot::addSensor(const twoDModel::view::SensorItem &sensor)
+void Box2DRobot::addSensor(const kitBase::robotModel::PortInfo &port, const twoDModel::items::SolidItem &body)
 {
+	removeSensor(port);
+
 	// orientation and direction will be set by reinitSensor() method
-	mSensors[&sensor] = new Box2DItem(mEngine, sensor, {0, 0}, 0);
-	reinitSensor(sensor);
+	mSensors[port] = new Box2DItem(mEngine, body, {0, 0}, 0);
+	mSensorCenters[port] = body.collidingPolygon().boundingRect().center();
+	reinitSensor(port);
 }
 
-void Box2DRobot::removeSensor(const twoDModel::view::SensorItem &sensor)
+void Box2DRobot::removeSensor(const kitBase::robotModel::PortInfo &port)
 {
-	mWorld.DestroyJoint(mSensors[&sensor]->getBody()->GetJointList()->joint);
-	delete mSensors[&sensor];
-	mSensors.remove(&sensor);
+	Box2DItem * const sensor = mSensors.take(port);
+	mSensorCenters.remove(port);
+	if (!sensor) {
+		return;
+	}
+
+	if (const b2JointEdge *jointList = sensor->getBody()->GetJointList()) {
+		mJoints.removeAll(jointList->joint);
+		mWorld.DestroyJoint(jointList->joint);
+	}
+
+	delete sensor;
 }
 
 void Box2DRobot::moveToPoint(const b2Vec2 &destination)
@@ -155,14 +169,18 @@ void Box2DRobot::setRotation(float angle)
 	reinitSensors();
 }
 
-void Box2DRobot::reinitSensor(const twoDModel::view::SensorItem &sensor)
+void Box2DRobot::reinitSensor(const kitBase::robotModel::PortInfo &port)
 {
 	// box2d doesn't rotate or shift elements, which are connected to main robot body via joints in case
 	// when we manually use method SetTransform.
 	// So we need to handle elements such as sensors by hand.
 	// We use this method in case when user shifts or rotates sensor(s).
 
-	auto box2dSensor = mSensors[&sensor];
+	auto box2dSensor = mSensors.value(port);
+	if (!box2dSensor) {
+		return;
+	}
+
 	box2dSensor->getBody()->SetLinearVelocity({0, 0});
 	box2dSensor->getBody()->SetAngularVelocity(0);
 	if (const b2JointEdge *jointList = box2dSensor->getBody()->GetJointList()) {
@@ -171,11 +189,10 @@ void Box2DRobot::reinitSensor(const twoDModel::view::SensorItem &sensor)
 		mWorld.DestroyJoint(joint);
 	}
 
-	QPolygonF collidingPolygon = sensor.collidingPolygon();
-	QPointF localCenter = collidingPolygon.boundingRect().center();
+	const QPointF localCenter = mSensorCenters[port];
 
 	QPointF deltaToCenter = mModel->rotationCenter() - mModel->position();
-	QPointF localPos = sensor.pos() - deltaToCenter;
+	QPointF localPos = mModel->configuration().position(port) - deltaToCenter;
 	QTransform transform;
 	QPointF dif = mModel->rotationCenter();
 	transform.translate(-dif.x(), -dif.y());
@@ -189,14 +206,14 @@ void Box2DRobot::reinitSensor(const twoDModel::view::SensorItem &sensor)
 	// IMPORTANT: we connect every sensor with box2d circle item.
 	// So rotation of sensor doesn't matter, we set rotation corresponding to robot.
 	// if in future it will be changed, you'll see some strange behavior, because of joints. See connectSensor method.
-	mSensors[&sensor]->getBody()->SetTransform(pos, mBody->GetAngle());
-	connectSensor(*mSensors[&sensor]);
+	box2dSensor->getBody()->SetTransform(pos, mBody->GetAngle());
+	connectSensor(*box2dSensor);
 }
 
 void Box2DRobot::reinitSensors()
 {
-	for (const twoDModel::view::SensorItem *sensor : mSensors.keys()) {
-		reinitSensor(*sensor);
+	for (const kitBase::robotModel::PortInfo &port : mSensors.keys()) {
+		reinitSensor(port);
 	}
 }
 
@@ -225,7 +242,7 @@ const QPolygonF &Box2DRobot::getDebuggingPolygon() const
 	return mDebuggingDrawPolygon;
 }
 
-const QMap<const twoDModel::view::SensorItem *, Box2DItem *> &Box2DRobot::getSensors() const
+const QMap<kitBase::robotModel::PortInfo, Box2DItem *> &Box2DRobot::getSensors() const
 {
 	return mSensors;
 }
@@ -14,6 +14,8 @@
 
 #pragma once
 
+#include <kitBase/robotModel/portInfo.h>
+
 #include "src/engine/model/physics/box2DPhysicsEngine.h"
 
 class b2World;
@@ -21,8 +23,8 @@ class b2Joint;
 class b2Body;
 
 namespace twoDModel {
-namespace view {
-	class SensorItem;
+namespace items {
+	class SolidItem;
 }
 
 namespace model {
@@ -48,13 +50,15 @@ public:
 	void finishStopping();
 	bool isStopping();
 
-	void addSensor(const view::SensorItem &sensor);
-	void removeSensor(const view::SensorItem &sensor);
+	/// Attaches a body of the given form to the robot at the position of the sensor on \a port
+	/// taken from the sensors configuration of the robot model.
+	void addSensor(const kitBase::robotModel::PortInfo &port, const items::SolidItem &body);
+	void removeSensor(const kitBase::robotModel::PortInfo &port);
 
 	void moveToPoint(const b2Vec2 &destination);
 	void setRotation(float angle);
 
-	void reinitSensor(const view::SensorItem &sensor);
+	void reinitSensor(const kitBase::robotModel::PortInfo &port);
 	void reinitSensors();
 
 	void applyForceToCenter(const b2Vec2 &force, bool wake);
@@ -65,7 +69,7 @@ public:
 
 	// For debugging purpose
 	const QPolygonF & getDebuggingPolygon() const;
-	const QMap<const view::SensorItem *, Box2DItem *> &getSensors() const;
+	const QMap<kitBase::robotModel::PortInfo, Box2DItem *> &getSensors() const;
 
 private:
 	void connectWheels();
@@ -75,7 +79,8 @@ private:
 	b2Body *mBody; // Takes ownership
 	QList<Box2DWheel *> mWheels; // Takes ownership
 	QList<b2Joint *> mJoints; // Takes ownership
-	QMap<const twoDModel::view::SensorItem *, parts::Box2DItem *> mSensors;  // Takes ownership on b2Sensor instances
+	QMap<kitBase::robotModel::PortInfo, parts::Box2DItem *> mSensors;  // Takes ownership on b2Sensor instances
+	QMap<kitBase::robotModel::PortInfo, QPointF> mSensorCenters;  // Centers of sensor bodies in their local coordinates
 	twoDModel::model::RobotModel * const mModel; // Doesn't take ownership
 	twoDModel::model::physics::Box2DPhysicsEngine *mEngine; // Doesn't take ownership
 	b2World &mWorld; // Doesn't take ownership
@@ -44,6 +44,11 @@ void PhysicsEngineBase::removeRobot(twoDModel::model::RobotModel * const robot)
 	mRobots.removeAll(robot);
 }
 
+bool PhysicsEngineBase::isIdle() const
+{
+	return false;
+}
+
 void PhysicsEngineBase::wakeUp()
 {
 }
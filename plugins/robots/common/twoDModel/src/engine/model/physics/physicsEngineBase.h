@@ -55,6 +55,10 @@ public:
 	/// A hacky method to understand when robot in simple physics mode got stuck in the wall.
 	virtual bool isRobotStuck() const = 0;
 
+	/// Returns true if nothing moves in the world, so recalculateParameters() will change nothing while motors
+	/// of all robots are stopped and may be skipped. Returns false by default.
+	virtual bool isIdle() const;
+
 	/// Reinitialize physics engine, e.g. changing of engines requires some update.
 	virtual void wakeUp();
 
@@ -54,6 +54,24 @@ bool SimplePhysicsEngine::isRobotStuck() const
 	return mStuck;
 }
 
+bool SimplePhysicsEngine::isIdle() const
+{
+	// With stopped motors shifts are recalculated to zero (or negated if robot is stuck), so zero stays zero.
+	for (const QVector2D &shift : mPositionShift) {
+		if (!shift.isNull()) {
+			return false;
+		}
+	}
+
+	for (const qreal rotation : mRotation) {
+		if (!qIsNull(rotation)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
 void SimplePhysicsEngine::recalculateParameters(qreal timeInterval, RobotModel &robot)
 {
 	if (mWorldModel.checkCollision(robot.robotBoundingPath())) {
@@ -30,6 +30,7 @@ public:
 	qreal rotation(RobotModel &robot) const override;
 	void recalculateParameters(qreal timeInterval) override;
 	bool isRobotStuck() const override;
+	bool isIdle() const override;
 
 private:
 	void recalculateParameters(qreal timeInterval, RobotModel &robot);
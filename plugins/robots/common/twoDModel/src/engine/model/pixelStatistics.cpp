@@ -0,0 +1,232 @@
+/* Copyright 2018 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "twoDModel/engine/model/pixelStatistics.h"
+
+#include "twoDModel/engine/model/constants.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+using namespace twoDModel::model;
+
+const int PixelStatistics::paletteSize;
+
+/// Vector lanes accumulate 32-bit sums, so buffers are processed in blocks small enough not to overflow them.
+static const int blockSize = 1 << 14;
+
+static const uint paletteColors[PixelStatistics::paletteSize] = {
+	twoDModel::black
+	, twoDModel::blue
+	, twoDModel::green
+	, twoDModel::yellow
+	, twoDModel::red
+	, twoDModel::white
+	, twoDModel::cyan
+	, twoDModel::magenta
+};
+
+static uint brightness(QRgb color)
+{
+	const uint b = (color >> 0) & 0xFF;
+	const uint g = (color >> 8) & 0xFF;
+	const uint r = (color >> 16) & 0xFF;
+	return static_cast<uint>(0.2126 * r + 0.7152 * g + 0.0722 * b);
+}
+
+static bool closeEnough(QRgb color, QRgb sample, int tolerance)
+{
+	return qAlpha(color) > 0 && qMax(qAbs(qRed(color) - qRed(sample))
+			, qMax(qAbs(qGreen(color) - qGreen(sample))
+			, qAbs(qBlue(color) - qBlue(sample)))) < tolerance;
+}
+
+#ifdef __SSE2__
+static qint64 horizontalSum(__m128i vector)
+{
+	qint32 lanes[4];
+	_mm_storeu_si128(reinterpret_cast<__m128i *>(lanes), vector);
+	return static_cast<qint64>(lanes[0]) + lanes[1] + lanes[2] + lanes[3];
+}
+
+/// Computes brightness of two pixels in the lower lanes of \a r, \a g and \a b exactly as brightness() does.
+static __m128i brightness2(__m128i r, __m128i g, __m128i b)
+{
+	const __m128d value = _mm_add_pd(
+			_mm_add_pd(_mm_mul_pd(_mm_set1_pd(0.2126), _mm_cvtepi32_pd(r))
+					, _mm_mul_pd(_mm_set1_pd(0.7152), _mm_cvtepi32_pd(g)))
+			, _mm_mul_pd(_mm_set1_pd(0.0722), _mm_cvtepi32_pd(b)));
+	return _mm_cvttpd_epi32(value);
+}
+#endif
+
+const uint *PixelStatistics::palette()
+{
+	return paletteColors;
+}
+
+quint64 PixelStatistics::brightnessSum(const QRgb *pixels, int count)
+{
+	quint64 result = 0;
+	int i = 0;
+
+#ifdef __SSE2__
+	const __m128i byteMask = _mm_set1_epi32(0xFF);
+	while (i + 4 <= count) {
+		const int blockEnd = qMin(count, i + blockSize);
+		__m128i sum = _mm_setzero_si128();
+		for (; i + 4 <= blockEnd; i += 4) {
+			const __m128i pixel = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pixels + i));
+			const __m128i r = _mm_and_si128(_mm_srli_epi32(pixel, 16), byteMask);
+			const __m128i g = _mm_and_si128(_mm_srli_epi32(pixel, 8), byteMask);
+			const __m128i b = _mm_and_si128(pixel, byteMask);
+			const __m128i low = brightness2(r, g, b);
+			const __m128i high = brightness2(_mm_srli_si128(r, 8), _mm_srli_si128(g, 8), _mm_srli_si128(b, 8));
+			sum = _mm_add_epi32(sum, _mm_unpacklo_epi64(low, high));
+		}
+
+		result += horizontalSum(sum);
+	}
+#endif
+
+	for (; i < count; ++i) {
+		result += brightness(pixels[i]);
+	}
+
+	return result;
+}
+
+QVector<int> PixelStatistics::paletteHistogram(const QRgb *pixels, int count)
+{
+	QVector<int> result(paletteSize + 1, 0);
+	int i = 0;
+
+#ifdef __SSE2__
+	__m128i colors[paletteSize];
+	for (int color = 0; color < paletteSize; ++color) {
+		colors[color] = _mm_set1_epi32(static_cast<int>(paletteColors[color]));
+	}
+
+	while (i + 4 <= count) {
+		const int blockEnd = qMin(count, i + blockSize);
+		__m128i counters[paletteSize];
+		for (int color = 0; color < paletteSize; ++color) {
+			counters[color] = _mm_setzero_si128();
+		}
+
+		for (; i + 4 <= blockEnd; i += 4) {
+			const __m128i pixel = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pixels + i));
+			for (int color = 0; color < paletteSize; ++color) {
+				// Equal lanes are -1, so subtraction increments counters.
+				counters[color] = _mm_sub_epi32(counters[color], _mm_cmpeq_epi32(pixel, colors[color]));
+			}
+		}
+
+		for (int color = 0; color < paletteSize; ++color) {
+			result[color] += static_cast<int>(horizontalSum(counters[color]));
+		}
+	}
+#endif
+
+	for (; i < count; ++i) {
+		int color = 0;
+		while (color < paletteSize && paletteColors[color] != pixels[i]) {
+			++color;
+		}
+
+		++result[color];
+	}
+
+	int matched = 0;
+	for (int color = 0; color < paletteSize; ++color) {
+		matched += result[color];
+	}
+
+	result[paletteSize] = count - matched;
+	return result;
+}
+
+int PixelStatistics::closeColorsCount(const QRgb *pixels, int count, QRgb color, int tolerance, qint64 &indicesSum)
+{
+	indicesSum = 0;
+	if (tolerance <= 0) {
+		return 0;
+	}
+
+	int result = 0;
+	int i = 0;
+
+#ifdef __SSE2__
+	// Per-byte absolute differences must not exceed tolerance - 1, alpha byte is checked separately.
+	const int channelThreshold = qMin(tolerance - 1, 255);
+	const __m128i thresholds = _mm_set1_epi32(static_cast<int>(0xFF000000u
+			| (channelThreshold << 16) | (channelThreshold << 8) | channelThreshold));
+	const __m128i sample = _mm_set1_epi32(static_cast<int>(color));
+	const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+	const __m128i allOnes = _mm_set1_epi32(-1);
+	const __m128i zero = _mm_setzero_si128();
+	while (i + 4 <= count) {
+		const int blockStart = i;
+		const int blockEnd = qMin(count, i + blockSize);
+		__m128i counter = _mm_setzero_si128();
+		__m128i indices = _mm_setr_epi32(0, 1, 2, 3);
+		__m128i indicesCounter = _mm_setzero_si128();
+		for (; i + 4 <= blockEnd; i += 4) {
+			const __m128i pixel = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pixels + i));
+			const __m128i difference = _mm_or_si128(_mm_subs_epu8(pixel, sample), _mm_subs_epu8(sample, pixel));
+			const __m128i bytesClose = _mm_cmpeq_epi8(_mm_subs_epu8(difference, thresholds), zero);
+			const __m128i close = _mm_cmpeq_epi32(bytesClose, allOnes);
+			const __m128i transparent = _mm_cmpeq_epi32(_mm_and_si128(pixel, alphaMask), zero);
+			const __m128i matched = _mm_andnot_si128(transparent, close);
+			counter = _mm_sub_epi32(counter, matched);
+			indicesCounter = _mm_add_epi32(indicesCounter, _mm_and_si128(matched, indices));
+			indices = _mm_add_epi32(indices, _mm_set1_epi32(4));
+		}
+
+		const qint64 blockCount = horizontalSum(counter);
+		result += static_cast<int>(blockCount);
+		indicesSum += horizontalSum(indicesCounter) + blockCount * blockStart;
+	}
+#endif
+
+	for (; i < count; ++i) {
+		if (closeEnough(pixels[i], color, tolerance)) {
+			++result;
+			indicesSum += i;
+		}
+	}
+
+	return result;
+}
+
+QRgb PixelStatistics::averageColor(const QRgb *pixels, int count)
+{
+	qint64 size = 0;
+	qint64 red = 0;
+	qint64 green = 0;
+	qint64 blue = 0;
+	for (int i = 0; i < count; ++i) {
+		if (qAlpha(pixels[i]) > 0) {
+			++size;
+			red += qRed(pixels[i]);
+			green += qGreen(pixels[i]);
+			blue += qBlue(pixels[i]);
+		}
+	}
+
+	return size == 0
+			? qRgb(255, 255, 255)
+			: qRgb(static_cast<int>(red / size), static_cast<int>(green / size), static_cast<int>(blue / size));
+}
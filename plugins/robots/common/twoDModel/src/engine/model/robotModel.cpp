@@ -57,6 +57,7 @@ RobotModel::RobotModel(robotModel::TwoDRobotModel &robotModel
 	, mAngleStampPrevious(0)
 	, mPhysicsEngine(nullptr)
 	, mStartPositionMarker(new items::StartPosition(info().size()))
+	, mIdleStepsSkipping(false)
 {
 	reinit();
 }
@@ -276,6 +277,41 @@ void RobotModel::setPhysicalEngine(physics::PhysicsEngineBase &engine)
 	mPhysicsEngine = &engine;
 }
 
+bool RobotModel::isIdle() const
+{
+	// Noisy motors consume random numbers each step even when stopped.
+	if (mSettings.realisticMotors() || mBeepTime > 0) {
+		return false;
+	}
+
+	for (const Wheel * const motor : mMotors) {
+		if (motor->speed != 0 || motor->spoiledSpeed != 0 || (motor->isUsed && motor->activeTimeType == DoByLimit)) {
+			return false;
+		}
+	}
+
+	if (mIsFirstAngleStamp || !qIsNull(mDeltaRadiansOfAngle) || mAngleStampPrevious != mAngle
+			|| mPosStamps.size() < positionStampsCount) {
+		return false;
+	}
+
+	// Accelerometer readings stay the same only when all remembered positions are exactly the current one
+	// (comparison of QPointF is fuzzy, so coordinates are compared).
+	for (int i = 0; i < mPosStamps.size(); ++i) {
+		const QPointF &stamp = mPosStamps.nthFromHead(i);
+		if (stamp.x() != mPos.x() || stamp.y() != mPos.y()) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void RobotModel::setIdleStepsSkipping(bool skip)
+{
+	mIdleStepsSkipping = skip;
+}
+
 QRectF RobotModel::sensorRect(const PortInfo &port, const QPointF sensorPos) const
 {
 	if (!mSensorsConfiguration.type(port).isNull()) {
@@ -335,6 +371,13 @@ void RobotModel::recalculateParams()
 		return;
 	}
 
+	if (mIdleStepsSkipping && mPhysicsEngine->isIdle() && isIdle()) {
+		// Recalculation would give the same position, speed, acceleration and encoders.
+		emit positionRecalculated(mPos, mAngle);
+		countBeep();
+		return;
+	}
+
 	auto calculateMotorOutput = [&](WheelEnum wheel) {
 		const PortInfo &port = mWheelsToMotorPortsMap.value(wheel, PortInfo());
 		if (!port.isValid() || port.name() == "None") {
@@ -358,6 +401,16 @@ void RobotModel::recalculateParams()
 	countBeep();
 }
 
+void RobotModel::skipIdleStep()
+{
+	if (!mIsOnTheGround || !mPhysicsEngine) {
+		return;
+	}
+
+	emit positionRecalculated(mPos, mAngle);
+	countBeep();
+}
+
 void RobotModel::nextFragment()
 {
 	if (!mIsOnTheGround) {
@@ -0,0 +1,150 @@
+/* Copyright 2018 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "robotTrace.h"
+
+using namespace twoDModel::model;
+
+const int RobotTrace::chunkSize;
+const int RobotTrace::maxOpenPolylines;
+
+RobotTrace::RobotTrace()
+	: mSegmentsCount(0)
+{
+}
+
+QRectF RobotTrace::append(const QPen &pen, const QPointF &begin, const QPointF &end)
+{
+	Polyline *polyline = continuedPolyline(pen, begin);
+	if (!polyline) {
+		mPolylines.append(Polyline());
+		polyline = &mPolylines.last();
+		polyline->pen = pen;
+		addPoint(*polyline, begin);
+
+		mOpenPolylines << mPolylines.size() - 1;
+		if (mOpenPolylines.size() > maxOpenPolylines) {
+			mOpenPolylines.removeFirst();
+		}
+	}
+
+	addPoint(*polyline, end);
+	++mSegmentsCount;
+	mLastSegment = QLineF(begin, end);
+
+	const QRectF result = paintedRect(pen, QRectF(begin, end).normalized());
+	mBoundingRect = mBoundingRect.isEmpty() ? result : mBoundingRect.united(result);
+	return result;
+}
+
+void RobotTrace::clear()
+{
+	mPolylines.clear();
+	mOpenPolylines.clear();
+	mBoundingRect = QRectF();
+	mLastSegment = QLineF();
+	mSegmentsCount = 0;
+}
+
+const QVector<RobotTrace::Polyline> &RobotTrace::polylines() const
+{
+	return mPolylines;
+}
+
+QRectF RobotTrace::boundingRect() const
+{
+	return mBoundingRect;
+}
+
+QRectF RobotTrace::paintedRect(const QPen &pen, const QRectF &bounds)
+{
+	// Square caps of a diagonal segment stick out for more than a half of pen width, so the whole width is taken.
+	const qreal margin = qMax<qreal>(pen.widthF(), 1);
+	return bounds.adjusted(-margin, -margin, margin, margin);
+}
+
+QVariant RobotTrace::first() const
+{
+	if (mPolylines.isEmpty()) {
+		return QVariant();
+	}
+
+	const QVector<QPointF> &points = mPolylines.first().chunks.first().points;
+	return QVariant::fromValue(QLineF(points[0], points[1]));
+}
+
+QVariant RobotTrace::last() const
+{
+	return mPolylines.isEmpty() ? QVariant() : QVariant::fromValue(mLastSegment);
+}
+
+bool RobotTrace::isEmpty() const
+{
+	return mSegmentsCount == 0;
+}
+
+int RobotTrace::size() const
+{
+	return mSegmentsCount;
+}
+
+void RobotTrace::iterate(const Visitor &visitor) const
+{
+	for (const Polyline &polyline : mPolylines) {
+		for (const Chunk &chunk : polyline.chunks) {
+			for (int i = 1; i < chunk.points.size(); ++i) {
+				visitor(QVariant::fromValue(QLineF(chunk.points[i - 1], chunk.points[i])));
+			}
+		}
+	}
+}
+
+RobotTrace::Polyline *RobotTrace::continuedPolyline(const QPen &pen, const QPointF &begin)
+{
+	for (int i = mOpenPolylines.size() - 1; i >= 0; --i) {
+		Polyline &polyline = mPolylines[mOpenPolylines[i]];
+		const QPointF &end = polyline.chunks.last().points.last();
+		// Exact comparison, fuzzy one would shift the trace.
+		if (end.x() == begin.x() && end.y() == begin.y() && polyline.pen == pen) {
+			return &polyline;
+		}
+	}
+
+	return nullptr;
+}
+
+void RobotTrace::addPoint(Polyline &polyline, const QPointF &point)
+{
+	if (polyline.chunks.isEmpty() || polyline.chunks.last().points.size() >= chunkSize) {
+		Chunk chunk;
+		chunk.points.reserve(chunkSize);
+		if (!polyline.chunks.isEmpty()) {
+			const QPointF boundary = polyline.chunks.last().points.last();
+			chunk.points << boundary;
+			chunk.bounds = QRectF(boundary, boundary);
+		}
+
+		polyline.chunks << chunk;
+	}
+
+	Chunk &chunk = polyline.chunks.last();
+	if (chunk.points.isEmpty()) {
+		chunk.bounds = QRectF(point, point);
+	} else {
+		chunk.bounds.setCoords(qMin(chunk.bounds.left(), point.x()), qMin(chunk.bounds.top(), point.y())
+				, qMax(chunk.bounds.right(), point.x()), qMax(chunk.bounds.bottom(), point.y()));
+	}
+
+	chunk.points << point;
+}
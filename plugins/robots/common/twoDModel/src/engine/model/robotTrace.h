@@ -0,0 +1,91 @@
+/* Copyright 2018 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QVector>
+#include <QtCore/QList>
+#include <QtCore/QLineF>
+#include <QtCore/QRectF>
+#include <QtGui/QPen>
+
+#include <utils/objectsSet.h>
+
+namespace twoDModel {
+namespace model {
+
+/// Robot traces drawn by markers on the floor. Segments drawn by the same pen one after another are joined into
+/// polylines, points of polylines are kept in chunks of limited size. So long traces need neither an object per
+/// segment nor reallocations of large buffers.
+/// For constraints the trace is a collection of segments, each segment is QLineF.
+class RobotTrace : public utils::ObjectsSetBase
+{
+public:
+	/// Maximal number of points in one chunk of a polyline.
+	static const int chunkSize = 256;
+
+	/// A piece of a polyline. Neighbouring chunks share the boundary point, so each chunk can be drawn separately.
+	struct Chunk
+	{
+		QVector<QPointF> points;
+		QRectF bounds;  // Bounding rect of points, pen width is not taken into account.
+	};
+
+	/// Connected segments drawn with the same pen.
+	struct Polyline
+	{
+		QPen pen;
+		QVector<Chunk> chunks;
+	};
+
+	RobotTrace();
+
+	/// Appends a segment from \a begin to \a end drawn with \a pen.
+	/// Returns the area of the floor painted by the segment.
+	QRectF append(const QPen &pen, const QPointF &begin, const QPointF &end);
+
+	/// Removes all segments.
+	void clear();
+
+	/// Returns all polylines of the trace.
+	const QVector<Polyline> &polylines() const;
+
+	/// Returns the area of the floor painted by the whole trace.
+	QRectF boundingRect() const;
+
+	/// Returns the area painted by the segment between points of a polyline drawn with \a pen.
+	static QRectF paintedRect(const QPen &pen, const QRectF &bounds);
+
+	QVariant first() const override;
+	QVariant last() const override;
+	bool isEmpty() const override;
+	int size() const override;
+	void iterate(const Visitor &visitor) const override;
+
+private:
+	/// Maximal number of polylines which may be continued by new segments, one per marker is enough.
+	static const int maxOpenPolylines = 16;
+
+	Polyline *continuedPolyline(const QPen &pen, const QPointF &begin);
+	void addPoint(Polyline &polyline, const QPointF &point);
+
+	QVector<Polyline> mPolylines;
+	QList<int> mOpenPolylines;  // Indices of polylines, the most recently started is the last one.
+	QRectF mBoundingRect;
+	QLineF mLastSegment;
+	int mSegmentsCount;
+};
+
+}
+}
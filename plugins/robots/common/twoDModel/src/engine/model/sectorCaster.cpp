@@ -0,0 +1,136 @@
+/* Copyright 2018 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "sectorCaster.h"
+
+#include <limits>
+
+#include <QtCore/qmath.h>
+
+using namespace twoDModel::model;
+
+static const qreal eps = 1e-9;
+
+static qreal cross(const QPointF &a, const QPointF &b)
+{
+	return a.x() * b.y() - a.y() * b.x();
+}
+
+static QPointF unitVector(qreal angleInRadians)
+{
+	return QPointF(qCos(angleInRadians), qSin(angleInRadians));
+}
+
+SectorCaster::SectorCaster(const QPointF &origin, qreal direction, qreal angle)
+	: mOrigin(origin)
+	, mDirection(qDegreesToRadians(direction))
+	, mHalfAngle(qDegreesToRadians(angle) / 2)
+	, mFullCircle(angle >= 360)
+	, mLeftRay(unitVector(mDirection - mHalfAngle))
+	, mRightRay(unitVector(mDirection + mHalfAngle))
+	, mDistance(std::numeric_limits<qreal>::infinity())
+{
+}
+
+void SectorCaster::cast(const QPolygonF &polygon)
+{
+	if (polygon.isEmpty() || qFuzzyIsNull(mDistance)) {
+		return;
+	}
+
+	if (polygon.containsPoint(mOrigin, Qt::WindingFill)) {
+		mDistance = 0;
+		return;
+	}
+
+	for (int i = 0; i < polygon.size(); ++i) {
+		castSegment(polygon[i], polygon[(i + 1) % polygon.size()]);
+	}
+}
+
+qreal SectorCaster::distance() const
+{
+	return mDistance;
+}
+
+void SectorCaster::castSegment(const QPointF &begin, const QPointF &end)
+{
+	// Distance to a point of a segment is convex along the segment, so its minimum over the part of the segment
+	// inside the sector is reached either at the perpendicular foot or at the ends of that part. Those are
+	// segment ends or intersections of the segment with the sector sides.
+	consider(begin);
+	consider(end);
+
+	const QPointF segment = end - begin;
+	const qreal lengthSquared = QPointF::dotProduct(segment, segment);
+	if (lengthSquared > eps) {
+		const qreal t = QPointF::dotProduct(mOrigin - begin, segment) / lengthSquared;
+		if (t > 0 && t < 1) {
+			consider(begin + t * segment);
+		}
+	}
+
+	if (!mFullCircle) {
+		castRay(mLeftRay, begin, end);
+		castRay(mRightRay, begin, end);
+	}
+}
+
+void SectorCaster::castRay(const QPointF &rayDirection, const QPointF &begin, const QPointF &end)
+{
+	const QPointF segment = end - begin;
+	const qreal denominator = cross(rayDirection, segment);
+	if (qAbs(denominator) < eps) {
+		return;
+	}
+
+	const QPointF toBegin = begin - mOrigin;
+	const qreal rayParameter = cross(toBegin, segment) / denominator;
+	const qreal segmentParameter = cross(toBegin, rayDirection) / denominator;
+	if (rayParameter >= 0 && segmentParameter >= 0 && segmentParameter <= 1 && rayParameter < mDistance) {
+		mDistance = rayParameter;
+	}
+}
+
+void SectorCaster::consider(const QPointF &point)
+{
+	const QPointF offset = point - mOrigin;
+	const qreal distance = qSqrt(QPointF::dotProduct(offset, offset));
+	if (distance < mDistance && inSector(point)) {
+		mDistance = distance;
+	}
+}
+
+bool SectorCaster::inSector(const QPointF &point) const
+{
+	if (mFullCircle) {
+		return true;
+	}
+
+	const QPointF offset = point - mOrigin;
+	if (qAbs(offset.x()) < eps && qAbs(offset.y()) < eps) {
+		return true;
+	}
+
+	qreal angle = qAtan2(offset.y(), offset.x()) - mDirection;
+	while (angle > M_PI) {
+		angle -= 2 * M_PI;
+	}
+
+	while (angle <= -M_PI) {
+		angle += 2 * M_PI;
+	}
+
+	return qAbs(angle) <= mHalfAngle + eps;
+}
@@ -0,0 +1,55 @@
+/* Copyright 2018 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QPointF>
+#include <QtGui/QPolygonF>
+
+namespace twoDModel {
+namespace model {
+
+/// Finds the exact distance from the apex of a circular sector to the nearest obstacle point lying inside it.
+/// Used by range sensors instead of probing intersections of sector-shaped paths with obstacles.
+class SectorCaster
+{
+public:
+	/// @param origin The apex of the sector in scene coordinates.
+	/// @param direction The direction of sector bisector in degrees, clockwise (the same as item rotation).
+	/// @param angle Sector width in degrees.
+	SectorCaster(const QPointF &origin, qreal direction, qreal angle);
+
+	/// Takes closed \a polygon into account as an obstacle.
+	void cast(const QPolygonF &polygon);
+
+	/// Returns the distance to the nearest obstacle point in the sector seen so far or infinity if there were none.
+	qreal distance() const;
+
+private:
+	void castSegment(const QPointF &begin, const QPointF &end);
+	void castRay(const QPointF &rayDirection, const QPointF &begin, const QPointF &end);
+	void consider(const QPointF &point);
+	bool inSector(const QPointF &point) const;
+
+	const QPointF mOrigin;
+	const qreal mDirection;
+	const qreal mHalfAngle;
+	const bool mFullCircle;
+	const QPointF mLeftRay;
+	const QPointF mRightRay;
+	qreal mDistance;
+};
+
+}
+}
@@ -42,11 +42,11 @@ void SensorsConfiguration::onDeviceConfigurationChanged(const QString &robotId
 		return;
 	}
 
-	emit deviceAdded(port, reason == Reason::loading);
-
 	// If there was no sensor before then placing it right in front of the robot;
-	// else putting it instead of old one.
+	// else putting it instead of old one. Position is set before notifying, so subscribers place the sensor right.
 	mSensorsInfo[port] = mSensorsInfo[port].isNull ? SensorInfo(defaultPosition(), 0) : mSensorsInfo[port];
+
+	emit deviceAdded(port, reason == Reason::loading);
 }
 
 QPointF SensorsConfiguration::defaultPosition() const
@@ -14,6 +14,8 @@
 
 #include <QtCore/QCoreApplication>
 #include <QtCore/QDateTime>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QMutexLocker>
 #include <QThread>
 
 #include "twoDModel/engine/model/timeline.h"
@@ -42,6 +44,13 @@ Timeline::Timeline(QObject *parent)
 void Timeline::start()
 {
 	if (!mIsStarted) {
+		{
+			// Threads will be known again when they start working with model time.
+			QMutexLocker lock(&mTimersMutex);
+			mThreads.clear();
+			mWaitingThreads.clear();
+		}
+
 		mIsStarted = true;
 		emit started();
 		emit tick(); /// hack so that constraints init-on would start immediatly
@@ -68,11 +77,16 @@ void Timeline::onTimer()
 		return;
 	}
 
+	if (mFastForward) {
+		mTimer.stop();
+		fastForward();
+		return;
+	}
+
 	for (int i = 0; i < ticksPerCycle; ++i) {
 		QCoreApplication::processEvents();
 		if (mIsStarted) {
-			mTimestamp += timeInterval;
-			emit tick();
+			nextTick();
 			++mCyclesCount;
 			if (mCyclesCount >= mSpeedFactor) {
 				mTimer.stop();
@@ -92,6 +106,111 @@ void Timeline::onTimer()
 	}
 }
 
+void Timeline::fastForward()
+{
+	if (mIsFastForwarding) {
+		return;
+	}
+
+	mIsFastForwarding = true;
+	const bool skipping = static_cast<bool>(mIdleUntil);
+	if (skipping) {
+		// Counting events delivered in the thread of timeline, ticks are not skipped while somebody reacts on them.
+		QCoreApplication::instance()->installEventFilter(this);
+	}
+
+	QElapsedTimer sinceEventsProcessing;
+	sinceEventsProcessing.start();
+	while (mIsStarted) {
+		mDeliveredEventsCount = 0;
+
+		// The same as processEvents() in onTimer() for everything interpreters post, but without polling
+		// system event sources each tick.
+		if (sinceEventsProcessing.elapsed() >= mEventsProcessingInterval) {
+			QCoreApplication::processEvents();
+			sinceEventsProcessing.restart();
+		} else {
+			QCoreApplication::sendPostedEvents();
+		}
+
+		if (skipping && mIdleUntil && mIsStarted && mDeliveredEventsCount == 0) {
+			skipIdleTicks();
+		}
+
+		if (!mIsStarted) {
+			break;
+		}
+
+		nextTick();
+		++mCyclesCount;
+		if (mCyclesCount >= mSpeedFactor) {
+			mCyclesCount = 0;
+			emit nextFrame();
+		}
+	}
+
+	if (skipping) {
+		QCoreApplication::instance()->removeEventFilter(this);
+	}
+
+	mIsFastForwarding = false;
+}
+
+void Timeline::nextTick()
+{
+	mTimestamp += timeInterval;
+	emit tick();
+	fireTimers();
+}
+
+void Timeline::skipIdleTicks()
+{
+	// The tick on which the next frame starts is not skipped.
+	quint64 bound = mTimestamp + static_cast<quint64>(mSpeedFactor - mCyclesCount) * timeInterval;
+	{
+		QMutexLocker lock(&mTimersMutex);
+		if (mExpectedThreadsCount > 0 || mWaitingThreads.size() != mThreads.size()) {
+			// Some thread works and may do anything at any moment.
+			return;
+		}
+
+		if (!mTimersQueue.isEmpty()) {
+			bound = qMin(bound, mTimersQueue.firstKey().first);
+		}
+	}
+
+	bound = qMin(bound, mIdleUntil());
+	while (mIsStarted && mTimestamp + timeInterval < bound) {
+		mTimestamp += timeInterval;
+		++mCyclesCount;
+		emit idleTick();
+	}
+}
+
+void Timeline::registerThread(QThread *thread)
+{
+	if (thread != this->thread() && !mThreads.contains(thread)) {
+		mThreads.insert(thread);
+		mExpectedThreadsCount = qMax(0, mExpectedThreadsCount - 1);
+		connect(thread, &QThread::finished, this, &Timeline::forgetThread, Qt::UniqueConnection);
+	}
+}
+
+void Timeline::forgetThread()
+{
+	// Finished thread will never act again. It may be already deleted, so only its address is used here.
+	QThread * const thread = static_cast<QThread *>(sender());
+	QMutexLocker lock(&mTimersMutex);
+	mThreads.remove(thread);
+	mWaitingThreads.remove(thread);
+}
+
+bool Timeline::eventFilter(QObject *object, QEvent *event)
+{
+	++mDeliveredEventsCount;
+	return QObject::eventFilter(object, event);
+}
+
 void Timeline::gotoNextFrame()
 {
 	emit nextFrame();
@@ -103,7 +222,50 @@ void Timeline::gotoNextFrame()
 
 utils::AbstractTimer *Timeline::produceTimerImpl()
 {
-	return new ModelTimer(this);
+	return new ModelTimer(this, mTimersCount++);
+}
+
+void Timeline::scheduleTimer(ModelTimer *timer, int ms)
+{
+	// Timer fires on the first tick after start when at least ms passed, even if ms is zero.
+	const int ticks = (qMax(ms, 1) + timeInterval - 1) / timeInterval;
+
+	QMutexLocker lock(&mTimersMutex);
+	registerThread(QThread::currentThread());
+	if (mTimerTimestamps.contains(timer)) {
+		mTimersQueue.remove(qMakePair(mTimerTimestamps[timer], timer->id()));
+	}
+
+	const quint64 expirationTimestamp = mTimestamp + static_cast<quint64>(ticks) * timeInterval;
+	mTimerTimestamps[timer] = expirationTimestamp;
+	mTimersQueue.insert(qMakePair(expirationTimestamp, timer->id()), timer);
+}
+
+void Timeline::unscheduleTimer(ModelTimer *timer)
+{
+	QMutexLocker lock(&mTimersMutex);
+	if (mTimerTimestamps.contains(timer)) {
+		mTimersQueue.remove(qMakePair(mTimerTimestamps.take(timer), timer->id()));
+	}
+}
+
+void Timeline::fireTimers()
+{
+	forever {
+		ModelTimer *timer = nullptr;
+		{
+			QMutexLocker lock(&mTimersMutex);
+			if (mTimersQueue.isEmpty() || mTimersQueue.firstKey().first > mTimestamp) {
+				return;
+			}
+
+			timer = mTimersQueue.take(mTimersQueue.firstKey());
+			mTimerTimestamps.remove(timer);
+		}
+
+		// Timer handlers may start, stop or delete any timers, so the lock is not held here.
+		timer->fire();
+	}
 }
 
 int Timeline::speedFactor() const
@@ -123,6 +285,11 @@ quint64 Timeline::timestamp() const
 
 utils::AbstractTimer *Timeline::produceTimer()
 {
+	{
+		QMutexLocker lock(&mTimersMutex);
+		registerThread(QThread::currentThread());
+	}
+
 	auto connection = (QThread::currentThread() != this->thread()) ?
 				Qt::BlockingQueuedConnection : Qt::DirectConnection;
 	utils::AbstractTimer *t = nullptr;
@@ -137,6 +304,75 @@ void Timeline::setImmediateMode(bool immediateMode)
 	mFrameLength = immediateMode ? 0 : defaultFrameLength;
 }
 
+void Timeline::setFastForwardMode(bool fastForward, int eventsProcessingInterval)
+{
+	setImmediateMode(fastForward);
+	mFastForward = fastForward;
+	mEventsProcessingInterval = eventsProcessingInterval;
+}
+
+void Timeline::setIdleTicksSkipping(const std::function<quint64()> &idleUntil)
+{
+	mIdleUntil = idleUntil;
+}
+
+void Timeline::beginWaiting(utils::AbstractTimer *timer)
+{
+	QThread * const thread = QThread::currentThread();
+	if (thread == this->thread()) {
+		return;
+	}
+
+	{
+		QMutexLocker lock(&mTimersMutex);
+		registerThread(thread);
+		mWaitingThreads.insert(thread);
+	}
+
+	// Timer fires in the thread of timeline, so the waiting thread is considered working since that moment,
+	// not since it really wakes up.
+	connect(timer, &utils::AbstractTimer::timeout, this, [this, thread]() {
+		QMutexLocker lock(&mTimersMutex);
+		mWaitingThreads.remove(thread);
+	});
+}
+
+void Timeline::endWaiting()
+{
+	QMutexLocker lock(&mTimersMutex);
+	mWaitingThreads.remove(QThread::currentThread());
+}
+
+void Timeline::expectThread()
+{
+	QMutexLocker lock(&mTimersMutex);
+	++mExpectedThreadsCount;
+}
+
+void Timeline::forgetExpectedThreads()
+{
+	QMutexLocker lock(&mTimersMutex);
+	mExpectedThreadsCount = 0;
+}
+
+void Timeline::reset()
+{
+	if (!mIsStarted) {
+		// Timers still waiting keep their remaining time.
+		QMutexLocker lock(&mTimersMutex);
+		QMap<QPair<quint64, quint64>, ModelTimer *> timersQueue;
+		for (auto it = mTimersQueue.cbegin(); it != mTimersQueue.cend(); ++it) {
+			const quint64 expirationTimestamp = it.key().first - mTimestamp;
+			timersQueue.insert(qMakePair(expirationTimestamp, it.key().second), it.value());
+			mTimerTimestamps[it.value()] = expirationTimestamp;
+		}
+
+		mTimersQueue = timersQueue;
+		mTimestamp = 0;
+		mCyclesCount = 0;
+	}
+}
+
 void Timeline::setSpeedFactor(int factor)
 {
 	if (mSpeedFactor != factor) {
@@ -0,0 +1,160 @@
+/* Copyright 2018 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "wallsIndex.h"
+
+#include <QtCore/qmath.h>
+
+#include "src/engine/items/wallItem.h"
+
+using namespace twoDModel::model;
+
+/// Rects with zero width or height never intersect anything in Qt, so query areas are slightly inflated.
+static const qreal areaMargin = 1.0;
+
+WallsIndex::WallsIndex(qreal cellSize)
+	: mCellSize(cellSize)
+{
+}
+
+void WallsIndex::insert(items::WallItem *wall)
+{
+	mEntries.insert(wall, Entry());
+	mDirty.insert(wall);
+}
+
+void WallsIndex::remove(items::WallItem *wall)
+{
+	auto entry = mEntries.find(wall);
+	if (entry == mEntries.end()) {
+		return;
+	}
+
+	unlink(wall, *entry);
+	mEntries.erase(entry);
+	mDirty.remove(wall);
+}
+
+void WallsIndex::invalidate(items::WallItem *wall)
+{
+	if (mEntries.contains(wall)) {
+		mDirty.insert(wall);
+	}
+}
+
+void WallsIndex::clear()
+{
+	mEntries.clear();
+	mCells.clear();
+	mDirty.clear();
+}
+
+QList<twoDModel::items::WallItem *> WallsIndex::walls(const QRectF &area)
+{
+	update();
+
+	const QRectF inflatedArea = area.normalized().adjusted(-areaMargin, -areaMargin, areaMargin, areaMargin);
+	QSet<items::WallItem *> visited;
+	QList<items::WallItem *> result;
+	for (const quint64 cell : cellsOf(inflatedArea)) {
+		for (items::WallItem * const wall : mCells.value(cell)) {
+			if (!visited.contains(wall)) {
+				visited.insert(wall);
+				if (mEntries[wall].bounds.intersects(inflatedArea)) {
+					result << wall;
+				}
+			}
+		}
+	}
+
+	return result;
+}
+
+QPainterPath WallsIndex::path(const QRectF &area)
+{
+	QPainterPath result;
+	for (items::WallItem * const wall : walls(area)) {
+		result.addPath(mEntries[wall].path);
+	}
+
+	return result;
+}
+
+QList<QPolygonF> WallsIndex::polygons(const QRectF &area)
+{
+	QList<QPolygonF> result;
+	for (items::WallItem * const wall : walls(area)) {
+		result << mEntries[wall].polygons;
+	}
+
+	return result;
+}
+
+void WallsIndex::update()
+{
+	for (items::WallItem * const wall : mDirty) {
+		Entry &entry = mEntries[wall];
+		unlink(wall, entry);
+		entry.path = wall->path();
+		entry.polygons = entry.path.toSubpathPolygons();
+		entry.bounds = entry.path.boundingRect();
+		link(wall, entry);
+	}
+
+	mDirty.clear();
+}
+
+void WallsIndex::unlink(items::WallItem *wall, Entry &entry)
+{
+	for (const quint64 cell : entry.cells) {
+		auto bucket = mCells.find(cell);
+		if (bucket != mCells.end()) {
+			bucket->removeOne(wall);
+			if (bucket->isEmpty()) {
+				mCells.erase(bucket);
+			}
+		}
+	}
+
+	entry.cells.clear();
+}
+
+void WallsIndex::link(items::WallItem *wall, Entry &entry)
+{
+	if (entry.path.isEmpty()) {
+		return;
+	}
+
+	entry.cells = cellsOf(entry.bounds);
+	for (const quint64 cell : entry.cells) {
+		mCells[cell] << wall;
+	}
+}
+
+QList<quint64> WallsIndex::cellsOf(const QRectF &rect) const
+{
+	const int left = qFloor(rect.left() / mCellSize);
+	const int right = qFloor(rect.right() / mCellSize);
+	const int top = qFloor(rect.top() / mCellSize);
+	const int bottom = qFloor(rect.bottom() / mCellSize);
+
+	QList<quint64> result;
+	for (int x = left; x <= right; ++x) {
+		for (int y = top; y <= bottom; ++y) {
+			result << ((static_cast<quint64>(static_cast<quint32>(x)) << 32) | static_cast<quint32>(y));
+		}
+	}
+
+	return result;
+}
@@ -0,0 +1,81 @@
+/* Copyright 2018 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QHash>
+#include <QtCore/QSet>
+#include <QtCore/QRectF>
+#include <QtGui/QPainterPath>
+
+namespace twoDModel {
+
+namespace items {
+class WallItem;
+}
+
+namespace model {
+
+/// Uniform grid over the bounding rects of the walls in the world model. Lets collision and range queries
+/// collect only walls lying near the queried area instead of uniting the paths of all walls of the world.
+/// Walls are re-indexed lazily: invalidate() only marks a wall as dirty, its geometry is re-read on the next query.
+class WallsIndex
+{
+public:
+	/// @param cellSize A size of one grid cell in scene pixels.
+	explicit WallsIndex(qreal cellSize = 100);
+
+	/// Starts tracking \a wall.
+	void insert(items::WallItem *wall);
+
+	/// Stops tracking \a wall.
+	void remove(items::WallItem *wall);
+
+	/// Marks the geometry of \a wall as outdated.
+	void invalidate(items::WallItem *wall);
+
+	/// Forgets all the walls.
+	void clear();
+
+	/// Returns a list of walls whose bounding rects intersect \a area.
+	QList<items::WallItem *> walls(const QRectF &area);
+
+	/// Returns united path of walls whose bounding rects intersect \a area.
+	QPainterPath path(const QRectF &area);
+
+	/// Returns outlines of walls whose bounding rects intersect \a area.
+	QList<QPolygonF> polygons(const QRectF &area);
+
+private:
+	struct Entry
+	{
+		QPainterPath path;
+		QList<QPolygonF> polygons;
+		QRectF bounds;
+		QList<quint64> cells;
+	};
+
+	void update();
+	void unlink(items::WallItem *wall, Entry &entry);
+	void link(items::WallItem *wall, Entry &entry);
+	QList<quint64> cellsOf(const QRectF &rect) const;
+
+	const qreal mCellSize;
+	QHash<items::WallItem *, Entry> mEntries;
+	QHash<quint64, QList<items::WallItem *>> mCells;
+	QSet<items::WallItem *> mDirty;
+};
+
+}
+}
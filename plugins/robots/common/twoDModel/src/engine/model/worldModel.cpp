@@ -12,6 +12,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License. */
 
+#include <QtCore/qmath.h>
 #include <QtGui/QTransform>
 #include <QtCore/QStringList>
 #include <QtCore/QUuid>
@@ -22,6 +23,9 @@
 #include "twoDModel/engine/model/worldModel.h"
 #include "twoDModel/engine/model/image.h"
 
+#include "src/engine/model/sectorCaster.h"
+#include "src/engine/model/robotTrace.h"
+#include "src/engine/model/wallsIndex.h"
 #include "src/engine/items/wallItem.h"
 #include "src/engine/items/skittleItem.h"
 #include "src/engine/items/ballItem.h"
@@ -38,6 +42,9 @@
 using namespace twoDModel;
 using namespace model;
 
+/// Compensates floating point errors of exact distances when converting them into whole centimeters.
+static const qreal rangeReadingEpsilon = 1e-6;
+
 //#define D2_MODEL_FRAMES_DEBUG
 
 #ifdef D2_MODEL_FRAMES_DEBUG
@@ -46,7 +53,9 @@ QGraphicsPathItem *debugPath = nullptr;
 #endif
 
 WorldModel::WorldModel()
-	: mXmlFactory(new QDomDocument)
+	: mRobotTrace(new RobotTrace)
+	, mXmlFactory(new QDomDocument)
+	, mWallsIndex(new WallsIndex)
 	, mErrorReporter(nullptr)
 {
 }
@@ -72,34 +81,20 @@ qreal WorldModel::pixelsInCm() const
 
 int WorldModel::rangeReading(const QPointF &position, qreal direction, int maxDistance, qreal maxAngle) const
 {
-	int maxRangeCms = maxDistance;
-	int minRangeCms = 0;
-	int currentRangeInCm = (minRangeCms + maxRangeCms) / 2;
-
-	const QPainterPath path = buildSolidItemsPath();
-	if (!checkRangeDistance(maxRangeCms, position, direction, maxAngle, path)) {
-		return maxRangeCms;
+	const QRectF scanningArea = rangeSensorScanningRegion(position, direction
+			, QPair<qreal,int>(maxAngle, maxDistance)).boundingRect();
+	SectorCaster caster(position, direction, maxAngle);
+	for (const QPolygonF &polygon : buildSolidItemsPolygons(scanningArea)) {
+		caster.cast(polygon);
 	}
 
-	for ( ; minRangeCms < maxRangeCms;
-			currentRangeInCm = (minRangeCms + maxRangeCms) / 2)
-	{
-		if (checkRangeDistance(currentRangeInCm, position, direction, maxAngle, path)) {
-			maxRangeCms = currentRangeInCm;
-		} else {
-			minRangeCms = currentRangeInCm + 1;
-		}
+	// The reading is the least whole number of centimeters at which scanning region touches some obstacle.
+	const qreal distanceInCm = caster.distance() / pixelsInCm();
+	if (distanceInCm >= maxDistance) {
+		return maxDistance;
 	}
 
-	return currentRangeInCm;
-}
-
-bool WorldModel::checkRangeDistance(const int distance, const QPointF &position
-		, const qreal direction, const qreal scanningAngle, const QPainterPath &wallPath) const
-{
-	const QPainterPath rayPath = rangeSensorScanningRegion(position, direction
-			, QPair<qreal,int>(scanningAngle, distance));
-	return rayPath.intersects(wallPath);
+	return qMax(0, qCeil(distanceInCm - rangeReadingEpsilon));
 }
 
 QPainterPath WorldModel::rangeSensorScanningRegion(const QPointF &position, QPair<qreal,int> angleAndRange) const
@@ -125,7 +120,7 @@ bool WorldModel::checkCollision(const QPainterPath &path) const
 {
 #ifdef D2_MODEL_FRAMES_DEBUG
 	delete debugPath;
-	QPainterPath commonPath = buildSolidItemsPath();
+	QPainterPath commonPath = buildSolidItemsPath(path.boundingRect());
 	commonPath.addPath(path);
 	debugPath = new QGraphicsPathItem(commonPath);
 	debugPath->setBrush(Qt::red);
@@ -142,7 +137,7 @@ bool WorldModel::checkCollision(const QPainterPath &path) const
 	}
 #endif
 
-	return buildSolidItemsPath().intersects(path);
+	return buildSolidItemsPath(path.boundingRect()).intersects(path);
 }
 
 const QMap<QString, items::WallItem *> &WorldModel::walls() const
@@ -170,12 +165,21 @@ void WorldModel::addWall(items::WallItem *wall)
 
 	mWalls[id] = wall;
 	mOrder[id] = mOrder.size();
+	mWallsIndex->insert(wall);
+	auto invalidateWall = [this, wall]() { mWallsIndex->invalidate(wall); };
+	connect(wall, &graphicsUtils::AbstractItem::positionChanged, this, invalidateWall);
+	connect(wall, &graphicsUtils::AbstractItem::x1Changed, this, invalidateWall);
+	connect(wall, &graphicsUtils::AbstractItem::y1Changed, this, invalidateWall);
+	connect(wall, &graphicsUtils::AbstractItem::x2Changed, this, invalidateWall);
+	connect(wall, &graphicsUtils::AbstractItem::y2Changed, this, invalidateWall);
 	emit wallAdded(wall);
 }
 
 void WorldModel::removeWall(items::WallItem *wall)
 {
 	mWalls.remove(wall->id());
+	mWallsIndex->remove(wall);
+	disconnect(wall, nullptr, this, nullptr);
 	emit itemRemoved(wall);
 }
 
@@ -230,9 +234,9 @@ const QMap<QString, items::RegionItem *> &WorldModel::regions() const
 	return mRegions;
 }
 
-const QList<QGraphicsLineItem *> &WorldModel::trace() const
+RobotTrace &WorldModel::trace() const
 {
-	return mRobotTrace;
+	return *mRobotTrace;
 }
 
 void WorldModel::addColorField(items::ColorFieldItem *colorField)
@@ -329,46 +333,64 @@ void WorldModel::appendRobotTrace(const QPen &pen, const QPointF &begin, const Q
 		return;
 	}
 
-	QGraphicsLineItem * const traceItem = new QGraphicsLineItem(QLineF(begin, end));
-	traceItem->setPen(pen);
-
-	if (mRobotTrace.isEmpty()) {
+	if (mRobotTrace->isEmpty()) {
 		emit robotTraceAppearedOrDisappeared(true);
 	}
 
-	mRobotTrace << traceItem;
-	emit traceItemAdded(traceItem);
+	emit robotTraceChanged(mRobotTrace->append(pen, begin, end));
 }
 
 void WorldModel::clearRobotTrace()
 {
-	while (!mRobotTrace.isEmpty()) {
-		QGraphicsLineItem * const toRemove = mRobotTrace.first();
-		mRobotTrace.removeOne(toRemove);
-		emit itemRemoved(toRemove);
-	}
-
+	const QRectF traceRect = mRobotTrace->boundingRect();
+	mRobotTrace->clear();
+	emit robotTraceChanged(traceRect);
 	emit robotTraceAppearedOrDisappeared(false);
 }
 
-QPainterPath WorldModel::buildSolidItemsPath() const
+QPainterPath WorldModel::buildSolidItemsPath(const QRectF &area) const
 {
-	/// @todo Maintain a cache for this.
-	QPainterPath path;
+	QPainterPath path = mWallsIndex->path(area);
+
+	// Skittles and balls are few and are moved by physics each frame, so they are filtered without an index.
+	const QRectF inflatedArea = area.normalized().adjusted(-1, -1, 1, 1);
+	for (items::SkittleItem *skittle: mSkittles) {
+		const QPainterPath skittlePath = skittle->path();
+		if (skittlePath.boundingRect().intersects(inflatedArea)) {
+			path.addPath(skittlePath);
+		}
+	}
 
-	for (items::WallItem *wall : mWalls) {
-		path.addPath(wall->path());
+	for (items::BallItem *ball: mBalls) {
+		const QPainterPath ballPath = ball->path();
+		if (ballPath.boundingRect().intersects(inflatedArea)) {
+			path.addPath(ballPath);
+		}
 	}
 
+	return path;
+}
+
+QList<QPolygonF> WorldModel::buildSolidItemsPolygons(const QRectF &area) const
+{
+	QList<QPolygonF> polygons = mWallsIndex->polygons(area);
+
+	const QRectF inflatedArea = area.normalized().adjusted(-1, -1, 1, 1);
 	for (items::SkittleItem *skittle: mSkittles) {
-		path.addPath(skittle->path());
+		const QPainterPath skittlePath = skittle->path();
+		if (skittlePath.boundingRect().intersects(inflatedArea)) {
+			polygons << skittlePath.toSubpathPolygons();
+		}
 	}
 
 	for (items::BallItem *ball: mBalls) {
-		path.addPath(ball->path());
+		const QPainterPath ballPath = ball->path();
+		if (ballPath.boundingRect().intersects(inflatedArea)) {
+			polygons << ballPath.toSubpathPolygons();
+		}
 	}
 
-	return path;
+	return polygons;
 }
 
 void WorldModel::serializeBackground(QDomElement &background, const QRect &rect, const Image * const img) const
@@ -34,6 +34,7 @@
 #include "twoDModel/engine/twoDModelGuiFacade.h"
 #include "twoDModel/engine/model/model.h"
 #include "twoDModel/engine/model/constants.h"
+#include "twoDModel/engine/model/pixelStatistics.h"
 #include "twoDModel/engine/view/twoDModelWidget.h"
 
 #include "view/scene/twoDModelScene.h"
@@ -51,9 +52,11 @@ using namespace twoDModel;
 using namespace kitBase::robotModel;
 using namespace twoDModel::model;
 
-TwoDModelEngineApi::TwoDModelEngineApi(model::Model &model, view::TwoDModelWidget &view)
+TwoDModelEngineApi::TwoDModelEngineApi(model::Model &model, view::TwoDModelWidget *view
+		, const robotModel::TwoDRobotModel &robotModel)
 	: mModel(model)
 	, mView(view)
+	, mRobotModel(robotModel)
 	, mFakeScene(new view::FakeScene(mModel.worldModel()))
 	, mGuiFacade(new engine::TwoDModelGuiFacade(mView))
 {
@@ -68,7 +71,7 @@ TwoDModelEngineApi::~TwoDModelEngineApi()
 
 void TwoDModelEngineApi::setNewMotor(int speed, uint degrees, const PortInfo &port, bool breakMode)
 {
-	auto target = mModel.robotModels()[0];
+	auto target = robot();
 	QMetaObject::invokeMethod(target, "setNewMotor"
 		, QThread::currentThread() != target->thread() ? Qt::BlockingQueuedConnection : Qt::DirectConnection
 		, Q_ARG(int, speed), Q_ARG(uint, degrees), Q_ARG(kitBase::robotModel::PortInfo, port), Q_ARG(bool, breakMode));
@@ -77,7 +80,7 @@ void TwoDModelEngineApi::setNewMotor(int speed, uint degrees, const PortInfo &po
 int TwoDModelEngineApi::readEncoder(const PortInfo &port) const
 {
 	int t;
-	auto target = mModel.robotModels()[0];
+	auto target = robot();
 	QMetaObject::invokeMethod(target, "readEncoder"
 		, QThread::currentThread() != target->thread() ? Qt::BlockingQueuedConnection : Qt::DirectConnection
 		, Q_RETURN_ARG(int, t), Q_ARG(kitBase::robotModel::PortInfo, port));
@@ -86,7 +89,7 @@ int TwoDModelEngineApi::readEncoder(const PortInfo &port) const
 
 void TwoDModelEngineApi::resetEncoder(const PortInfo &port)
 {
-	auto target = mModel.robotModels()[0];
+	auto target = robot();
 	QMetaObject::invokeMethod(target, "resetEncoder"
 		, QThread::currentThread() != target->thread() ? Qt::BlockingQueuedConnection : Qt::DirectConnection
 		, Q_ARG(kitBase::robotModel::PortInfo, port));
@@ -94,14 +97,14 @@ void TwoDModelEngineApi::resetEncoder(const PortInfo &port)
 
 int TwoDModelEngineApi::readTouchSensor(const PortInfo &port) const
 {
-	if (!mModel.robotModels()[0]->configuration().type(port).isA<robotParts::TouchSensor>()) {
+	if (!robot()->configuration().type(port).isA<robotParts::TouchSensor>()) {
 		return touchSensorNotPressedSignal;
 	}
 
 	QPair<QPointF, qreal> const neededPosDir = countPositionAndDirection(port);
 	const QPointF position(neededPosDir.first);
 	const qreal rotation = neededPosDir.second / 180 * mathUtils::pi;
-	const QRectF rect = mModel.robotModels()[0]->sensorRect(port, position);
+	const QRectF rect = robot()->sensorRect(port, position);
 
 	QPainterPath sensorPath;
 	const qreal touchRegionRadius = qCeil(rect.height() / qSqrt(2));
@@ -131,7 +134,7 @@ int TwoDModelEngineApi::readRangeSensor(const PortInfo &port, int maxDistance, q
 QVector<int> TwoDModelEngineApi::readAccelerometerSensor() const
 {
 	QVector<int> t;
-	auto target = mModel.robotModels()[0];
+	auto target = robot();
 	QMetaObject::invokeMethod(target, "accelerometerReading"
 		, QThread::currentThread() != target->thread() ? Qt::BlockingQueuedConnection : Qt::DirectConnection
 		, Q_RETURN_ARG(QVector<int>, t));
@@ -141,7 +144,7 @@ QVector<int> TwoDModelEngineApi::readAccelerometerSensor() const
 QVector<int> TwoDModelEngineApi::readGyroscopeSensor() const
 {
 	QVector<int> t;
-	auto target = mModel.robotModels()[0];
+	auto target = robot();
 	QMetaObject::invokeMethod(target, "gyroscopeReading"
 			, QThread::currentThread() != target->thread() ? Qt::BlockingQueuedConnection : Qt::DirectConnection
 			, Q_RETURN_ARG(QVector<int>, t));
@@ -151,7 +154,7 @@ QVector<int> TwoDModelEngineApi::readGyroscopeSensor() const
 QVector<int> TwoDModelEngineApi::calibrateGyroscopeSensor()
 {
 	QVector<int> t;
-	auto target = mModel.robotModels()[0];
+	auto target = robot();
 	QMetaObject::invokeMethod(target, "gyroscopeCalibrate"
 			, QThread::currentThread() != target->thread() ? Qt::BlockingQueuedConnection : Qt::DirectConnection
 			, Q_RETURN_ARG(QVector<int>, t));
@@ -166,29 +169,31 @@ int TwoDModelEngineApi::spoilRangeReading(const int distance) const
 
 int TwoDModelEngineApi::readColorSensor(const PortInfo &port) const
 {
-	const QImage image = areaUnderSensor(port, 1.0);
-	QHash<uint, int> countsColor;
-
-	const uint *data = reinterpret_cast<const uint *>(image.bits());
+	QImage image = areaUnderSensor(port, 1.0);
+	QRgb * const data = reinterpret_cast<QRgb *>(image.bits());
 	const int n = image.byteCount() / 4;
-	for (int i = 0; i < n; ++i) {
-		const uint color = mModel.settings().realisticSensors() ? spoilColor(data[i]) : data[i];
-		++countsColor[color];
+	if (mModel.settings().realisticSensors()) {
+		for (int i = 0; i < n; ++i) {
+			data[i] = spoilColor(data[i]);
+		}
 	}
 
-	if (mModel.robotModels()[0]->configuration().type(port).isA<robotParts::ColorSensorFull>()) {
-		return readColorFullSensor(countsColor);
-	} else if (mModel.robotModels()[0]->configuration().type(port).isA<robotParts::ColorSensorPassive>()) {
-		return readColorNoneSensor(countsColor, n);
-	} else if (mModel.robotModels()[0]->configuration().type(port).isA<robotParts::ColorSensorRed>()) {
-		return readSingleColorSensor(red, countsColor, n);
-	} else if (mModel.robotModels()[0]->configuration().type(port).isA<robotParts::ColorSensorGreen>()) {
-		return readSingleColorSensor(green, countsColor, n);
-	} else if (mModel.robotModels()[0]->configuration().type(port).isA<robotParts::ColorSensorBlue>()) {
-		return readSingleColorSensor(blue, countsColor, n);
-	} else if (mModel.robotModels()[0]->configuration().type(port).isA<robotParts::ColorSensorAmbient>()) {
+	const QVector<int> histogram = PixelStatistics::paletteHistogram(data, n);
+	const DeviceInfo device = robot()->configuration().type(port);
+
+	if (device.isA<robotParts::ColorSensorFull>()) {
+		return readColorFullSensor(histogram, data, n);
+	} else if (device.isA<robotParts::ColorSensorPassive>()) {
+		return readColorNoneSensor(histogram, data, n);
+	} else if (device.isA<robotParts::ColorSensorRed>()) {
+		return readSingleColorSensor(red, histogram, n);
+	} else if (device.isA<robotParts::ColorSensorGreen>()) {
+		return readSingleColorSensor(green, histogram, n);
+	} else if (device.isA<robotParts::ColorSensorBlue>()) {
+		return readSingleColorSensor(blue, histogram, n);
+	} else if (device.isA<robotParts::ColorSensorAmbient>()) {
 		return readLightSensor(port);
-	} else if (mModel.robotModels()[0]->configuration().type(port).isA<robotParts::ColorSensorReflected>()) {
+	} else if (device.isA<robotParts::ColorSensorReflected>()) {
 		return readLightSensor(port);
 	}
 
@@ -214,9 +219,10 @@ uint TwoDModelEngineApi::spoilColor(const uint color) const
 
 QImage TwoDModelEngineApi::areaUnderSensor(const PortInfo &port, qreal widthFactor) const
 {
-	DeviceInfo device = mModel.robotModels()[0]->configuration().type(port);
+	RobotModel * const robotModel = robot();
+	DeviceInfo device = robotModel->configuration().type(port);
 	if (device.isNull()) {
-		device = mModel.robotModels()[0]->info().specialDevices()[port];
+		device = robotModel->info().specialDevices()[port];
 		if (device.isNull()) {
 			return QImage();
 		}
@@ -225,141 +231,143 @@ QImage TwoDModelEngineApi::areaUnderSensor(const PortInfo &port, qreal widthFact
 	const QPair<QPointF, qreal> neededPosDir = countPositionAndDirection(port);
 	const QPointF position = neededPosDir.first;
 	const qreal direction = neededPosDir.second;
-	const QRect imageRect = mModel.robotModels()[0]->info().sensorImageRect(device);
+	const QRect imageRect = robotModel->info().sensorImageRect(device);
 	const qreal width = imageRect.width() * widthFactor / 2.0;
 
-	const QRectF sensorRectangle = QTransform().rotate(direction).map(QPolygonF(QRectF(imageRect))).boundingRect();
-	const qreal rotationFactor = sensorRectangle.width() / imageRect.width();
-
-	const qreal realWidth = width * rotationFactor;
-	const QRectF scanningRect = QRectF(position.x() - realWidth, position.y() - realWidth
-			, 2 * realWidth, 2 * realWidth);
-	const QImage image(mFakeScene->render(scanningRect));
+	// The image is the square piece of the floor centered at the sensor and rotated along with it.
 	const QPoint offset = QPointF(width, width).toPoint() - QPoint(1, 1);
-	const QImage rotated(image.transformed(QTransform().rotate(-(90 + direction))));
-	const QRect realImage(rotated.rect().center() - offset, rotated.rect().center() + offset);
-	QImage result(realImage.size(), QImage::Format_RGB32);
-	result.fill(Qt::white);
-	QPainter painter(&result);
-	painter.drawImage(QRect(QPoint(), result.size()), rotated, realImage);
-	painter.end();
+	const QImage result = mFakeScene->sample(position, 90 + direction
+			, QSize(2 * offset.x() + 1, 2 * offset.y() + 1));
 
 #ifdef BACKGROUND_SCENE_DEBUGGING
-	mView.scene()->addItem(new QGraphicsPixmapItem(QPixmap::fromImage(result)));
+	if (mView) {
+		mView->scene()->addItem(new QGraphicsPixmapItem(QPixmap::fromImage(result)));
+	}
 #endif
 
 	return result;
 }
 
-int TwoDModelEngineApi::readColorFullSensor(QHash<uint, int> const &countsColor) const
+int TwoDModelEngineApi::readColorFullSensor(const QVector<int> &histogram, const QRgb *data, int n) const
 {
-	if (countsColor.isEmpty()) {
+	if (n == 0) {
 		return 0;
 	}
 
-	QList<int> const values = countsColor.values();
-	int maxValue = INT_MIN;
-	for (int value : values) {
-		if (value > maxValue) {
-			maxValue = value;
+	int maxIndex = 0;
+	for (int i = 1; i < PixelStatistics::paletteSize; ++i) {
+		if (histogram[i] > histogram[maxIndex]) {
+			maxIndex = i;
 		}
 	}
 
-	const uint maxColor = countsColor.key(maxValue);
-	switch (maxColor) {
-	case (black):
-		return 1;
-	case (red):
-		return 5;
-	case (green):
-		return 3;
-	case (blue) :
-		return 2;
-	case (yellow):
-		return 4;
-	case (white):
-		return 6;
-	case (cyan):
-		return 7;
-	case (magenta):
-		return 8;
-	default:
-		return 0;
+	// Pixels of non-palette colors are counted together, but only the most frequent of them may outnumber the most
+	// frequent palette color. That is checked precisely only when it is possible at all.
+	if (histogram[PixelStatistics::paletteSize] >= histogram[maxIndex]) {
+		QHash<uint, int> otherColorsCount;
+		int maxOtherCount = 0;
+		for (int i = 0; i < n; ++i) {
+			if (paletteIndex(data[i]) < 0) {
+				maxOtherCount = qMax(maxOtherCount, ++otherColorsCount[data[i]]);
+			}
+		}
+
+		if (maxOtherCount > histogram[maxIndex]) {
+			return 0;
+		}
 	}
+
+	return histogram[maxIndex] > 0 ? maxIndex + 1 : 0;
 }
 
-int TwoDModelEngineApi::readSingleColorSensor(uint color, QHash<uint, int> const &countsColor, int n) const
+int TwoDModelEngineApi::readSingleColorSensor(uint color, const QVector<int> &histogram, int n) const
 {
-	return (static_cast<double>(countsColor[color]) / static_cast<double>(n)) * 100.0;
+	return (static_cast<double>(histogram[paletteIndex(color)]) / static_cast<double>(n)) * 100.0;
 }
 
-int TwoDModelEngineApi::readColorNoneSensor(QHash<uint, int> const &countsColor, int n) const
+int TwoDModelEngineApi::readColorNoneSensor(const QVector<int> &histogram, const QRgb *data, int n) const
 {
-	qreal allWhite = static_cast<qreal>(countsColor[white]);
-
-	QHashIterator<uint, int> i(countsColor);
-	while(i.hasNext()) {
-		i.next();
-		const uint color = i.key();
-		if (color != white) {
-			const int b = (color >> 0) & 0xFF;
-			const int g = (color >> 8) & 0xFF;
-			const int r = (color >> 16) & 0xFF;
-			const qreal k = qSqrt(static_cast<qreal>(b * b + g * g + r * r)) / 500.0;
-			allWhite += static_cast<qreal>(i.value()) * k;
+	const auto whiteness = [](uint color) {
+		const int b = (color >> 0) & 0xFF;
+		const int g = (color >> 8) & 0xFF;
+		const int r = (color >> 16) & 0xFF;
+		return qSqrt(static_cast<qreal>(b * b + g * g + r * r)) / 500.0;
+	};
+
+	const uint * const palette = PixelStatistics::palette();
+	qreal allWhite = 0;
+	for (int i = 0; i < PixelStatistics::paletteSize; ++i) {
+		allWhite += palette[i] == white
+				? static_cast<qreal>(histogram[i])
+				: static_cast<qreal>(histogram[i]) * whiteness(palette[i]);
+	}
+
+	if (histogram[PixelStatistics::paletteSize] > 0) {
+		for (int i = 0; i < n; ++i) {
+			if (paletteIndex(data[i]) < 0) {
+				allWhite += whiteness(data[i]);
+			}
 		}
 	}
 
 	return static_cast<int>((allWhite / static_cast<qreal>(n)) * 100.0);
 }
 
+int TwoDModelEngineApi::paletteIndex(uint color)
+{
+	const uint * const palette = PixelStatistics::palette();
+	for (int i = 0; i < PixelStatistics::paletteSize; ++i) {
+		if (palette[i] == color) {
+			return i;
+		}
+	}
+
+	return -1;
+}
+
 int TwoDModelEngineApi::readLightSensor(const PortInfo &port) const
 {
 	// Must return 1023 on white and 0 on black normalized to percents
 	// http://stackoverflow.com/questions/596216/formula-to-determine-brightness-of-rgb-color
 
-	const QImage image = areaUnderSensor(port, 1.0);
+	QImage image = areaUnderSensor(port, 1.0);
 	if (image.isNull()) {
 		return 0;
 	}
 
-	uint sum = 0;
-	const uint *data = reinterpret_cast<const uint *>(image.bits());
+	QRgb * const data = reinterpret_cast<QRgb *>(image.bits());
 	const int n = image.byteCount() / 4;
-
-	for (int i = 0; i < n; ++i) {
-		const uint color = mModel.settings().realisticSensors() ? spoilLight(data[i]) : data[i];
-		const uint b = (color >> 0) & 0xFF;
-		const uint g = (color >> 8) & 0xFF;
-		const uint r = (color >> 16) & 0xFF;
-		// brightness in [0..256]
-		const uint brightness = static_cast<uint>(0.2126 * r + 0.7152 * g + 0.0722 * b);
-
-		sum += 4 * brightness; // 4 = max sensor value / max brightness value
+	if (mModel.settings().realisticSensors()) {
+		for (int i = 0; i < n; ++i) {
+			data[i] = spoilLight(data[i]);
+		}
 	}
 
+	// brightness in [0..256], 4 = max sensor value / max brightness value
+	const quint64 sum = 4 * PixelStatistics::brightnessSum(data, n);
+
 	const qreal rawValue = sum * 1.0 / n; // Average by whole region
 	return static_cast<int>(rawValue * 100.0 / maxLightSensorValue); // Normalizing to percents
 }
 
 void TwoDModelEngineApi::playSound(int timeInMs)
 {
-	mModel.robotModels()[0]->playSound(timeInMs);
+	robot()->playSound(timeInMs);
 }
 
 bool TwoDModelEngineApi::isMarkerDown() const
 {
-	return mModel.robotModels()[0]->markerColor() != Qt::transparent;
+	return robot()->markerColor() != Qt::transparent;
 }
 
 void TwoDModelEngineApi::markerDown(const QColor &color)
 {
-	mModel.robotModels()[0]->markerDown(color);
+	robot()->markerDown(color);
 }
 
 void TwoDModelEngineApi::markerUp()
 {
-	mModel.robotModels()[0]->markerUp();
+	robot()->markerUp();
 }
 
 utils::TimelineInterface &TwoDModelEngineApi::modelTimeline()
@@ -369,7 +377,12 @@ utils::TimelineInterface &TwoDModelEngineApi::modelTimeline()
 
 engine::TwoDModelDisplayInterface *TwoDModelEngineApi::display()
 {
-	return mView.display();
+	if (mView) {
+		return mView->display();
+	}
+
+	// Without the window robot`s display widget is never shown, but display devices still draw on it.
+	return robot() ? robot()->info().displayWidget() : nullptr;
 }
 
 engine::TwoDModelGuiFacade &TwoDModelEngineApi::guiFacade() const
@@ -390,9 +403,20 @@ uint TwoDModelEngineApi::spoilLight(const uint color) const
 	return color;
 }
 
+RobotModel *TwoDModelEngineApi::robot() const
+{
+	for (RobotModel * const robotModel : mModel.robotModels()) {
+		if (&robotModel->info() == &mRobotModel) {
+			return robotModel;
+		}
+	}
+
+	return mModel.robotModels().isEmpty() ? nullptr : mModel.robotModels().first();
+}
+
 QPair<QPointF, qreal> TwoDModelEngineApi::countPositionAndDirection(const PortInfo &port) const
 {
-	RobotModel * const robotModel = mModel.robotModels()[0];
+	RobotModel * const robotModel = robot();
 	const QPointF rotationCenter = robotModel->info().rotationCenter();
 	const QVector2D sensorVector = QVector2D(robotModel->configuration().position(port) - rotationCenter);
 	const QPointF rotatedVector = mathUtils::Geometry::rotateVector(sensorVector, robotModel->rotation()).toPointF();
@@ -416,8 +440,6 @@ void TwoDModelEngineApi::enableBackgroundSceneDebugging()
 	fakeScene->setMinimumWidth(700);
 	fakeScene->setMinimumHeight(600);
 	fakeScene->setWindowFlags(fakeScene->windowFlags() | Qt::WindowStaysOnTopHint);
-	fakeScene->setVisible(mModel.robotModels().isEmpty()
-			? true
-			: mModel.robotModels()[0]->info().robotId().contains("trik"));
+	fakeScene->setVisible(robot() ? robot()->info().robotId().contains("trik") : true);
 	timer->start();
 }
@@ -22,6 +22,10 @@ namespace twoDModel {
 
 namespace model {
 class Model;
+class RobotModel;
+}
+namespace robotModel {
+class TwoDRobotModel;
 }
 namespace view {
 class TwoDModelWidget;
@@ -32,7 +36,11 @@ class TwoDModelEngineApi : public engine::TwoDModelEngineInterface
 {
 
 public:
-	TwoDModelEngineApi(model::Model &model, view::TwoDModelWidget &view);
+	/// @param view 2D model window, may be null if the model works in headless mode.
+	/// @param robotModel The robot whose devices are emulated by this API. The model may contain other robots too,
+	/// each of them is served by its own API.
+	TwoDModelEngineApi(model::Model &model, view::TwoDModelWidget *view
+			, const robotModel::TwoDRobotModel &robotModel);
 	~TwoDModelEngineApi() override;
 
 	void setNewMotor(int speed, uint degrees
@@ -64,11 +72,18 @@ public:
 	engine::TwoDModelGuiFacade &guiFacade() const override;
 
 private:
+	/// Returns the robot in the model served by this API. If it is not there (for example, it was replaced with
+	/// another one) the first robot of the model is returned.
+	model::RobotModel *robot() const;
+
 	QPair<QPointF, qreal> countPositionAndDirection(const kitBase::robotModel::PortInfo &port) const;
 
-	int readColorFullSensor(QHash<uint, int> const &countsColor) const;
-	int readColorNoneSensor(QHash<uint, int> const &countsColor, int n) const;
-	int readSingleColorSensor(uint color, QHash<uint, int> const &countsColor, int n) const;
+	int readColorFullSensor(const QVector<int> &histogram, const QRgb *data, int n) const;
+	int readColorNoneSensor(const QVector<int> &histogram, const QRgb *data, int n) const;
+	int readSingleColorSensor(uint color, const QVector<int> &histogram, int n) const;
+
+	/// Returns index of \a color in the palette of color sensors or -1 if there is no such color in it.
+	static int paletteIndex(uint color);
 
 	uint spoilColor(const uint color) const;
 	uint spoilLight(const uint color) const;
@@ -77,7 +92,8 @@ private:
 	void enableBackgroundSceneDebugging();
 
 	model::Model &mModel;
-	view::TwoDModelWidget &mView;
+	view::TwoDModelWidget *mView;  // Doesn't have ownership.
+	const robotModel::TwoDRobotModel &mRobotModel;
 	QScopedPointer<view::FakeScene> mFakeScene;
 	QScopedPointer<engine::TwoDModelGuiFacade> mGuiFacade;
 };
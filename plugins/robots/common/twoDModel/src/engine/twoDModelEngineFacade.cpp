@@ -21,26 +21,62 @@
 #include "twoDModel/engine/model/model.h"
 #include "twoDModel/engine/view/twoDModelWidget.h"
 #include "twoDModelEngineApi.h"
+#include "src/engine/model/markerTracer.h"
 
 #include <qrgui/plugins/toolPluginInterface/usedInterfaces/errorReporterInterface.h>
 
 using namespace twoDModel::engine;
 
+static bool headlessMode = false;
+static QList<TwoDModelEngineFacade *> facades;
+
 TwoDModelEngineFacade::TwoDModelEngineFacade(twoDModel::robotModel::TwoDRobotModel &robotModel)
 	: mRobotModelName(robotModel.name())
 	, mModel(new model::Model())
-	, mView(new view::TwoDModelWidget(*mModel))
-	, mApi(new TwoDModelEngineApi(*mModel, *mView))
-	, mDock(new utils::SmartDock("2dModelDock", mView.data()))
+	, mView(headlessMode ? nullptr : new view::TwoDModelWidget(*mModel))
+	, mApi(new TwoDModelEngineApi(*mModel, mView.data(), robotModel))
+	, mDock(headlessMode ? nullptr : new utils::SmartDock("2dModelDock", mView.data()))
 {
+	if (!mView) {
+		// Nobody draws robot traces without scene, so the model does it itself.
+		connect(mModel.data(), &model::Model::robotAdded, this, [this](model::RobotModel *robotModel) {
+			new model::MarkerTracer(*robotModel, mModel->worldModel());
+		});
+	}
+
 	mModel.data()->addRobotModel(robotModel);
+
+	// Other robots of the world (in team tasks) are driven in the same model, each of them needs its own API.
+	connect(mModel.data(), &model::Model::robotAdded, this, [this](model::RobotModel *robotModel) {
+		if (!robotModel->info().engine()) {
+			TwoDModelEngineApi * const api = new TwoDModelEngineApi(*mModel, mView.data(), robotModel->info());
+			mRobotsApis.insert(robotModel, QSharedPointer<TwoDModelEngineInterface>(api));
+			robotModel->info().setEngine(*api);
+		}
+	});
+	connect(mModel.data(), &model::Model::robotRemoved, this, [this](model::RobotModel *robotModel) {
+		const QSharedPointer<TwoDModelEngineInterface> api = mRobotsApis.take(robotModel);
+		if (api && robotModel->info().engine() == api.data()) {
+			// Robot model may outlive its world, it must not keep a pointer to the API deleted here.
+			robotModel->info().resetEngine();
+		}
+	});
+
+	facades << this;
+	if (!mView) {
+		return;
+	}
+
 	connect(mView.data(), &view::TwoDModelWidget::runButtonPressed, this, &TwoDModelEngineFacade::runButtonPressed);
 	connect(mView.data(), &view::TwoDModelWidget::stopButtonPressed, this, &TwoDModelEngineFacade::stopButtonPressed);
 	connect(mView.data(), &view::TwoDModelWidget::widgetClosed, this, &TwoDModelEngineFacade::stopButtonPressed);
 	connect(mDock, &utils::SmartDock::dockedChanged, mView.data(), &view::TwoDModelWidget::setCompactMode);
 }
 
-TwoDModelEngineFacade::~TwoDModelEngineFacade() {}
+TwoDModelEngineFacade::~TwoDModelEngineFacade()
+{
+	facades.removeOne(this);
+}
 
 void TwoDModelEngineFacade::init(const kitBase::EventsForKitPluginInterface &eventsForKitPlugin,
 								 const qReal::SystemEvents &systemEvents,
@@ -52,11 +88,16 @@ void TwoDModelEngineFacade::init(const kitBase::EventsForKitPluginInterface &eve
 								 kitBase::InterpreterControlInterface &interpreterControl)
 {
 	mModel->init(*interpretersInterface.errorReporter(), interpreterControl);
-	dockInterface.registerEditor(*mView);
-	mView->setController(controller);
+	if (mView) {
+		dockInterface.registerEditor(*mView);
+		mView->setController(controller);
+	}
 
 	const auto onActiveTabChanged = [this](const qReal::TabInfo &info) {
-		mView->setEnabled(info.type() != qReal::TabInfo::TabType::other);
+		if (mView) {
+			mView->setEnabled(info.type() != qReal::TabInfo::TabType::other);
+		}
+
 		mCurrentTabInfo = info.type();
 	};
 
@@ -82,7 +123,7 @@ void TwoDModelEngineFacade::init(const kitBase::EventsForKitPluginInterface &eve
 				QString("%1:%2: %3").arg(QString::number(errorLine), QString::number(errorColumn), errorMessage));
 		}
 
-		mView->loadXmls(worldModel, blobs);
+		loadWorld(worldModel, blobs);
 
 		loadReadOnlyFlags(logicalModel);
 		QLOG_DEBUG() << "Reloading 2D world done";
@@ -157,17 +198,26 @@ void TwoDModelEngineFacade::init(const kitBase::EventsForKitPluginInterface &eve
 				const bool isCurrentModel = modelName == mRobotModelName;
 				if (isCurrentModel) {
 					connectTwoDModel();
-					mDock->attachToMainWindow(Qt::TopDockWidgetArea);
+					if (mDock) {
+						mDock->attachToMainWindow(Qt::TopDockWidgetArea);
+					}
 				} else {
 					disconnectTwoDModel();
-					mDock->detachFromMainWindow();
+					if (mDock) {
+						mDock->detachFromMainWindow();
+					}
 				}
 			});
 }
 
 kitBase::DevicesConfigurationProvider &TwoDModelEngineFacade::devicesConfigurationProvider()
 {
-	return *mView;
+	if (mView) {
+		return *mView;
+	}
+
+	// Without the window robot`s sensors configuration is linked with the rest of the environment directly.
+	return mModel->robotModels().first()->configuration();
 }
 
 TwoDModelEngineInterface &TwoDModelEngineFacade::engine()
@@ -175,6 +225,26 @@ TwoDModelEngineInterface &TwoDModelEngineFacade::engine()
 	return *mApi;
 }
 
+twoDModel::model::Model &TwoDModelEngineFacade::model()
+{
+	return *mModel;
+}
+
+void TwoDModelEngineFacade::setHeadless(bool headless)
+{
+	headlessMode = headless;
+}
+
+bool TwoDModelEngineFacade::isHeadless()
+{
+	return headlessMode;
+}
+
+QList<TwoDModelEngineFacade *> TwoDModelEngineFacade::instances()
+{
+	return facades;
+}
+
 void TwoDModelEngineFacade::onStartInterpretation()
 {
 	if (!mModel->settings().realisticPhysics() &&
@@ -205,5 +275,23 @@ void TwoDModelEngineFacade::loadReadOnlyFlags(const qReal::LogicalModelAssistInt
 	load("twoDModelRobotConfigurationReadOnly", kitBase::ReadOnly::RobotSetup);
 	load("twoDModelSimulationSettingsReadOnly", kitBase::ReadOnly::SimulationSettings);
 
-	mView->setInteractivityFlags(readOnlyFlags);
+	if (mView) {
+		mView->setInteractivityFlags(readOnlyFlags);
+	}
+}
+
+void TwoDModelEngineFacade::loadWorld(const QDomDocument &worldModel, const QDomDocument &blobs)
+{
+	if (mView) {
+		mView->loadXmls(worldModel, blobs);
+		return;
+	}
+
+	// The same as the scene does when the model is reloaded, but without any graphical items.
+	mModel->worldModel().clear();
+	for (model::RobotModel * const robotModel : mModel->robotModels()) {
+		robotModel->clear();
+	}
+
+	mModel->deserialize(worldModel, blobs);
 }
@@ -24,30 +24,30 @@
 
 using namespace twoDModel::engine;
 
-TwoDModelGuiFacade::TwoDModelGuiFacade(view::TwoDModelWidget &view)
+TwoDModelGuiFacade::TwoDModelGuiFacade(view::TwoDModelWidget *view)
 	: mD2ModelWidget(view)
 {
 }
 
 QWidget *TwoDModelGuiFacade::widget(const QString &type, const QString &name) const
 {
-	return utils::WidgetFinder::widget(&mD2ModelWidget, type, name);
+	return mD2ModelWidget ? utils::WidgetFinder::widget(mD2ModelWidget, type, name) : nullptr;
 }
 
 QWidget *TwoDModelGuiFacade::twoDModelSceneViewport() const
 {
-	return mD2ModelWidget.scene()->views()[0]->viewport();
+	return mD2ModelWidget ? mD2ModelWidget->scene()->views()[0]->viewport() : nullptr;
 }
 
 QWidget *TwoDModelGuiFacade::twoDModelWidget() const
 {
-	return &mD2ModelWidget;
+	return mD2ModelWidget;
 }
 
 QWidget *TwoDModelGuiFacade::separateTwoDModelWindow() const
 {
-	if (dynamic_cast<utils::QRealDialog *>(mD2ModelWidget.topLevelWidget())) {
-		return &mD2ModelWidget;
+	if (mD2ModelWidget && dynamic_cast<utils::QRealDialog *>(mD2ModelWidget->topLevelWidget())) {
+		return mD2ModelWidget;
 	}
 
 	return nullptr;
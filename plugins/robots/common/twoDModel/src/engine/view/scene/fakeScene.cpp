@@ -14,15 +14,27 @@
 
 #include "fakeScene.h"
 
+#include <QtCore/qmath.h>
+
 #include "twoDModel/engine/model/worldModel.h"
 #include "src/engine/items/wallItem.h"
 #include "src/engine/items/colorFieldItem.h"
 #include "src/engine/items/imageItem.h"
+#include "src/engine/view/scene/robotTraceItem.h"
 
 using namespace twoDModel;
 using namespace view;
 using namespace model;
 
+/// Tiles are squares with the side of 2^tileSizeLog pixels.
+static const int tileSizeLog = 7;
+static const int tileSize = 1 << tileSizeLog;
+
+static quint64 tileKey(int x, int y)
+{
+	return (static_cast<quint64>(static_cast<quint32>(x)) << 32) | static_cast<quint32>(y);
+}
+
 FakeScene::FakeScene(const WorldModel &world)
 {
 	connect(&world, &WorldModel::wallAdded, this, [=](items::WallItem *wall) { addClone(wall, wall->clone()); });
@@ -33,9 +45,14 @@ FakeScene::FakeScene(const WorldModel &world)
 			addClone(item, item->clone());
 		}
 	});
-	connect(&world, &WorldModel::traceItemAdded, this, [=](QGraphicsLineItem *item) {
-		addClone(item, new QGraphicsLineItem(item->line()));
+
+	RobotTraceItem * const trace = new RobotTraceItem(world.trace());
+	addItem(trace);
+	connect(&world, &WorldModel::robotTraceChanged, this, [=](const QRectF &rect) {
+		trace->onTraceChanged(rect);
+		dropTiles(rect);
 	});
+
 	connect(&world, &WorldModel::itemRemoved, this, &FakeScene::deleteItem);
 }
 
@@ -43,6 +60,8 @@ void FakeScene::addClone(QGraphicsItem * const original, QGraphicsItem * const c
 {
 	mClonedItems[original] = cloned;
 	addItem(cloned);
+	mClonedItemsRects[cloned] = cloned->sceneBoundingRect();
+	dropTiles(mClonedItemsRects[cloned]);
 
 	// Interesting things happen here. Fake scene behaviours really strangely without this hack.
 	// Lines, ellipses and stylus is drawn correctly, but PARTIALLY until it moves the first time
@@ -58,17 +77,110 @@ void FakeScene::addClone(QGraphicsItem * const original, QGraphicsItem * const c
 		connect(orit, &graphicsUtils::AbstractItem::y1Changed, this, hack);
 		connect(orit, &graphicsUtils::AbstractItem::x2Changed, this, hack);
 		connect(orit, &graphicsUtils::AbstractItem::y2Changed, this, hack);
+
+		// Clone is synchronized with original by the same signals, connected earlier in clone().
+		const auto changed = [=]() { onCloneChanged(cloned); };
+		connect(orit, &graphicsUtils::AbstractItem::positionChanged, this, changed);
+		connect(orit, &graphicsUtils::AbstractItem::x1Changed, this, changed);
+		connect(orit, &graphicsUtils::AbstractItem::y1Changed, this, changed);
+		connect(orit, &graphicsUtils::AbstractItem::x2Changed, this, changed);
+		connect(orit, &graphicsUtils::AbstractItem::y2Changed, this, changed);
+		connect(orit, &graphicsUtils::AbstractItem::penChanged, this, changed);
+		connect(orit, &graphicsUtils::AbstractItem::brushChanged, this, changed);
+	}
+
+	// Image items share the picture with their clones, so a new picture changes the clone immediately.
+	if (items::ImageItem *image = dynamic_cast<items::ImageItem *>(original)) {
+		connect(image, &items::ImageItem::internalImageChanged, this, [=]() { onCloneChanged(cloned); });
 	}
 }
 
 void FakeScene::deleteItem(QGraphicsItem * const original)
 {
 	if (mClonedItems.contains(original)) {
-		delete mClonedItems[original];
+		QGraphicsItem * const cloned = mClonedItems[original];
+		dropTiles(mClonedItemsRects.take(cloned));
+		delete cloned;
 		mClonedItems.remove(original);
 	}
 }
 
+void FakeScene::onCloneChanged(QGraphicsItem * const cloned)
+{
+	const QRectF newRect = cloned->sceneBoundingRect();
+	dropTiles(mClonedItemsRects.value(cloned));
+	dropTiles(newRect);
+	mClonedItemsRects[cloned] = newRect;
+}
+
+void FakeScene::dropTiles(const QRectF &rect)
+{
+	if (rect.isNull() || mTiles.isEmpty()) {
+		return;
+	}
+
+	// Pens may paint a bit outside of the bounding rects, so the area is inflated by a pixel.
+	const int left = (qFloor(rect.left()) - 1) >> tileSizeLog;
+	const int right = (qCeil(rect.right()) + 1) >> tileSizeLog;
+	const int top = (qFloor(rect.top()) - 1) >> tileSizeLog;
+	const int bottom = (qCeil(rect.bottom()) + 1) >> tileSizeLog;
+	for (int x = left; x <= right; ++x) {
+		for (int y = top; y <= bottom; ++y) {
+			mTiles.remove(tileKey(x, y));
+		}
+	}
+}
+
+const QImage &FakeScene::tile(int x, int y)
+{
+	const quint64 key = tileKey(x, y);
+	auto cached = mTiles.constFind(key);
+	if (cached != mTiles.constEnd()) {
+		return *cached;
+	}
+
+	return *mTiles.insert(key, render(QRectF(x * tileSize, y * tileSize, tileSize, tileSize)));
+}
+
+QImage FakeScene::sample(const QPointF &center, qreal rotation, const QSize &size)
+{
+	QImage result(size, QImage::Format_RGB32);
+	if (result.isNull()) {
+		return result;
+	}
+
+	const qreal angle = qDegreesToRadians(rotation);
+	const qreal cos = qCos(angle);
+	const qreal sin = qSin(angle);
+	const qreal halfWidth = (size.width() - 1) / 2.0;
+	const qreal halfHeight = (size.height() - 1) / 2.0;
+
+	// Neighbouring pixels almost always come from the same tile, so the last one is remembered.
+	quint64 lastKey = 0;
+	const QImage *lastTile = nullptr;
+	for (int row = 0; row < size.height(); ++row) {
+		QRgb * const line = reinterpret_cast<QRgb *>(result.scanLine(row));
+		const qreal dy = row - halfHeight;
+		for (int column = 0; column < size.width(); ++column) {
+			const qreal dx = column - halfWidth;
+			const int x = qFloor(center.x() + dx * cos - dy * sin);
+			const int y = qFloor(center.y() + dx * sin + dy * cos);
+			const int tileX = x >> tileSizeLog;
+			const int tileY = y >> tileSizeLog;
+			const quint64 key = tileKey(tileX, tileY);
+			if (!lastTile || key != lastKey) {
+				lastTile = &tile(tileX, tileY);
+				lastKey = key;
+			}
+
+			const QRgb * const tileLine = reinterpret_cast<const QRgb *>(lastTile->constScanLine(y & (tileSize - 1)));
+			line[column] = tileLine[x & (tileSize - 1)];
+		}
+	}
+
+	return result;
+}
+
 QImage view::FakeScene::render(const QRectF &piece)
 {
 	QImage result(piece.size().toSize(), QImage::Format_RGB32);
@@ -15,6 +15,8 @@
 #pragma once
 
 #include <QtCore/QMap>
+#include <QtCore/QHash>
+#include <QtGui/QImage>
 #include <QtWidgets/QGraphicsScene>
 
 #include "twoDModel/engine/model/image.h"
@@ -28,6 +30,9 @@ class WorldModel;
 namespace view {
 
 /// A scene that maintains a copy of the visible world for rendering some pieces of that (for sensors, for example).
+/// Rendered floor is cached in square tiles, a tile is re-rendered only after some item over it has changed.
+/// Tiles are dropped synchronously by signals of original items, so a sensor never reads a stale tile even if
+/// the world changed in the same event loop iteration.
 class FakeScene : public QGraphicsScene
 {
 	Q_OBJECT
@@ -38,11 +43,27 @@ public:
 	/// Renders a given piece of the scene and returns resulting image.
 	QImage render(const QRectF &piece);
 
+	/// Samples cached floor into the image of the given \a size. The center of the image corresponds to
+	/// \a center point of the scene, image axes are rotated by \a rotation degrees clockwise relatively to
+	/// the scene ones.
+	QImage sample(const QPointF &center, qreal rotation, const QSize &size);
+
 private:
 	void addClone(QGraphicsItem * const original, QGraphicsItem * const cloned);
 	void deleteItem(QGraphicsItem * const original);
 
+	/// Drops cached tiles covering old and current positions of the \a cloned item.
+	void onCloneChanged(QGraphicsItem * const cloned);
+
+	/// Drops cached tiles intersecting with \a rect.
+	void dropTiles(const QRectF &rect);
+
+	/// Returns cached tile with the given indices, renders it if needed.
+	const QImage &tile(int x, int y);
+
 	QMap<QGraphicsItem *, QGraphicsItem *> mClonedItems;
+	QHash<QGraphicsItem *, QRectF> mClonedItemsRects;
+	QHash<quint64, QImage> mTiles;
 };
 
 }
@@ -199,9 +199,10 @@ void RobotItem::removeSensor(const kitBase::robotModel::PortInfo &port)
 		return;
 	}
 
+	// Subscribers may still need the sensor, so it is deleted only after the notification.
+	emit sensorRemoved(mSensors[port]);
 	scene()->removeItem(mSensors[port]);
 	delete mSensors[port];
-	emit sensorRemoved(mSensors[port]);
 	mSensors[port] = nullptr;
 }
 
@@ -0,0 +1,77 @@
+/* Copyright 2018 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "robotTraceItem.h"
+
+#include <QtGui/QPainter>
+#include <QtWidgets/QStyleOptionGraphicsItem>
+
+#include <qrutils/graphicsUtils/abstractItem.h>
+
+#include "src/engine/model/robotTrace.h"
+
+using namespace twoDModel::view;
+
+/// Bounding rect of the item grows by this margin, so the scene re-indexes the item only now and then.
+static const qreal boundingRectMargin = 128;
+
+RobotTraceItem::RobotTraceItem(const model::RobotTrace &trace)
+	: mTrace(trace)
+	, mBoundingRect(trace.boundingRect())
+{
+	// The trace is drawn over the background image but under all other items, like lines on the floor.
+	setZValue((graphicsUtils::AbstractItem::Background + graphicsUtils::AbstractItem::Picture) / 2.0);
+	setFlag(ItemUsesExtendedStyleOption);
+	setAcceptedMouseButtons(Qt::NoButton);
+}
+
+QRectF RobotTraceItem::boundingRect() const
+{
+	return mBoundingRect;
+}
+
+void RobotTraceItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
+{
+	Q_UNUSED(widget)
+
+	painter->save();
+	for (const model::RobotTrace::Polyline &polyline : mTrace.polylines()) {
+		painter->setPen(polyline.pen);
+		for (const model::RobotTrace::Chunk &chunk : polyline.chunks) {
+			if (model::RobotTrace::paintedRect(polyline.pen, chunk.bounds).intersects(option->exposedRect)) {
+				painter->drawPolyline(chunk.points.constData(), chunk.points.size());
+			}
+		}
+	}
+
+	painter->restore();
+}
+
+void RobotTraceItem::onTraceChanged(const QRectF &rect)
+{
+	const QRectF traceRect = mTrace.boundingRect();
+	if (traceRect.isEmpty()) {
+		// The trace was cleared, so the item shrinks.
+		if (!mBoundingRect.isEmpty()) {
+			prepareGeometryChange();
+			mBoundingRect = QRectF();
+		}
+	} else if (!mBoundingRect.contains(traceRect)) {
+		prepareGeometryChange();
+		mBoundingRect = traceRect.adjusted(-boundingRectMargin, -boundingRectMargin
+				, boundingRectMargin, boundingRectMargin);
+	}
+
+	update(rect);
+}
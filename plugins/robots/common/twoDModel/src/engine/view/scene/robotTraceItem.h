@@ -0,0 +1,45 @@
+/* Copyright 2018 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtWidgets/QGraphicsItem>
+
+namespace twoDModel {
+
+namespace model {
+class RobotTrace;
+}
+
+namespace view {
+
+/// Draws the whole robot trace stored in the world model as one scene item.
+class RobotTraceItem : public QGraphicsItem
+{
+public:
+	explicit RobotTraceItem(const model::RobotTrace &trace);
+
+	QRectF boundingRect() const override;
+	void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget = nullptr) override;
+
+	/// Schedules repainting of \a rect where the trace has changed.
+	void onTraceChanged(const QRectF &rect);
+
+private:
+	const model::RobotTrace &mTrace;
+	QRectF mBoundingRect;
+};
+
+}
+}
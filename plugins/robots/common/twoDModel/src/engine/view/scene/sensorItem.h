@@ -24,14 +24,14 @@
 
 #include <kitBase/robotModel/portInfo.h>
 
-#include "src/engine/items/solidItem.h"
+#include "src/engine/items/sensorSolidItem.h"
 #include "twoDModel/engine/model/sensorsConfiguration.h"
 
 namespace twoDModel {
 namespace view {
 
 /// Class that represents sensor in 2D model.
-class SensorItem : public graphicsUtils::RotateItem, public items::SolidItem
+class SensorItem : public graphicsUtils::RotateItem, public items::SensorSolidItem
 {
 	Q_OBJECT
 
@@ -51,11 +51,8 @@ public:
 	QDomElement serialize(QDomElement &parent) const override;
 	void deserialize(const QDomElement &element) override;
 
-	QPolygonF collidingPolygon() const override;
-	qreal mass() const override;
-	qreal friction() const override;
-	bool isCircle() const override;
-	BodyType bodyType() const override;
+	/// Returns the port this sensor is plugged into.
+	kitBase::robotModel::PortInfo port() const;
 
 protected:
 	class PortItem : public QGraphicsItem
@@ -39,6 +39,7 @@
 #include "twoDModel/engine/model/image.h"
 #include "src/engine/view/scene/sensorItem.h"
 #include "src/engine/view/scene/rangeSensorItem.h"
+#include "src/engine/view/scene/robotTraceItem.h"
 #include "src/engine/items/wallItem.h"
 #include "src/engine/items/skittleItem.h"
 #include "src/engine/items/ballItem.h"
@@ -82,8 +83,13 @@ TwoDModelScene::TwoDModelScene(model::Model &model
 	connect(&mModel.worldModel(), &model::WorldModel::imageItemAdded, this, &TwoDModelScene::onImageItemAdded);
 	connect(&mModel.worldModel(), &model::WorldModel::regionItemAdded
 			, this, [=](items::RegionItem *item) { addItem(item); });
-	connect(&mModel.worldModel(), &model::WorldModel::traceItemAdded
-			, this, [=](QGraphicsLineItem *item) { addItem(item); });
+
+	RobotTraceItem * const trace = new RobotTraceItem(mModel.worldModel().trace());
+	addItem(trace);
+	connect(&mModel.worldModel(), &model::WorldModel::robotTraceChanged, this, [=](const QRectF &rect) {
+		trace->onTraceChanged(rect);
+	});
+
 	connect(&mModel.worldModel(), &model::WorldModel::itemRemoved, this, &TwoDModelScene::onItemRemoved);
 
 	connect(&mModel.worldModel(), &model::WorldModel::backgroundImageItemAdded
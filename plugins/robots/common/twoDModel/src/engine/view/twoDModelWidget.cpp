@@ -114,6 +114,7 @@ TwoDModelWidget::TwoDModelWidget(Model &model, QWidget *parent)
 	});
 	connect(&mModel.timeline(), &Timeline::started, this, [this]() { bringToFront(); mUi->timelineBox->setValue(0); });
 	connect(&mModel.timeline(), &Timeline::tick, this, &TwoDModelWidget::incrementTimelineCounter);
+	connect(&mModel.timeline(), &Timeline::idleTick, this, &TwoDModelWidget::incrementTimelineCounter);
 	connect(&mModel.timeline(), &Timeline::started, this, &TwoDModelWidget::setRunStopButtonsVisibility);
 	connect(&mModel.timeline(), &Timeline::stopped, this, &TwoDModelWidget::setRunStopButtonsVisibility);
 	connect(&mModel.timeline(), &Timeline::speedFactorChanged, this, [=](int value) {
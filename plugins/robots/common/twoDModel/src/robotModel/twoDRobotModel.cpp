@@ -114,6 +114,11 @@ void TwoDRobotModel::setEngine(engine::TwoDModelEngineInterface &engine)
 	mEngine = &engine;
 }
 
+void TwoDRobotModel::resetEngine()
+{
+	mEngine = nullptr;
+}
+
 QPolygonF TwoDRobotModel::collidingPolygon() const
 {
 	return QPolygonF(QRectF({0, 0}, size()));
@@ -45,6 +45,7 @@ HEADERS += \
 	$$PWD/include/twoDModel/engine/model/sensorsConfiguration.h \
 	$$PWD/include/twoDModel/engine/model/settings.h \
 	$$PWD/include/twoDModel/engine/model/image.h \
+	$$PWD/include/twoDModel/engine/model/pixelStatistics.h \
 	$$PWD/include/twoDModel/robotModel/twoDRobotModel.h \
 	$$PWD/include/twoDModel/robotModel/parts/button.h \
 	$$PWD/include/twoDModel/robotModel/parts/colorSensorBlue.h \
@@ -69,6 +70,7 @@ HEADERS += \
 	$$PWD/src/engine/view/nullTwoDModelDisplayWidget.h \
 	$$PWD/src/engine/view/scene/twoDModelScene.h \
 	$$PWD/src/engine/view/scene/fakeScene.h \
+	$$PWD/src/engine/view/scene/robotTraceItem.h \
 	$$PWD/src/engine/view/scene/robotItem.h \
 	$$PWD/src/engine/view/scene/sensorItem.h \
 	$$PWD/src/engine/view/scene/rangeSensorItem.h \
@@ -89,11 +91,16 @@ HEADERS += \
 	$$PWD/src/engine/constraints/details/triggersFactory.h \
 	$$PWD/src/engine/constraints/details/valuesFactory.h \
 	$$PWD/src/engine/model/modelTimer.h \
+	$$PWD/src/engine/model/wallsIndex.h \
+	$$PWD/src/engine/model/sectorCaster.h \
+	$$PWD/src/engine/model/markerTracer.h \
+	$$PWD/src/engine/model/robotTrace.h \
 	$$PWD/src/engine/model/physics/physicsEngineBase.h \
 	$$PWD/src/engine/model/physics/simplePhysicsEngine.h \
 	$$PWD/src/engine/model/physics/parts/box2DRobot.h \
 	$$PWD/src/engine/model/physics/parts/box2DWheel.h \
 	$$PWD/src/engine/items/solidItem.h \
+	$$PWD/src/engine/items/sensorSolidItem.h \
 	$$PWD/src/engine/items/wallItem.h \
 	$$PWD/src/engine/items/stylusItem.h \
 	$$PWD/src/engine/items/lineItem.h \
@@ -135,6 +142,7 @@ SOURCES += \
 	$$PWD/src/engine/view/nullTwoDModelDisplayWidget.cpp \
 	$$PWD/src/engine/view/scene/twoDModelScene.cpp \
 	$$PWD/src/engine/view/scene/fakeScene.cpp \
+	$$PWD/src/engine/view/scene/robotTraceItem.cpp \
 	$$PWD/src/engine/view/scene/robotItem.cpp \
 	$$PWD/src/engine/view/scene/sensorItem.cpp \
 	$$PWD/src/engine/view/scene/rangeSensorItem.cpp \
@@ -151,15 +159,21 @@ SOURCES += \
 	$$PWD/src/engine/model/settings.cpp \
 	$$PWD/src/engine/model/robotModel.cpp \
 	$$PWD/src/engine/model/modelTimer.cpp \
+	$$PWD/src/engine/model/wallsIndex.cpp \
+	$$PWD/src/engine/model/sectorCaster.cpp \
+	$$PWD/src/engine/model/markerTracer.cpp \
+	$$PWD/src/engine/model/robotTrace.cpp \
 	$$PWD/src/engine/model/sensorsConfiguration.cpp \
 	$$PWD/src/engine/model/worldModel.cpp \
 	$$PWD/src/engine/model/timeline.cpp \
 	$$PWD/src/engine/model/image.cpp \
+	$$PWD/src/engine/model/pixelStatistics.cpp \
 	$$PWD/src/engine/model/physics/physicsEngineBase.cpp \
 	$$PWD/src/engine/model/physics/simplePhysicsEngine.cpp \
 	$$PWD/src/engine/model/physics/parts/box2DRobot.cpp \
 	$$PWD/src/engine/model/physics/parts/box2DWheel.cpp \
 	$$PWD/src/engine/items/solidItem.cpp \
+	$$PWD/src/engine/items/sensorSolidItem.cpp \
 	$$PWD/src/engine/items/wallItem.cpp \
 	$$PWD/src/engine/items/stylusItem.cpp \
 	$$PWD/src/engine/items/lineItem.cpp \
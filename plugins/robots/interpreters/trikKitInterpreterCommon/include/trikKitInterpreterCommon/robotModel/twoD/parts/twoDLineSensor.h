@@ -41,8 +41,6 @@ public:
 	void read() override;
 
 private:
-	bool closeEnough(QRgb color) const;
-
 	twoDModel::engine::TwoDModelEngineInterface &mEngine;
 	QRgb mLineColor;
 };
@@ -106,6 +106,12 @@ public slots:
 	utils::AbstractTimer *timer(int milliseconds);
 	void processSensors(bool isRunnig = true);
 
+	/// Tells 2D model timeline that a script thread is being started, so model time does not run ahead of it.
+	void expectScriptThread();
+
+	/// Tells 2D model timeline that the script is over and its threads shall not be expected anymore.
+	void forgetScriptThreads();
+
 signals:
 	void error(const QString &msg);
 	void warning(const QString &msg);
@@ -16,6 +16,8 @@
 
 #include <QtGui/QImage>
 
+#include <twoDModel/engine/model/pixelStatistics.h>
+
 using namespace trik::robotModel::twoD::parts;
 using namespace kitBase::robotModel;
 
@@ -37,27 +39,8 @@ void LineSensor::init()
 void LineSensor::detectLine()
 {
 	const QImage image = mEngine.areaUnderSensor(port(), 0.2);
-
-	int size = 0;
-	int red = 0;
-	int green = 0;
-	int blue = 0;
-	for (int x = 0; x < image.width(); ++x) {
-		for (int y = 0; y < image.height(); ++y) {
-			const QRgb pixelColor = image.pixel(x, y);
-			if (qAlpha(pixelColor) > 0) {
-				++size;
-				red += qRed(pixelColor);
-				green += qGreen(pixelColor);
-				blue += qBlue(pixelColor);
-			}
-		}
-	}
-	if (size == 0) {
-		mLineColor = qRgb(255, 255, 255);
-	} else {
-		mLineColor = qRgb(red / size, green / size, blue / size);
-	}
+	mLineColor = twoDModel::model::PixelStatistics::averageColor(reinterpret_cast<const QRgb *>(image.constBits())
+			, image.width() * image.height());
 }
 
 void LineSensor::read()
@@ -77,15 +60,10 @@ void LineSensor::read()
 	int horizontalLineWidth = image.height() * 0.2;
 	qreal xCoordinates = 0;
 	for (int i = 0; i < height; ++i) {
-		int blacksInRow = 0;
-		qreal xSum = 0;
-
-		for (int j = 0; j < width; ++j) {
-			if (closeEnough(image.pixel(j, i))) {
-				++blacksInRow;
-				xSum += j - width / 2.0;
-			}
-		}
+		qint64 indicesSum = 0;
+		const int blacksInRow = twoDModel::model::PixelStatistics::closeColorsCount(
+				reinterpret_cast<const QRgb *>(image.constScanLine(i)), width, mLineColor, tolerance, indicesSum);
+		const qreal xSum = indicesSum - blacksInRow * width / 2.0;
 
 		xCoordinates += (blacksInRow ? xSum * 100 / (width / 2.0) / blacksInRow : 0);
 		blacks += blacksInRow;
@@ -101,10 +79,3 @@ void LineSensor::read()
 	QVector<int> v = { x, cross, lineWidth };
 	setLastData(v);
 }
-
-bool LineSensor::closeEnough(QRgb color) const
-{
-	return qAlpha(color) > 0 && qMax(qAbs(qRed(color) - qRed(mLineColor))
-		, qMax(qAbs(qGreen(color) - qGreen(mLineColor))
-		, qAbs(qBlue(color) - qBlue(mLineColor)))) < tolerance;
-}
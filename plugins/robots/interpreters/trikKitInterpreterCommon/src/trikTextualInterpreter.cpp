@@ -106,6 +106,7 @@ void trik::TrikTextualInterpreter::interpretScript(const QString &script, const
 {
 	mRunning = true;
 	mBrick.processSensors(true);
+	mBrick.expectScriptThread();
 	if (languageExtension.contains("js")) {
 	mScriptRunner.run(jsOverrides + script);
 	} else if (languageExtension.contains("py")) {
@@ -117,6 +118,7 @@ void trik::TrikTextualInterpreter::interpretScript(const QString &script, const
 	updatedScript.insert(indexOf + 1, pyOverrides);
 	mScriptRunner.run(updatedScript, "dummyFile.py");
 	} else {
+	mBrick.forgetScriptThreads();
 	reportError(tr("Unsupported script file type"));
 	}
 }
@@ -128,6 +130,7 @@ void trik::TrikTextualInterpreter::interpretScriptExercise(const QString &script
 	mRunning = true;
 	mBrick.processSensors(true);
 	mBrick.setCurrentInputs(inputs);
+	mBrick.expectScriptThread();
 	QString newScript = jsOverrides + "script.writeToFile = null;\n" + script;
 	mScriptRunner.run(newScript);
 }
@@ -140,6 +143,7 @@ void trik::TrikTextualInterpreter::abort()
 	QMetaObject::invokeMethod(&mScriptRunner, "abort", Qt::QueuedConnection); // just a wild test
 	mRunning = false; // reset brick?
 	mBrick.processSensors(false);
+	mBrick.forgetScriptThreads();
 }
 
 void trik::TrikTextualInterpreter::init()
@@ -252,6 +256,7 @@ void trik::TrikTextualInterpreter::scriptFinished(const QString &error, int scri
 	if (mRunning) { /// @todo: figure out better place for this check - it should avoid double aborts
 	mRunning = false;
 	mBrick.processSensors(false);
+	mBrick.forgetScriptThreads();
 	emit completed();
 	}
 }
@@ -391,8 +391,11 @@ void TrikBrick::wait(int milliseconds)
 	connect(timeline, &twoDModel::model::Timeline::stopped, &loop, &QEventLoop::quit);
 
 	if (timeline->isStarted()) {
+		// Timeline may skip ticks while this thread waits.
+		timeline->beginWaiting(t);
 		t->start(milliseconds);
 		loop.exec();
+		timeline->endWaiting();
 	}
 }
 
@@ -439,3 +442,17 @@ void TrikBrick::processSensors(bool isRunnig)
 	QMetaObject::invokeMethod(mSensorUpdater.data(), isRunnig ? "start" : "stop");
 }
 
+void TrikBrick::expectScriptThread()
+{
+	if (auto timeline = dynamic_cast<twoDModel::model::Timeline *>(&mTwoDRobotModel->timeline())) {
+		timeline->expectThread();
+	}
+}
+
+void TrikBrick::forgetScriptThreads()
+{
+	if (auto timeline = dynamic_cast<twoDModel::model::Timeline *>(&mTwoDRobotModel->timeline())) {
+		timeline->forgetExpectedThreads();
+	}
+}
+
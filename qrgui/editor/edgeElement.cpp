@@ -1001,7 +1001,7 @@ QVariant EdgeElement::itemChange(GraphicsItemChange change, const QVariant &valu
 			updateLongestPart();
 			return value;
 		default:
-			return QGraphicsItem::itemChange(change, value);
+			return Element::itemChange(change, value);
 	}
 }
 
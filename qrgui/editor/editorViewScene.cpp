@@ -132,21 +132,22 @@ void EditorViewScene::clearScene()
 
 Element *EditorViewScene::getElem(const Id &id) const
 {
-	if (id == Id::rootId()) {
-		return nullptr;
-	}
+	return mElements.value(id);
+}
 
-	// FIXME: SLOW!
-	QList < QGraphicsItem *> list = items();
-	for (QList < QGraphicsItem *>::Iterator it = list.begin(); it != list.end(); it++) {
-		if (Element *elem = dynamic_cast < Element *>(*it)) {
-			if (elem->id() == id) {
-				return elem;
-			}
-		}
+void EditorViewScene::registerElement(Element *element)
+{
+	mElements[element->id()] = element;
+}
+
+void EditorViewScene::unregisterElement(Element *element)
+{
+	const auto it = mElements.find(element->id());
+	if (it != mElements.end() && it.value() == element) {
+		mElements.erase(it);
 	}
 
-	return nullptr;
+	mHighlightedElements.remove(element);
 }
 
 void EditorViewScene::dragEnterEvent(QGraphicsSceneDragDropEvent *event)
@@ -271,12 +272,7 @@ void EditorViewScene::dropEvent(QGraphicsSceneDragDropEvent *event)
 
 bool EditorViewScene::canBeContainedBy(const Id &container, const Id &candidate) const
 {
-	bool allowed = false;
-	for (const Id &type : mEditorManager.containedTypes(container.type())) {
-		allowed = allowed || mEditorManager.isParentOf(candidate, type);
-	}
-
-	return allowed;
+	return mEditorManager.canBeContainedBy(container.type(), candidate);
 }
 
 int EditorViewScene::launchEdgeMenu(EdgeElement *edge, NodeElement *node
@@ -587,26 +583,12 @@ void EditorViewScene::arrangeNodeLinks(NodeElement* node) const
 
 NodeElement* EditorViewScene::getNodeById(const Id &itemId) const
 {
-	for (QGraphicsItem *item : items()) {
-		NodeElement *node = dynamic_cast<NodeElement*>(item);
-		if (node && node->id() == itemId) {
-			return node;
-		}
-	}
-
-	return nullptr;
+	return dynamic_cast<NodeElement *>(mElements.value(itemId));
 }
 
 EdgeElement* EditorViewScene::getEdgeById(const Id &itemId) const
 {
-	for (QGraphicsItem *item : items()) {
-		EdgeElement *edge = dynamic_cast<EdgeElement*>(item);
-		if (edge && edge->id() == itemId) {
-			return edge;
-		}
-	}
-
-	return nullptr;
+	return dynamic_cast<EdgeElement *>(mElements.value(itemId));
 }
 
 QList<NodeElement*> EditorViewScene::getCloseNodes(NodeElement *node) const
@@ -1369,9 +1351,9 @@ void EditorViewScene::dehighlight(const Id &graphicalId)
 
 void EditorViewScene::dehighlight()
 {
+	// Elements removed from scene are forgotten by unregisterElement(), so all of them are still on scene.
 	for (Element *element : mHighlightedElements) {
-		if (items().contains(element))
-			element->setGraphicsEffect(nullptr);
+		element->setGraphicsEffect(nullptr);
 	}
 
 	mHighlightedElements.clear();
@@ -219,6 +219,14 @@ private slots:
 	void updateActions();
 
 private:
+	friend class Element;
+
+	/// Adds element to the index of elements on this scene. Called by Element when it is added to scene.
+	void registerElement(Element *element);
+
+	/// Removes element from the index of elements on this scene. Called by Element when it leaves scene or dies.
+	void unregisterElement(Element *element);
+
 	void deleteElements(const IdList &idsToDelete);
 
 	void getLinkByGesture(const NodeElement &from, const NodeElement &to);
@@ -278,6 +286,10 @@ private:
 	QSignalMapper *mActionSignalMapper;
 
 	QSet<Element *> mHighlightedElements;
+
+	/// Elements on scene by their ids, including elements nested into other elements.
+	QHash<Id, Element *> mElements;
+
 	QTimer *mTimer;
 
 	/** @brief timer for update moved elements without lags */
@@ -23,6 +23,7 @@
 #include <qrgui/models/commands/changePropertyCommand.h>
 
 #include "qrgui/editor/labels/label.h"
+#include "qrgui/editor/editorViewScene.h"
 
 using namespace qReal;
 using namespace qReal::gui::editor;
@@ -50,6 +51,14 @@ Element::Element(const ElementType &elementType, const Id &id, const models::Mod
 	SettingsListener::listen("hideNonHardLabels", this, &Element::setHideNonHardLabels);
 }
 
+Element::~Element()
+{
+	// QGraphicsItem removes itself from scene without notifications, so the index must be updated here.
+	if (EditorViewScene * const editorScene = dynamic_cast<EditorViewScene *>(scene())) {
+		editorScene->unregisterElement(this);
+	}
+}
+
 Id Element::id() const
 {
 	return mId;
@@ -196,3 +205,18 @@ void Element::keyPressEvent(QKeyEvent *event)
 
 	QGraphicsItem::keyPressEvent(event);
 }
+
+QVariant Element::itemChange(GraphicsItemChange change, const QVariant &value)
+{
+	if (change == ItemSceneChange) {
+		if (EditorViewScene * const oldScene = dynamic_cast<EditorViewScene *>(scene())) {
+			oldScene->unregisterElement(this);
+		}
+
+		if (EditorViewScene * const newScene = dynamic_cast<EditorViewScene *>(value.value<QGraphicsScene *>())) {
+			newScene->registerElement(this);
+		}
+	}
+
+	return QGraphicsItem::itemChange(change, value);
+}
@@ -51,7 +51,7 @@ public:
 	/// @param type - reference to type descriptor of the element. Takes ownership.
 	Element(const ElementType &type, const Id &id, const models::Models &models);
 
-	virtual ~Element() override = default;
+	~Element() override;
 
 	void initEmbeddedControls();
 
@@ -90,6 +90,9 @@ protected:
 
 	void keyPressEvent(QKeyEvent *event) override;
 
+	/// Keeps the index of elements in EditorViewScene up to date when element is added to or removed from scene.
+	QVariant itemChange(GraphicsItemChange change, const QVariant &value) override;
+
 	bool mMoving;
 	bool mEnabled;
 	const Id mId;
@@ -842,7 +842,7 @@ QVariant NodeElement::itemChange(GraphicsItemChange change, const QVariant &valu
 	}
 
 	default:
-		return QGraphicsItem::itemChange(change, value);
+		return Element::itemChange(change, value);
 	}
 }
 
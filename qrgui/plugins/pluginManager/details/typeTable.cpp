@@ -0,0 +1,132 @@
+/* Copyright 2018 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "typeTable.h"
+
+#include <qrgraph/queries.h>
+#include <metaMetaModel/metamodel.h>
+#include <metaMetaModel/nodeElementType.h>
+
+using namespace qReal;
+
+TypeTable::TypeTable(const QList<Metamodel *> &metamodels)
+{
+	QHash<const qrgraph::Node *, int> nodeIndexes;
+	for (const Metamodel * const metamodel : metamodels) {
+		for (qrgraph::Node * const node : metamodel->vertices()) {
+			if (ElementType * const type = dynamic_cast<ElementType *>(node)) {
+				nodeIndexes[type] = mTypes.size();
+				mIndexes[type->typeId()] = mTypes.size();
+				mTypes << type;
+			}
+		}
+	}
+
+	const int count = mTypes.size();
+	mListed = QBitArray(count);
+	for (const Metamodel * const metamodel : metamodels) {
+		for (const QString &diagram : metamodel->diagrams()) {
+			for (const ElementType * const type : metamodel->elements(diagram)) {
+				mListed.setBit(nodeIndexes[type]);
+				if (!mTypesByName.contains(type->name())) {
+					mTypesByName[type->name()] = Id(metamodel->id(), diagram, type->name());
+				}
+			}
+		}
+	}
+
+	mAncestors.resize(count);
+	mContainedTypes.resize(count);
+	mPortTypes.resize(count);
+	for (int i = 0; i < count; ++i) {
+		QBitArray &ancestors = mAncestors[i];
+		ancestors.resize(count);
+		qrgraph::Queries::treeLift(*mTypes[i], [&](const qrgraph::Node &parent) {
+			const int parentIndex = nodeIndexes.value(&parent, -1);
+			if (parentIndex >= 0) {
+				ancestors.setBit(parentIndex);
+			}
+
+			return false;
+		}, ElementType::generalizationLinkType);
+
+		mContainedTypes[i] = mTypes[i]->containedTypes();
+		if (const NodeElementType * const node = dynamic_cast<const NodeElementType *>(mTypes[i])) {
+			mPortTypes[i] = node->portTypes();
+		}
+	}
+
+	mContainment.resize(count);
+	for (int i = 0; i < count; ++i) {
+		QBitArray &containment = mContainment[i];
+		containment.resize(count);
+		for (const Id &containedType : mContainedTypes[i]) {
+			const int contained = index(containedType);
+			if (contained < 0) {
+				continue;
+			}
+
+			for (int candidate = 0; candidate < count; ++candidate) {
+				if (mAncestors[candidate].testBit(contained)) {
+					containment.setBit(candidate);
+				}
+			}
+		}
+	}
+}
+
+int TypeTable::index(const Id &id) const
+{
+	const int size = id.idSize();
+	if (size < 3) {
+		return -1;
+	}
+
+	return mIndexes.value(size == 3 ? id : id.type(), -1);
+}
+
+ElementType &TypeTable::type(int index) const
+{
+	return *mTypes[index];
+}
+
+bool TypeTable::isListed(int index) const
+{
+	return mListed.testBit(index);
+}
+
+bool TypeTable::isParent(int child, int parent) const
+{
+	return mAncestors[child].testBit(parent);
+}
+
+bool TypeTable::canBeContainedBy(int container, int candidate) const
+{
+	return mContainment[container].testBit(candidate);
+}
+
+const IdList &TypeTable::containedTypes(int index) const
+{
+	return mContainedTypes[index];
+}
+
+const QStringList &TypeTable::portTypes(int index) const
+{
+	return mPortTypes[index];
+}
+
+Id TypeTable::findByName(const QString &name) const
+{
+	return mTypesByName.value(name);
+}
@@ -0,0 +1,83 @@
+/* Copyright 2018 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QBitArray>
+#include <QtCore/QHash>
+#include <QtCore/QVector>
+
+#include <qrkernel/ids.h>
+
+namespace qReal {
+
+class ElementType;
+class Metamodel;
+
+/// Integer-keyed tables of element types of loaded metamodels. Each type gets a number, inheritance and containment
+/// relations are precomputed into bit sets, so hot queries of EditorManager (type by id, "is parent of",
+/// "can be contained by") cost one hash lookup and a bit test instead of metamodel graph traversals.
+/// Tables must be rebuilt each time a metamodel is loaded, unloaded or modified.
+class TypeTable
+{
+public:
+	TypeTable() = default;
+
+	/// Builds tables for all element types of given metamodels.
+	explicit TypeTable(const QList<Metamodel *> &metamodels);
+
+	/// Returns number of element type with editor, diagram and element parts of \a id, or -1 if there is no such type.
+	int index(const Id &id) const;
+
+	/// Returns element type with given number.
+	ElementType &type(int index) const;
+
+	/// Returns true if element type is listed in elements of one of diagrams of its metamodel.
+	bool isListed(int index) const;
+
+	/// Returns true if \a child is \a parent or inherits it.
+	bool isParent(int child, int parent) const;
+
+	/// Returns true if elements of \a candidate type can be placed into elements of \a container type, i.e. if
+	/// \a candidate is a descendant of one of types contained by \a container. Both types shall belong to the
+	/// same metamodel.
+	bool canBeContainedBy(int container, int candidate) const;
+
+	/// Returns cached ElementType::containedTypes() of given type.
+	const IdList &containedTypes(int index) const;
+
+	/// Returns cached port types of given type, empty list for non-node types.
+	const QStringList &portTypes(int index) const;
+
+	/// Returns id of the first type with given name in order of editors, their diagrams and diagram elements,
+	/// or empty id if there is no such type.
+	Id findByName(const QString &name) const;
+
+private:
+	QHash<Id, int> mIndexes;
+	QVector<ElementType *> mTypes;
+	QBitArray mListed;
+
+	/// Bit i of mAncestors[j] is set if type j is type i or inherits it.
+	QVector<QBitArray> mAncestors;
+
+	/// Bit i of mContainment[j] is set if elements of type i can be placed into elements of type j.
+	QVector<QBitArray> mContainment;
+
+	QVector<IdList> mContainedTypes;
+	QVector<QStringList> mPortTypes;
+	QHash<QString, Id> mTypesByName;
+};
+
+}
@@ -102,6 +102,7 @@ bool EditorManager::registerPlugin(MetamodelLoaderInterface * const loader)
 	loader->load(*metamodel);
 	mPluginFileNames[metamodel->id()] << pluginName;
 	mMetamodels[metamodel->id()] = metamodel;
+	updateTypeTable();
 	return true;
 }
 
@@ -130,6 +131,7 @@ QString EditorManager::unloadPlugin(const QString &metamodelName)
 	if (mMetamodels.keys().contains(metamodelName)) {
 		mMetamodels.remove(metamodelName);
 		mPluginFileNames.remove(metamodelName);
+		updateTypeTable();
 
 		if (!resultOfUnloading.isEmpty()) {
 			QLOG_WARN() << "Editor plugin" << metamodelName << "unloading failed: " + resultOfUnloading;
@@ -158,6 +160,12 @@ void EditorManager::loadMetamodel(Metamodel &metamodel)
 	}
 
 	mMetamodels[metamodel.id()] = &metamodel;
+	updateTypeTable();
+}
+
+void EditorManager::updateTypeTable() const
+{
+	mTypeTable = TypeTable(mMetamodels.values());
 }
 
 IdList EditorManager::editors() const
@@ -328,6 +336,12 @@ QSize EditorManager::iconSize(const Id &id) const
 
 ElementType &EditorManager::elementType(const Id &id) const
 {
+	const int index = mTypeTable.index(id);
+	if (index >= 0) {
+		return mTypeTable.type(index);
+	}
+
+	// Unknown types are left to metamodel, it reports them.
 	Q_ASSERT(mMetamodels.contains(id.editor()));
 	return mMetamodels[id.editor()]->elementType(id.diagram(), id.element());
 }
@@ -341,6 +355,11 @@ const QStringList &EditorManager::propertyNames(const Id &id) const
 QStringList EditorManager::portTypes(const Id &id) const
 {
 	Q_ASSERT(id.idSize() == 3); // Applicable only to element types
+	const int index = mTypeTable.index(id);
+	if (index >= 0) {
+		return mTypeTable.portTypes(index);
+	}
+
 	const NodeElementType *nodeType = dynamic_cast<const NodeElementType *>(&elementType(id));
 	return nodeType ? nodeType->portTypes() : QStringList();
 }
@@ -354,7 +373,8 @@ QStringList EditorManager::referenceProperties(const Id &id) const
 IdList EditorManager::containedTypes(const Id &id) const
 {
 	Q_ASSERT(id.idSize() == 3);  // Applicable only to element types
-	return elementType(id).containedTypes();
+	const int index = mTypeTable.index(id);
+	return index >= 0 ? mTypeTable.containedTypes(index) : elementType(id).containedTypes();
 }
 
 bool EditorManager::isEnumEditable(const Id &id, const QString &name) const
@@ -386,30 +406,17 @@ QString EditorManager::defaultPropertyValue(const Id &id, QString name) const
 bool EditorManager::hasElement(const Id &elementId) const
 {
 	Q_ASSERT(elementId.idSize() == 3);
-	if (!mMetamodels.contains(elementId.editor()))
-		return false;
-	Metamodel *editor = mMetamodels[elementId.editor()];
-	for (const QString &diagram : editor->diagrams()) {
-		for (const ElementType *element : editor->elements(diagram)) {
-			if (elementId.diagram() == diagram && elementId.element() == element->name()) {
-				return true;
-			}
-		}
-	}
-	return false;
+	const int index = mTypeTable.index(elementId);
+	return index >= 0 && mTypeTable.isListed(index);
 }
 
 Id EditorManager::findElementByType(const QString &type) const
 {
-	for (Metamodel *editor : mMetamodels.values()) {
-		for (const QString &diagram : editor->diagrams()) {
-			for (const ElementType *element : editor->elements(diagram)) {
-				if (type == element->name()) {
-					return Id(editor->id(), diagram, element->name());
-				}
-			}
-		}
+	const Id result = mTypeTable.findByName(type);
+	if (!result.isNull()) {
+		return result;
 	}
+
 	throw Exception("No type " + type + " in loaded plugins");
 }
 
@@ -438,9 +445,33 @@ bool EditorManager::isParentOf(const Id &child, const Id &parent) const // child
 		parentElement = parent.editor();
 	}
 
+	// Parent type is searched in child's metamodel.
+	const int childIndex = mTypeTable.index(child);
+	const int parentIndex = mTypeTable.index(Id(child.editor(), parentDiagram, parentElement));
+	if (childIndex >= 0 && parentIndex >= 0) {
+		return mTypeTable.isParent(childIndex, parentIndex);
+	}
+
 	return isParentOf(plugin, child.diagram(), child.element(), parentDiagram, parentElement);
 }
 
+bool EditorManager::canBeContainedBy(const Id &container, const Id &candidate) const
+{
+	const int containerIndex = mTypeTable.index(container);
+	const int candidateIndex = mTypeTable.index(candidate);
+	if (containerIndex >= 0 && candidateIndex >= 0 && container.editor() == candidate.editor()) {
+		return mTypeTable.canBeContainedBy(containerIndex, candidateIndex);
+	}
+
+	for (const Id &type : containedTypes(container.type())) {
+		if (isParentOf(candidate, type)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
 bool EditorManager::isParentOf(const Metamodel *plugin, const QString &childDiagram
 		, const QString &child, const QString &parentDiagram, const QString &parent) const
 {
@@ -455,12 +486,14 @@ QStringList EditorManager::allChildrenTypesOf(const Id &parent) const
 	}
 
 	QStringList result;
-
+	const int parentIndex = mTypeTable.index(parent);
 	for (const Id &id : elements(parent)) {
-		if (isParentOf(id, parent)) {
+		const int index = parentIndex >= 0 ? mTypeTable.index(id) : -1;
+		if (index >= 0 ? mTypeTable.isParent(index, parentIndex) : isParentOf(id, parent)) {
 			result << id.element();
 		}
 	}
+
 	return result;
 }
 
@@ -509,8 +542,14 @@ int EditorManager::isNodeOrEdge(const Id &id) const
 bool EditorManager::isParentOf(const QString &editor, const QString &parentDiagram, const QString &parentElement
 		, const QString &childDiagram, const QString &childElement) const
 {
-	Id child(editor, childDiagram, childElement);
-	Id parent(editor, parentDiagram, parentElement);
+	const Id child(editor, childDiagram, childElement);
+	const Id parent(editor, parentDiagram, parentElement);
+	const int childIndex = mTypeTable.index(child);
+	const int parentIndex = mTypeTable.index(parent);
+	if (childIndex >= 0 && parentIndex >= 0) {
+		return mTypeTable.isParent(childIndex, parentIndex);
+	}
+
 	return elementType(child).isParent(elementType(parent));
 }
 
@@ -657,6 +696,7 @@ void EditorManager::addNodeElement(const Id &diagram, const QString &name, const
 	ElementType &abstractNode = metamodel->elementType(diagram.diagram(), "AbstractNode");
 	metamodel->produceEdge(*node, abstractNode, ElementType::generalizationLinkType);
 	metamodel->produceEdge(*node, abstractNode, ElementType::containmentLinkType);
+	updateTypeTable();
 }
 
 void EditorManager::addEdgeElement(const Id &diagram, const QString &name, const QString &displayedName
@@ -690,6 +730,7 @@ void EditorManager::addEdgeElement(const Id &diagram, const QString &name, const
 
 	edge->addLabel(label);
 	metamodel->addElement(*edge);
+	updateTypeTable();
 
 	/// @todo: beginType and endType are currently not supported.
 	/// They should be supported when drawing code generated by qrxc will be moved to engine.
@@ -28,6 +28,7 @@
 #include "qrgui/plugins/pluginManager/editorManagerInterface.h"
 #include "qrgui/plugins/pluginManager/pattern.h"
 #include "qrgui/plugins/pluginManager/details/patternParser.h"
+#include "qrgui/plugins/pluginManager/details/typeTable.h"
 
 #include "pluginsManagerDeclSpec.h"
 
@@ -98,6 +99,7 @@ public:
 	bool isDiagramNode(const Id &id) const override;
 
 	bool isParentOf(const Id &child, const Id &parent) const override;
+	bool canBeContainedBy(const Id &container, const Id &candidate) const override;
 	bool isGraphicalElementNode(const Id &id) const override;
 
 	/// Returns diagram id if only one diagram loaded or Id() otherwise
@@ -154,6 +156,9 @@ private:
 	void init();
 	bool registerPlugin(MetamodelLoaderInterface * const loader);
 
+	/// Rebuilds type tables, shall be called each time when metamodels are loaded, unloaded or modified.
+	void updateTypeTable() const;
+
 	bool isParentOf(const Metamodel *plugin, const QString &childDiagram, const QString &child
 			, const QString &parentDiagram, const QString &parent) const;
 
@@ -161,6 +166,9 @@ private:
 	QMap<QString, Pattern> mGroups;
 	QMap<QString, Metamodel *> mMetamodels;
 
+	/// Precomputed types info of all loaded metamodels. Mutable since metamodels can be modified by const methods.
+	mutable TypeTable mTypeTable;
+
 	QDir mPluginsDir;
 
 	/// Common part of plugin loaders
@@ -98,6 +98,10 @@ public:
 	virtual bool isDiagramNode(const Id &id) const = 0;
 
 	virtual bool isParentOf(const Id &child, const Id &parent) const = 0;
+
+	/// Returns true if elements of \a candidate type can be placed into elements of \a container type.
+	virtual bool canBeContainedBy(const Id &container, const Id &candidate) const = 0;
+
 	virtual bool isGraphicalElementNode(const Id &id) const = 0;
 
 	/// Returns diagram id if only one diagram loaded or Id() otherwise
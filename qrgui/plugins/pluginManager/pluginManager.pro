@@ -40,6 +40,7 @@ HEADERS += \
 	$$PWD/qrsMetamodelLoader.h \
 	$$PWD/qrsMetamodelSaver.h \
 	$$PWD/details/patternParser.h \
+	$$PWD/details/typeTable.h \
 
 SOURCES += \
 	$$PWD/editorManager.cpp \
@@ -49,6 +50,7 @@ SOURCES += \
 	$$PWD/qrsMetamodelLoader.cpp \
 	$$PWD/qrsMetamodelSaver.cpp \
 	$$PWD/details/patternParser.cpp \
+	$$PWD/details/typeTable.cpp \
 
 RESOURCES += \
 	$$PWD/pluginManager.qrc \
@@ -20,9 +20,11 @@
 #include <QtCore/QRegExp>
 #include <QtCore/QFileInfo>
 #include <QtCore/QDir>
+#include <QtCore/QMap>
 #include <QtWidgets/QApplication>
 #include <QtGui/QFont>
 #include <QtGui/QIcon>
+#include <QtGui/QTransform>
 
 #include <qrutils/imagesCache.h>
 #include <metaMetaModel/elementRepoInterface.h>
@@ -36,7 +38,7 @@ SdfRenderer::SdfRenderer()
 }
 
 SdfRenderer::SdfRenderer(const QString path)
-	: mStartX(0), mStartY(0), mNeedScale(true)
+	: mStartX(0), mStartY(0), mNeedScale(true), mElementRepo(0)
 {
 	if (!load(path))
 	{
@@ -70,6 +72,7 @@ bool SdfRenderer::load(const QString &filename)
 	QDomElement docElem = doc.documentElement();
 	first_size_x = docElem.attribute("sizex").toInt();
 	first_size_y = docElem.attribute("sizey").toInt();
+	compile();
 
 	return true;
 }
@@ -80,6 +83,7 @@ bool SdfRenderer::load(const QDomDocument &document)
 	const QDomElement docElem = doc.firstChildElement("picture");
 	first_size_x = docElem.attribute("sizex").toInt();
 	first_size_y = docElem.attribute("sizey").toInt();
+	compile();
 
 	return true;
 }
@@ -90,6 +94,7 @@ bool SdfRenderer::load(const QDomElement &picture)
 	const QDomElement docElem = doc.firstChildElement("picture");
 	first_size_x = docElem.attribute("sizex").toInt();
 	first_size_y = docElem.attribute("sizey").toInt();
+	compile();
 
 	return true;
 }
@@ -111,300 +116,470 @@ void SdfRenderer::render(QPainter *painter, const QRectF &bounds, bool isIcon)
 	mStartX = static_cast<int>(bounds.x());
 	mStartY = static_cast<int>(bounds.y());
 	this->painter = painter;
-	QDomElement docElem = doc.documentElement();
-	QDomNode node = docElem.firstChild();
-	while(!node.isNull())
+	for (const Primitive &primitive : mPrimitives) {
+		if (!checkShowConditions(primitive, isIcon)) {
+			continue;
+		}
+
+		switch (primitive.type) {
+		case Primitive::Type::line:
+			line(primitive);
+			break;
+		case Primitive::Type::ellipse:
+			ellipse(primitive);
+			break;
+		case Primitive::Type::arc:
+			arc(primitive);
+			break;
+		case Primitive::Type::background:
+			background(primitive);
+			break;
+		case Primitive::Type::text:
+			draw_text(primitive);
+			break;
+		case Primitive::Type::rectangle:
+			rectangle(primitive);
+			break;
+		case Primitive::Type::polygon:
+			polygon(primitive);
+			break;
+		case Primitive::Type::point:
+			point(primitive);
+			break;
+		case Primitive::Type::path:
+			path_draw(primitive);
+			break;
+		case Primitive::Type::curve:
+			curve_draw(primitive);
+			break;
+		case Primitive::Type::image:
+			image_draw(primitive);
+			break;
+		}
+	}
+
+	this->painter = 0;
+}
+
+void SdfRenderer::compile()
+{
+	mPrimitives.clear();
+	const QDomElement docElem = doc.documentElement();
+	for (QDomElement element = docElem.firstChildElement(); !element.isNull()
+			; element = element.nextSiblingElement())
 	{
-		QDomElement elem = node.toElement();
-		if(!elem.isNull())
+		compileElement(element, parseShowConditions(element));
+	}
+}
+
+void SdfRenderer::compileElement(const QDomElement &element, const QList<Condition> &conditions)
+{
+	const QString tagName = element.tagName();
+	if (tagName == "stylus") {
+		// Lines of stylus are shown or hidden together with the stylus itself.
+		for (QDomElement line = element.firstChildElement("line"); !line.isNull()
+				; line = line.nextSiblingElement("line"))
 		{
-			if (!checkShowConditions(elem, isIcon)) {
-				node = node.nextSibling();
-				continue;
-			}
-			if (elem.tagName()=="line")
-			{
-				line(elem);
-			}
-			else if(elem.tagName()=="ellipse")
-			{
-				ellipse(elem);
-			}
-			else if (elem.tagName() == "arc") {
-				arc(elem);
-			}
-			else if(elem.tagName()=="background")
-			{
-				background(elem);
-			}
-			else if(elem.tagName()=="text")
-			{
-				draw_text(elem);
-			}
-			else if (elem.tagName()=="rectangle")
-			{
-				rectangle(elem);
-			}
-			else if (elem.tagName()=="polygon")
-			{
-				polygon(elem);
-			}
-			else if (elem.tagName()=="point")
-			{
-				point(elem);
-			}
-			else if(elem.tagName()=="path")
-			{
-				path_draw(elem);
+			compileElement(line, conditions);
+		}
+
+		return;
+	}
+
+	Primitive primitive;
+	primitive.conditions = conditions;
+	primitive.style = parseStyle(element);
+	primitive.x1 = parseCoordinate(element.attribute("x1"));
+	primitive.y1 = parseCoordinate(element.attribute("y1"));
+	primitive.x2 = parseCoordinate(element.attribute("x2"));
+	primitive.y2 = parseCoordinate(element.attribute("y2"));
+
+	if (tagName == "line") {
+		primitive.type = Primitive::Type::line;
+	} else if (tagName == "ellipse") {
+		primitive.type = Primitive::Type::ellipse;
+	} else if (tagName == "arc") {
+		primitive.type = Primitive::Type::arc;
+		primitive.startAngle = element.attribute("startAngle").toInt();
+		primitive.spanAngle = element.attribute("spanAngle").toInt();
+	} else if (tagName == "background") {
+		primitive.type = Primitive::Type::background;
+	} else if (tagName == "text") {
+		primitive.type = Primitive::Type::text;
+		QString text = element.text();
+		// delete "\n" from the beginning and from the end of the string
+		if (text.startsWith('\n')) {
+			text.remove(0, 1);
+		}
+
+		if (text.endsWith('\n')) {
+			text.chop(1);
+		}
+
+		primitive.text = text.split('\n');
+	} else if (tagName == "rectangle") {
+		primitive.type = Primitive::Type::rectangle;
+	} else if (tagName == "polygon") {
+		primitive.type = Primitive::Type::polygon;
+		const int n = element.attribute("n").toInt();
+		for (int i = 1; i <= n; ++i) {
+			primitive.points << qMakePair(parseCoordinate(element.attribute(QString("x%1").arg(i)))
+					, parseCoordinate(element.attribute(QString("y%1").arg(i))));
+		}
+	} else if (tagName == "point") {
+		primitive.type = Primitive::Type::point;
+	} else if (tagName == "path") {
+		primitive.type = Primitive::Type::path;
+		primitive.path = parsePath(element.attribute("d"));
+	} else if (tagName == "curve") {
+		primitive.type = Primitive::Type::curve;
+		for (QDomElement child = element.firstChildElement(); !child.isNull(); child = child.nextSiblingElement()) {
+			if (child.tagName() == "start") {
+				primitive.curveStart = QPointF(child.attribute("startx").toDouble()
+						, child.attribute("starty").toDouble());
+			} else if (child.tagName() == "end") {
+				primitive.curveEnd = QPointF(child.attribute("endx").toDouble(), child.attribute("endy").toDouble());
+			} else if (child.tagName() == "ctrl") {
+				primitive.curveControl = QPointF(child.attribute("x").toDouble(), child.attribute("y").toDouble());
 			}
-			else if(elem.tagName()=="stylus")
-			{
-				stylus_draw(elem);
+		}
+	} else if (tagName == "image") {
+		primitive.type = Primitive::Type::image;
+		primitive.imageName = element.attribute("name", "default");
+	} else {
+		return;
+	}
+
+	mPrimitives << primitive;
+}
+
+SdfRenderer::Coordinate SdfRenderer::parseCoordinate(QString coordinate)
+{
+	Coordinate result;
+	if (coordinate.endsWith("%")) {
+		coordinate.chop(1);
+		result.unit = Coordinate::Unit::percent;
+	} else if (coordinate.endsWith("a")) {
+		coordinate.chop(1);
+		result.unit = Coordinate::Unit::absolute;
+	}
+
+	result.value = coordinate.toFloat();
+	return result;
+}
+
+SdfRenderer::Style SdfRenderer::parseStyle(const QDomElement &element)
+{
+	Style style;
+	if (element.hasAttribute("stroke-width")) {
+		style.hasStrokeWidth = true;
+		style.strokeWidth = element.attribute("stroke-width").toInt();
+	}
+
+	if (element.hasAttribute("fill")) {
+		style.hasFill = true;
+		style.fill = QColor(element.attribute("fill"));
+	}
+
+	if (element.hasAttribute("stroke")) {
+		style.hasStroke = true;
+		style.stroke = QColor(element.attribute("stroke"));
+	}
+
+	if (element.hasAttribute("stroke-style")) {
+		static const QMap<QString, Qt::PenStyle> penStyles = {
+			{ "solid", Qt::SolidLine }
+			, { "dot", Qt::DotLine }
+			, { "dash", Qt::DashLine }
+			, { "dashdot", Qt::DashDotLine }
+			, { "dashdotdot", Qt::DashDotDotLine }
+			, { "none", Qt::NoPen }
+		};
+
+		const QString strokeStyle = element.attribute("stroke-style");
+		if (penStyles.contains(strokeStyle)) {
+			style.hasStrokeStyle = true;
+			style.strokeStyle = penStyles[strokeStyle];
+		}
+	}
+
+	if (element.hasAttribute("fill-style")) {
+		const QString fillStyle = element.attribute("fill-style");
+		if (fillStyle == "none") {
+			style.hasFillStyle = true;
+			style.fillStyle = Qt::NoBrush;
+		} else if (fillStyle == "solid") {
+			style.hasFillStyle = true;
+			style.fillStyle = Qt::SolidPattern;
+		}
+	}
+
+	if (element.hasAttribute("font-fill")) {
+		style.hasFontFill = true;
+		style.fontFill = QColor(element.attribute("font-fill"));
+	}
+
+	if (element.hasAttribute("font-size")) {
+		style.hasFontSize = true;
+		QString fontSize = element.attribute("font-size");
+		if (fontSize.endsWith("%")) {
+			fontSize.chop(1);
+			style.fontSize.unit = Coordinate::Unit::percent;
+		} else if (fontSize.endsWith("a")) {
+			fontSize.chop(1);
+			style.fontSize.unit = Coordinate::Unit::absolute;
+		}
+
+		style.fontSize.value = fontSize.toInt();
+	}
+
+	if (element.hasAttribute("font-name")) {
+		style.hasFontName = true;
+		style.fontName = element.attribute("font-name");
+	}
+
+	if (element.hasAttribute("b")) {
+		style.hasBold = true;
+		style.bold = element.attribute("b").toInt();
+	}
+
+	if (element.hasAttribute("i")) {
+		style.hasItalic = true;
+		style.italic = element.attribute("i").toInt();
+	}
+
+	if (element.hasAttribute("u")) {
+		style.hasUnderline = true;
+		style.underline = element.attribute("u").toInt();
+	}
+
+	return style;
+}
+
+QList<SdfRenderer::Condition> SdfRenderer::parseShowConditions(const QDomElement &element)
+{
+	static const QMap<QString, Condition::Sign> signs = {
+		{ "=~", Condition::Sign::match }
+		, { ">", Condition::Sign::greater }
+		, { "<", Condition::Sign::less }
+		, { ">=", Condition::Sign::greaterOrEqual }
+		, { "<=", Condition::Sign::lessOrEqual }
+		, { "!=", Condition::Sign::notEqual }
+		, { "=", Condition::Sign::equal }
+	};
+
+	QList<Condition> result;
+	const QDomNodeList showConditions = element.elementsByTagName("showIf");
+	for (int i = 0; i < showConditions.length(); ++i) {
+		const QDomElement showCondition = showConditions.at(i).toElement();
+		Condition condition;
+		condition.signText = showCondition.attribute("sign");
+		condition.sign = signs.value(condition.signText, Condition::Sign::unsupported);
+		condition.property = showCondition.attribute("property");
+		condition.value = showCondition.attribute("value");
+		condition.intValue = condition.value.toInt();
+		if (condition.sign == Condition::Sign::match) {
+			condition.pattern = QRegExp(condition.value);
+		}
+
+		result << condition;
+	}
+
+	return result;
+}
+
+QPainterPath SdfRenderer::parsePath(const QString &description)
+{
+	// Description is a sequence of commands separated by spaces: "M x y", "L x y", "C x1 y1 x2 y2 x y", "Z".
+	// If a command is followed by several groups of arguments, only the last one is taken.
+	const auto isCommand = [](const QString &token) {
+		return token == "M" || token == "L" || token == "C" || token == "Z";
+	};
+
+	QPainterPath path;
+	QPointF endPoint;
+	QPointF c1;
+	QPointF c2;
+	const QStringList tokens = description.split(' ', QString::SkipEmptyParts);
+	int i = 0;
+	while (i < tokens.size()) {
+		const QString command = tokens[i++];
+		QList<qreal> numbers;
+		while (i < tokens.size() && !isCommand(tokens[i])) {
+			numbers << tokens[i++].toFloat();
+		}
+
+		if (command == "M" || command == "L") {
+			if (numbers.size() >= 2) {
+				const int last = (numbers.size() / 2 - 1) * 2;
+				endPoint = QPointF(numbers[last], numbers[last + 1]);
 			}
-			else if(elem.tagName()=="curve")
-			{
-				curve_draw(elem);
+
+			if (command == "M") {
+				path.moveTo(endPoint);
+			} else {
+				path.lineTo(endPoint);
 			}
-			else if(elem.tagName()=="image")
-			{
-				image_draw(elem);
+		} else if (command == "C") {
+			if (numbers.size() >= 6) {
+				const int last = (numbers.size() / 6 - 1) * 6;
+				c1 = QPointF(numbers[last], numbers[last + 1]);
+				c2 = QPointF(numbers[last + 2], numbers[last + 3]);
+				endPoint = QPointF(numbers[last + 4], numbers[last + 5]);
 			}
+
+			path.cubicTo(c1, c2, endPoint);
+		} else if (command == "Z") {
+			path.closeSubpath();
 		}
-		node = node.nextSibling();
 	}
-	this->painter = 0;
+
+	return path;
 }
 
-bool SdfRenderer::checkShowConditions(const QDomElement &element, bool isIcon) const
+bool SdfRenderer::checkShowConditions(const Primitive &primitive, bool isIcon) const
 {
-	QDomNodeList showConditions = element.elementsByTagName("showIf");
 	// a hack, need to be removed when there is another version of icons
-	if (!showConditions.isEmpty() && isIcon) {
+	if (!primitive.conditions.isEmpty() && isIcon) {
 		return false;
 	}
-	if (showConditions.isEmpty() || !mElementRepo) {
+	if (primitive.conditions.isEmpty() || !mElementRepo) {
 		return true;
 	}
-	for (int i = 0; i < showConditions.length(); ++i) {
-		if (!checkCondition(showConditions.at(i).toElement())) {
+	for (const Condition &condition : primitive.conditions) {
+		if (!checkCondition(condition)) {
 			return false;
 		}
 	}
 	return true;
 }
 
-bool SdfRenderer::checkCondition(const QDomElement &condition) const
-{
-	QString sign = condition.attribute("sign");
-	QString realValue = mElementRepo->logicalProperty(condition.attribute("property"));
-	QString conditionValue = condition.attribute("value");
-
-	if (sign == "=~") {
-		return QRegExp(conditionValue).exactMatch(realValue);
-	} else if (sign == ">") {
-		return realValue.toInt() > conditionValue.toInt();
-	} else if (sign == "<") {
-		return realValue.toInt() < conditionValue.toInt();
-	} else if (sign == ">=") {
-		return realValue.toInt() >= conditionValue.toInt();
-	} else if (sign == "<=") {
-		return realValue.toInt() <= conditionValue.toInt();
-	} else if (sign == "!=") {
-		return realValue != conditionValue;
-	} else if (sign == "=") {
-		return realValue == conditionValue;
-	} else {
-		qDebug() << "Unsupported logical operator \"" + sign + "\"";
+bool SdfRenderer::checkCondition(const Condition &condition) const
+{
+	const QString realValue = mElementRepo->logicalProperty(condition.property);
+
+	switch (condition.sign) {
+	case Condition::Sign::match:
+		return condition.pattern.exactMatch(realValue);
+	case Condition::Sign::greater:
+		return realValue.toInt() > condition.intValue;
+	case Condition::Sign::less:
+		return realValue.toInt() < condition.intValue;
+	case Condition::Sign::greaterOrEqual:
+		return realValue.toInt() >= condition.intValue;
+	case Condition::Sign::lessOrEqual:
+		return realValue.toInt() <= condition.intValue;
+	case Condition::Sign::notEqual:
+		return realValue != condition.value;
+	case Condition::Sign::equal:
+		return realValue == condition.value;
+	default:
+		qDebug() << "Unsupported logical operator \"" + condition.signText + "\"";
 		return false;
 	}
 }
 
-void SdfRenderer::line(QDomElement &element)
+void SdfRenderer::line(const Primitive &primitive)
 {
-	float x1 = x1_def(element);
-	float y1 = y1_def(element);
-	float x2 = x2_def(element);
-	float y2 = y2_def(element);
-	QLineF line (x1,y1,x2,y2);
+	QLineF line(x(primitive.x1), y(primitive.y1), x(primitive.x2), y(primitive.y2));
 
-	parsestyle(element);
+	applyStyle(primitive.style);
 	painter->drawLine(line);
 }
 
-void SdfRenderer::ellipse(QDomElement &element)
+void SdfRenderer::ellipse(const Primitive &primitive)
 {
-	float x1 = x1_def(element);
-	float y1 = y1_def(element);
-	float x2 = x2_def(element);
-	float y2 = y2_def(element);
+	float x1 = x(primitive.x1);
+	float y1 = y(primitive.y1);
+	float x2 = x(primitive.x2);
+	float y2 = y(primitive.y2);
 
 	QRectF rect(x1, y1, x2-x1, y2-y1);
-	parsestyle(element);
+	applyStyle(primitive.style);
 	painter->drawEllipse(rect);
 }
 
-void SdfRenderer::arc(QDomElement &element)
+void SdfRenderer::arc(const Primitive &primitive)
 {
-	float x1 = x1_def(element);
-	float y1 = y1_def(element);
-	float x2 = x2_def(element);
-	float y2 = y2_def(element);
-	int startAngle = element.attribute("startAngle").toInt();
-	int spanAngle = element.attribute("spanAngle").toInt();
+	float x1 = x(primitive.x1);
+	float y1 = y(primitive.y1);
+	float x2 = x(primitive.x2);
+	float y2 = y(primitive.y2);
 
 	QRectF rect(x1, y1, x2-x1, y2-y1);
-	parsestyle(element);
-	painter->drawArc(rect, startAngle, spanAngle);
+	applyStyle(primitive.style);
+	painter->drawArc(rect, primitive.startAngle, primitive.spanAngle);
 }
 
-void SdfRenderer::background(QDomElement &element)
+void SdfRenderer::background(const Primitive &primitive)
 {
-	parsestyle(element);
+	applyStyle(primitive.style);
 	painter->setPen(brush.color());
 	painter->drawRect(painter->window());
 	defaultstyle();
 }
 
-void SdfRenderer::draw_text(QDomElement &element)
+void SdfRenderer::draw_text(const Primitive &primitive)
 {
-	parsestyle(element);
+	applyStyle(primitive.style);
 	pen.setStyle(Qt::SolidLine);
 	painter->setPen(pen);
-	float x1 = x1_def(element);
-	float y1 = y1_def(element);
-	QString str = element.text();
-
-	// delete "\n" from the beginning of the string
-	if (str[0] == '\n')
-		str.remove(0, 1);
-
-	// delete "\n" from the end of the string
-	if (str[str.length() - 1] == '\n')
-		str.remove(str.length() - 1, 1);
+	float x1 = x(primitive.x1);
+	float y1 = y(primitive.y1);
 
-	while (str.contains('\n'))
-	{
-		int i = str.indexOf('\n');
-		QString temp = str.left(i);
-		str.remove(0, i + 1);
-		painter->drawText(static_cast<int>(x1), static_cast<int>(y1), temp);
-		y1 += painter->font().pixelSize() ;
+	for (int i = 0; i < primitive.text.size() - 1; ++i) {
+		painter->drawText(static_cast<int>(x1), static_cast<int>(y1), primitive.text[i]);
+		y1 += painter->font().pixelSize();
 	}
+
 	QPointF point(x1, y1);
-	painter->drawText(point, str);
+	painter->drawText(point, primitive.text.last());
 	defaultstyle();
 }
 
-void SdfRenderer::rectangle(QDomElement &element)
+void SdfRenderer::rectangle(const Primitive &primitive)
 {
-	float x1 = x1_def(element);
-	float y1 = y1_def(element);
-	float x2 = x2_def(element);
-	float y2 = y2_def(element);
-
 	QRectF rect;
-	rect.adjust(x1, y1, x2, y2);
-	parsestyle(element);
+	rect.adjust(x(primitive.x1), y(primitive.y1), x(primitive.x2), y(primitive.y2));
+	applyStyle(primitive.style);
 	painter->drawRect(rect);
 	defaultstyle();
 }
 
-void SdfRenderer::polygon(QDomElement &element)
+void SdfRenderer::polygon(const Primitive &primitive)
 {
-	parsestyle(element);
-	// FIXME: init points array here
-	QPoint *points = nullptr;
-	int n = element.attribute("n").toInt();
-	if (!element.isNull())
-	{
-		points = getpoints(element, n);
-	}
-	if (points != nullptr)
-	{
-		painter->drawConvexPolygon(points, n);
-		delete[] points;
+	applyStyle(primitive.style);
+	QVector<QPoint> points;
+	points.reserve(primitive.points.size());
+	for (const QPair<Coordinate, Coordinate> &point : primitive.points) {
+		points << QPoint(static_cast<int>(x(point.first)), static_cast<int>(y(point.second)));
 	}
+
+	painter->drawConvexPolygon(points.constData(), points.size());
 	defaultstyle();
 }
 
-void SdfRenderer::image_draw(QDomElement &element)
+void SdfRenderer::image_draw(const Primitive &primitive)
 {
-	float const x1 = x1_def(element);
-	float const y1 = y1_def(element);
-	float const x2 = x2_def(element);
-	float const y2 = y2_def(element);
+	float const x1 = x(primitive.x1);
+	float const y1 = y(primitive.y1);
+	float const x2 = x(primitive.x2);
+	float const y2 = y(primitive.y2);
 
-	const QString fileName = SettingsManager::value("pathToImages").toString() + "/"
-			+ element.attribute("name", "default");
+	const QString fileName = SettingsManager::value("pathToImages").toString() + "/" + primitive.imageName;
 
 	const QRect rect(x1, y1, x2 - x1, y2 - y1);
 	utils::ImagesCache::instance().drawImage(fileName, *painter, rect, mZoom);
 }
 
-void SdfRenderer::point(QDomElement &element)
+void SdfRenderer::point(const Primitive &primitive)
 {
-	parsestyle(element);
-	float x = x1_def(element);
-	float y = y1_def(element);
-	QPointF pointf(x,y);
+	applyStyle(primitive.style);
+	QPointF pointf(x(primitive.x1), y(primitive.y1));
 	painter->drawLine(QPointF(pointf.x()-0.1, pointf.y()-0.1), QPointF(pointf.x()+0.1, pointf.y()+0.1));
 	defaultstyle();
 }
 
-QPoint *SdfRenderer::getpoints(QDomElement &element, int n)
-{
-	QPoint *array = new QPoint[n];
-	float x = 0;
-	float y = 0;
-	for (int i = 0; i < n; i++)
-	{
-		QString str;
-		str.setNum(i + 1);
-		QDomElement elem = element;
-		QString xnum = elem.attribute(QString("x").append(str));
-		if (xnum.endsWith("%"))
-		{
-			xnum.chop(1);
-			x = current_size_x * xnum.toFloat() / 100 + mStartX;
-		}
-		else if (xnum.endsWith("a") && mNeedScale)
-		{
-			xnum.chop(1);
-			x = xnum.toFloat() + mStartX;
-		}
-		else if (xnum.endsWith("a") && !mNeedScale)
-		{
-			xnum.chop(1);
-			x = xnum.toFloat() * current_size_x / first_size_x + mStartX;
-		}
-		else
-			x = xnum.toFloat() * current_size_x / first_size_x + mStartX;
-
-		QString ynum = elem.attribute(QString("y").append(str));
-		if (ynum.endsWith("%"))
-		{
-			ynum.chop(1);
-			y = current_size_y * ynum.toFloat() / 100 + mStartY;
-		}
-		else if (ynum.endsWith("a") && mNeedScale)
-		{
-			ynum.chop(1);
-			y = ynum.toFloat() + mStartY;
-		}
-		else if (ynum.endsWith("a") && !mNeedScale)
-		{
-			ynum.chop(1);
-			y = ynum.toFloat() * current_size_y / first_size_y + mStartY;
-		}
-		else
-			y = ynum.toFloat() * current_size_y / first_size_y + mStartY;
-
-		array[i].setX(static_cast<int>(x));
-		array[i].setY(static_cast<int>(y));
-	}
-	return array;
-}
-
 void SdfRenderer::defaultstyle()
 {
 	pen.setColor(QColor(0,0,0));
@@ -414,379 +589,116 @@ void SdfRenderer::defaultstyle()
 	pen.setWidth(1);
 }
 
-bool SdfRenderer::isNotLCMZ(QString str, int i)
+void SdfRenderer::path_draw(const Primitive &primitive)
 {
-	return (str[i] != 'L') && (str[i] != 'C') && (str[i] != 'M')
-		&& (str[i] != 'Z') && (i != str.length());
-}
-
-void SdfRenderer::path_draw(QDomElement &element)
-{
-	QPointF end_point;
-	QPointF c1;
-	QPointF c2;
-	QDomElement elem = element;
-	QPainterPath path;
+	QTransform transform;
+	transform.translate(mStartX, mStartY);
+	transform.scale(static_cast<qreal>(current_size_x) / first_size_x
+			, static_cast<qreal>(current_size_y) / first_size_y);
 
-	if (!elem.isNull())
-	{
-		QString d_cont;
-		d_cont = elem.attribute("d").remove(0, 1);
-		d_cont.append(" Z");
-
-		for (i = 0; i < d_cont.length() - 1;)
-		{
-			if (d_cont[i] == 'M')
-			{
-				j = i + 2;
-				while (isNotLCMZ(d_cont, j))
-				{
-					while (d_cont[j] != ' ')
-					{
-						s1.append(d_cont[j]);
-						++j;
-					}
-
-					end_point.setX(s1.toFloat() * current_size_x / first_size_x + mStartX);
-					s1.clear();
-					++j;
-
-					while (d_cont[j] != ' ')
-					{
-						s1.append(d_cont[j]);
-						++j;
-					}
-
-					end_point.setY(s1.toFloat() * current_size_y / first_size_y + mStartY);
-					++j;
-					s1.clear();
-				}
-
-				path.moveTo(end_point);
-				i = j;
-			}
-			else if (d_cont[i] == 'L')
-			{
-				j = i + 2;
-				while (isNotLCMZ(d_cont, j))
-				{
-					while (d_cont[j] != ' ')
-					{
-						s1.append(d_cont[j]);
-						++j;
-					}
-
-					end_point.setX(s1.toFloat() * current_size_x / first_size_x + mStartX);
-					s1.clear();
-					++j;
-
-					while (d_cont[j] != ' ')
-					{
-						s1.append(d_cont[j]);
-						++j;
-					}
-					end_point.setY(s1.toFloat() * current_size_y / first_size_y + mStartY);
-					++j;
-					s1.clear();
-				}
-
-				 path.lineTo(end_point);
-				 i = j;
-			}
-			 else if (d_cont[i] == 'C')
-			{
-				j = i + 2;
-				while(isNotLCMZ(d_cont, j))
-				{
-					while (!(d_cont[j] == ' '))
-					{
-						s1.append(d_cont[j]);
-						++j;
-					}
-
-					c1.setX(s1.toFloat() * current_size_x / first_size_x + mStartX);
-					s1.clear();
-					++j;
-
-					while (d_cont[j] != ' ')
-					{
-						s1.append(d_cont[j]);
-						++j;
-					}
-
-					c1.setY(s1.toFloat() * current_size_y / first_size_y + mStartY);
-					s1.clear();
-					++j;
-
-					while (d_cont[j] != ' ')
-					{
-						s1.append(d_cont[j]);
-						++j;
-					}
-
-					c2.setX(s1.toFloat() * current_size_x / first_size_x + mStartX);
-					s1.clear();
-					++j;
-
-					while (d_cont[j] != ' ')
-					{
-						s1.append(d_cont[j]);
-						++j;
-					}
-
-					c2.setY(s1.toFloat() * current_size_y / first_size_y + mStartY);
-					s1.clear();
-					++j;
-
-					while (d_cont[j] != ' ')
-					{
-						s1.append(d_cont[j]);
-						++j;
-					}
-
-					end_point.setX(s1.toFloat() * current_size_x / first_size_x + mStartX);
-					s1.clear();
-					++j;
-
-					while (d_cont[j] != ' ')
-					{
-						s1.append(d_cont[j]);
-						++j;
-					}
-
-					end_point.setY(s1.toFloat() * current_size_y / first_size_y + mStartY);
-					s1.clear();
-					++j;
-				}
-
-				path.cubicTo(c1, c2, end_point);
-				i = j;
-
-			} else if (d_cont[i] == 'Z')
-			{
-				path.closeSubpath();
-				logger ("loggerZ.txt", "DONE");
-			}
-		}
-	}
-
-	parsestyle(element);
-	painter->drawPath(path);
-}
-
-void SdfRenderer::stylus_draw(QDomElement &element)
-{
-	QDomNode node = element.firstChild();
-	while(!node.isNull())
-	{
-		QDomElement elem = node.toElement();
-		if(!elem.isNull())
-		{
-			if (elem.tagName()=="line")
-			{
-				line(elem);
-			}
-		}
-		node = node.nextSibling();
-	}
+	applyStyle(primitive.style);
+	painter->drawPath(transform.map(primitive.path));
 }
 
-void SdfRenderer::curve_draw(QDomElement &element)
+void SdfRenderer::curve_draw(const Primitive &primitive)
 {
-	QDomNode node = element.firstChild();
-	QPointF start(0, 0);
-	QPointF end(0, 0);
-	QPoint c1(0, 0);
-	while(!node.isNull())
-	{
-		QDomElement elem = node.toElement();
-		if(!elem.isNull())
-		{
-			if (elem.tagName() == "start")
-			{
-				start.setX(elem.attribute("startx").toDouble() * current_size_x / first_size_x);
-				start.setY(elem.attribute("starty").toDouble() * current_size_y / first_size_y);
-			}
-			else if (elem.tagName() == "end")
-			{
-				end.setX(elem.attribute("endx").toDouble() * current_size_x / first_size_x);
-				end.setY(elem.attribute("endy").toDouble() * current_size_y / first_size_y);
-			}
-			else if (elem.tagName() == "ctrl")
-			{
-				c1.setX(elem.attribute("x").toDouble() * current_size_x / first_size_x);
-				c1.setY(elem.attribute("y").toDouble() * current_size_y / first_size_y);
-			}
-		}
-		node = node.nextSibling();
-	}
+	const QPointF start(primitive.curveStart.x() * current_size_x / first_size_x
+			, primitive.curveStart.y() * current_size_y / first_size_y);
+	const QPointF end(primitive.curveEnd.x() * current_size_x / first_size_x
+			, primitive.curveEnd.y() * current_size_y / first_size_y);
+	const QPoint c1(static_cast<int>(primitive.curveControl.x() * current_size_x / first_size_x)
+			, static_cast<int>(primitive.curveControl.y() * current_size_y / first_size_y));
 
 	QPainterPath path(start);
 	path.quadTo(c1, end);
-	parsestyle(element);
+	applyStyle(primitive.style);
 	painter->drawPath(path);
 }
 
-void SdfRenderer::parsestyle(QDomElement &element)
+void SdfRenderer::applyStyle(const Style &style)
 {
-	QDomElement elem = element;
-	if(!elem.isNull())
-	{
-		if (elem.hasAttribute("stroke-width"))
-		{
-			if (mNeedScale)
-				pen.setWidth(elem.attribute("stroke-width").toInt());
-			else  // for painting icons. width of all lines should be set to 1
-				pen.setWidth(1);
-		}
-
-		if (elem.hasAttribute("fill"))
-		{
-			QColor color = elem.attribute("fill");
-			brush.setStyle(Qt::SolidPattern);
-			brush.setColor(color);
-		}
+	if (style.hasStrokeWidth) {
+		// for painting icons width of all lines should be set to 1
+		pen.setWidth(mNeedScale ? style.strokeWidth : 1);
+	}
 
-		if (elem.hasAttribute("stroke"))
-		{
-			QColor color = elem.attribute("stroke");
-			pen.setColor(color);
-		}
+	if (style.hasFill) {
+		brush.setStyle(Qt::SolidPattern);
+		brush.setColor(style.fill);
+	}
 
-		if (elem.hasAttribute("stroke-style"))
-		{
-			if (elem.attribute("stroke-style") == "solid")
-				pen.setStyle(Qt::SolidLine);
-			if (elem.attribute("stroke-style") == "dot")
-				pen.setStyle(Qt::DotLine);
-			if (elem.attribute("stroke-style") == "dash")
-				pen.setStyle(Qt::DashLine);
-			if (elem.attribute("stroke-style") == "dashdot")
-				pen.setStyle(Qt::DashDotLine);
-			if (elem.attribute("stroke-style") == "dashdotdot")
-				pen.setStyle(Qt::DashDotDotLine);
-			if (elem.attribute("stroke-style") == "none")
-				pen.setStyle(Qt::NoPen);
-		}
+	if (style.hasStroke) {
+		pen.setColor(style.stroke);
+	}
 
-		if (elem.hasAttribute("fill-style"))
-		{
-			if (elem.attribute("fill-style")=="none")
-				brush.setStyle(Qt::NoBrush);
-			else if(elem.attribute("fill-style")=="solid")
-				brush.setStyle(Qt::SolidPattern);
-		}
+	if (style.hasStrokeStyle) {
+		pen.setStyle(style.strokeStyle);
+	}
 
-		if (elem.hasAttribute("font-fill"))
-		{
-			QColor color = elem.attribute("font-fill");
-			pen.setColor(color);
-		}
+	if (style.hasFillStyle) {
+		brush.setStyle(style.fillStyle);
+	}
 
-		if (elem.hasAttribute("font-size"))
-		{
-			QString fontsize = elem.attribute("font-size");
-			if (fontsize.endsWith("%"))
-			{
-				fontsize.chop(1);
-				font.setPixelSize(current_size_y * fontsize.toInt() / 100);
-			}
-			else if (fontsize.endsWith("a") && mNeedScale)
-			{
-				fontsize.chop(1);
-				font.setPixelSize(fontsize.toInt());
-			}
-			else if (fontsize.endsWith("a") && !mNeedScale)
-			{
-				fontsize.chop(1);
-				font.setPixelSize(fontsize.toInt() * current_size_y / first_size_y);
-			}
-			else
-				font.setPixelSize(fontsize.toInt() * current_size_y / first_size_y);
-		}
+	if (style.hasFontFill) {
+		pen.setColor(style.fontFill);
+	}
 
-		if (elem.hasAttribute("font-name"))
-		{
-			font.setFamily(elem.attribute("font-name"));
+	if (style.hasFontSize) {
+		const int fontSize = static_cast<int>(style.fontSize.value);
+		switch (style.fontSize.unit) {
+		case Coordinate::Unit::percent:
+			font.setPixelSize(current_size_y * fontSize / 100);
+			break;
+		case Coordinate::Unit::absolute:
+			font.setPixelSize(mNeedScale ? fontSize : fontSize * current_size_y / first_size_y);
+			break;
+		case Coordinate::Unit::picture:
+			font.setPixelSize(fontSize * current_size_y / first_size_y);
+			break;
 		}
+	}
 
-		if (elem.hasAttribute("b"))
-		{
-			font.setBold(elem.attribute("b").toInt());
-		}
+	if (style.hasFontName) {
+		font.setFamily(style.fontName);
+	}
 
-		if (elem.hasAttribute("i"))
-		{
-			font.setItalic(elem.attribute("i").toInt());
-		}
+	if (style.hasBold) {
+		font.setBold(style.bold);
+	}
 
-		if (elem.hasAttribute("u"))
-		{
-			font.setUnderline(elem.attribute("u").toInt());
-		}
+	if (style.hasItalic) {
+		font.setItalic(style.italic);
+	}
 
-		painter->setFont(font);
+	if (style.hasUnderline) {
+		font.setUnderline(style.underline);
 	}
+
+	painter->setFont(font);
 	painter->setPen(pen);
 	painter->setBrush(brush);
 }
 
-float SdfRenderer::coord_def(QDomElement &element, QString coordName, int current_size, int first_size)
+float SdfRenderer::coord_def(const Coordinate &coordinate, int current_size, int first_size) const
 {
-	float coord = 0;
-	QString coordStr = element.attribute(coordName);
-
-	if (coordStr.endsWith("%"))
-	{
-		coordStr.chop(1);
-		coord = current_size * coordStr.toFloat() / 100;
-		return coord;
-	}
-	else if (coordStr.endsWith("a") && mNeedScale)
-	{
-		coordStr.chop(1);
-		coord = coordStr.toFloat();
-		return coord;
-	}
-	else if (coordStr.endsWith("a") && !mNeedScale)
-	{
-		coordStr.chop(1);
-		coord = coordStr.toFloat() * current_size / first_size;
-		return coord;
-	}
-	else
-	{
-		coord = coordStr.toFloat() * current_size / first_size;
-		return coord;
+	switch (coordinate.unit) {
+	case Coordinate::Unit::percent:
+		return current_size * coordinate.value / 100;
+	case Coordinate::Unit::absolute:
+		return mNeedScale ? coordinate.value : coordinate.value * current_size / first_size;
+	default:
+		return coordinate.value * current_size / first_size;
 	}
 }
 
-float SdfRenderer::x1_def(QDomElement &element)
+float SdfRenderer::x(const Coordinate &coordinate) const
 {
-	return coord_def(element, "x1", current_size_x, first_size_x) + mStartX;
+	return coord_def(coordinate, current_size_x, first_size_x) + mStartX;
 }
 
-float SdfRenderer::y1_def(QDomElement &element)
+float SdfRenderer::y(const Coordinate &coordinate) const
 {
-	return coord_def(element, "y1", current_size_y, first_size_y) + mStartY;
-}
-
-float SdfRenderer::x2_def(QDomElement &element)
-{
-	return coord_def(element, "x2", current_size_x, first_size_x) + mStartX;
-}
-
-float SdfRenderer::y2_def(QDomElement &element)
-{
-	return coord_def(element, "y2", current_size_y, first_size_y) + mStartY;
-}
-
-void SdfRenderer::logger(QString path, QString string)
-{	log.setFileName(path);
-	log.open(QIODevice::Append | QIODevice::Text);
-	logtext.setDevice(&log);
-	logtext << string << "\n";
-	log.close();
+	return coord_def(coordinate, current_size_y, first_size_y) + mStartY;
 }
 
 void SdfRenderer::noScale()
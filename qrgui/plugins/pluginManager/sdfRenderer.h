@@ -17,11 +17,13 @@
 #include <QtWidgets/QWidget>
 #include <QtXml/QDomDocument>
 #include <QtGui/QPainter>
+#include <QtGui/QPainterPath>
 #include <QtGui/QFont>
 #include <QtCore/QFile>
 #include <QtCore/QTextStream>
 #include <QtCore/QFileInfo>
 #include <QtCore/QSharedPointer>
+#include <QtCore/QRegExp>
 #include <QtGui/QIconEngine>
 #include <QtSvg/QSvgRenderer>
 
@@ -61,6 +63,149 @@ public slots:
 	void setZoom(qreal zoomFactor);
 
 private:
+	/// Coordinate as it is written in sdf: in picture units (scaled to element size), in percents of element size
+	/// or absolute (with "a" suffix, not scaled unless the renderer draws icons).
+	struct Coordinate
+	{
+		enum class Unit
+		{
+			picture
+			, percent
+			, absolute
+		};
+
+		Unit unit = Unit::picture;
+		float value = 0;
+	};
+
+	/// Style attributes of sdf element, applied over current pen, brush and font. Only attributes present in sdf
+	/// are applied, the rest of style is inherited from previously drawn primitives.
+	struct Style
+	{
+		bool hasStrokeWidth = false;
+		int strokeWidth = 0;
+		bool hasFill = false;
+		QColor fill;
+		bool hasStroke = false;
+		QColor stroke;
+		bool hasStrokeStyle = false;
+		Qt::PenStyle strokeStyle = Qt::SolidLine;
+		bool hasFillStyle = false;
+		Qt::BrushStyle fillStyle = Qt::NoBrush;
+		bool hasFontFill = false;
+		QColor fontFill;
+
+		/// Font size is integer, Coordinate::value keeps result of QString::toInt().
+		bool hasFontSize = false;
+		Coordinate fontSize;
+		bool hasFontName = false;
+		QString fontName;
+
+		bool hasBold = false;
+		bool bold = false;
+		bool hasItalic = false;
+		bool italic = false;
+		bool hasUnderline = false;
+		bool underline = false;
+	};
+
+	/// "showIf" condition on a logical property of the element.
+	struct Condition
+	{
+		enum class Sign
+		{
+			match
+			, greater
+			, less
+			, greaterOrEqual
+			, lessOrEqual
+			, notEqual
+			, equal
+			, unsupported
+		};
+
+		Sign sign = Sign::unsupported;
+		QString signText;
+		QString property;
+		QString value;
+		int intValue = 0;
+		QRegExp pattern;
+	};
+
+	/// Drawing operation compiled from sdf element. Coordinates are kept relative to the picture and are resolved
+	/// against current bounds at render time.
+	struct Primitive
+	{
+		enum class Type
+		{
+			line
+			, ellipse
+			, arc
+			, background
+			, text
+			, rectangle
+			, polygon
+			, point
+			, path
+			, curve
+			, image
+		};
+
+		Type type = Type::line;
+		Style style;
+		QList<Condition> conditions;
+		Coordinate x1;
+		Coordinate y1;
+		Coordinate x2;
+		Coordinate y2;
+		int startAngle = 0;
+		int spanAngle = 0;
+
+		/// Lines of text.
+		QStringList text;
+
+		/// Polygon vertices.
+		QVector<QPair<Coordinate, Coordinate>> points;
+
+		/// Path in picture units.
+		QPainterPath path;
+
+		/// Start, control and end points of the curve in picture units.
+		QPointF curveStart;
+		QPointF curveControl;
+		QPointF curveEnd;
+
+		QString imageName;
+	};
+
+	/// Compiles loaded sdf document into the display list.
+	void compile();
+	void compileElement(const QDomElement &element, const QList<Condition> &conditions);
+	static Coordinate parseCoordinate(QString coordinate);
+	static Style parseStyle(const QDomElement &element);
+	static QList<Condition> parseShowConditions(const QDomElement &element);
+	static QPainterPath parsePath(const QString &description);
+
+	bool checkShowConditions(const Primitive &primitive, bool isIcon) const;
+	bool checkCondition(const Condition &condition) const;
+
+	void line(const Primitive &primitive);
+	void ellipse(const Primitive &primitive);
+	void arc(const Primitive &primitive);
+	void background(const Primitive &primitive);
+	void draw_text(const Primitive &primitive);
+	void rectangle(const Primitive &primitive);
+	void polygon(const Primitive &primitive);
+	void point(const Primitive &primitive);
+	void path_draw(const Primitive &primitive);
+	void curve_draw(const Primitive &primitive);
+	void image_draw(const Primitive &primitive);
+	void applyStyle(const Style &style);
+	void defaultstyle();
+	float coord_def(const Coordinate &coordinate, int current_size, int first_size) const;
+	float x(const Coordinate &coordinate) const;
+	float y(const Coordinate &coordinate) const;
+
 	QString mWorkingDirName;
 
 	int first_size_x;
@@ -69,54 +214,21 @@ private:
 	int current_size_y;
 	int mStartX;
 	int mStartY;
-	int i;
-	int j;
-	int sep;
 	QPainter *painter;
 	QPen pen;
 	QBrush brush;
-	QString s1;
-	QString s2;
 	QFont font;
-	QFile log;
-	QTextStream logtext;
 	QDomDocument doc;
 
+	/// Display list compiled from doc, so painting does not walk and parse DOM.
+	QList<Primitive> mPrimitives;
+
 	/** @brief is false if we don't need to scale according to absolute
 	 * coords, is useful for rendering icons. default is true
 	**/
 	bool mNeedScale;
 	qreal mZoom = 1.0;
 	ElementRepoInterface *mElementRepo;
-
-	bool checkShowConditions(const QDomElement &element, bool isIcon) const;
-	bool checkCondition(const QDomElement &condition) const;
-
-	void line(QDomElement &element);
-	void ellipse(QDomElement &element);
-	void arc(QDomElement &element);
-	void parsestyle(QDomElement &element);
-	void background(QDomElement &element);
-	void draw_text(QDomElement &element);
-	void rectangle(QDomElement &element);
-	void polygon(QDomElement &element);
-	QPoint *getpoints(QDomElement &element, int n);
-	void point (QDomElement &element);
-	void defaultstyle();
-	void path_draw(QDomElement &element);
-	void stylus_draw(QDomElement &element);
-	void curve_draw(QDomElement &element);
-	void image_draw(QDomElement &element);
-	float x1_def(QDomElement &element);
-	float y1_def(QDomElement &element);
-	float x2_def(QDomElement &element);
-	float y2_def(QDomElement &element);
-	float coord_def(QDomElement &element, QString coordName, int current_size, int first_size);
-	void logger(QString path, QString string);
-
-	/// checks that str[i] is not L, C, M or Z
-	/// @todo Not so helpful comment
-	bool isNotLCMZ(QString str, int i);
 };
 
 /// Constructs QIcon instance by a given sdf description
@@ -131,7 +131,7 @@ bool Autosaver::openAutosave(const QString &fileName)
 
 void Autosaver::saveTemp()
 {
-	mProjectManager.saveTo(tempFilePath());
+	mProjectManager.autosaveTo(tempFilePath());
 }
 
 bool Autosaver::checkAutoSavedVersion(const QString &originalProjectPath)
@@ -178,7 +178,7 @@ QString Autosaver::openTempFilePrompt() const
 
 void Autosaver::saveAutoSave()
 {
-	mProjectManager.saveTo(autosaveFilePath());
+	mProjectManager.autosaveTo(autosaveFilePath());
 }
 
 bool Autosaver::removeFile(const QString &fileName)
@@ -293,6 +293,11 @@ bool ProjectManager::saveTo(const QString &fileName)
 	return mModels.repoControlApi().saveTo(fileName);
 }
 
+bool ProjectManager::autosaveTo(const QString &fileName)
+{
+	return mModels.repoControlApi().autosave(fileName);
+}
+
 bool ProjectManager::save()
 {
 	// Do not change the method to saveAll - in the current implementation, an empty project in the repository is
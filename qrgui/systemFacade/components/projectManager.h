@@ -50,6 +50,10 @@ public slots:
 	/// Saves current project into given file without refreshing application state after it
 	bool saveTo(const QString &fileName);
 
+	/// Saves changes made since the previous autosave into given file in background, only changed elements are
+	/// written. Unlike saveTo() does not change the file the project is saved to.
+	bool autosaveTo(const QString &fileName);
+
 public:
 	bool openEmptyWithSuggestToSaveChanges() override;
 	bool open(const QString &fileName = QString()) override;
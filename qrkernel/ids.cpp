@@ -15,10 +15,36 @@
 #include "ids.h"
 
 #include <QtCore/QVariant>
-#include <QtCore/QUuid>
+#include <QtCore/QReadWriteLock>
+
+#include <cstring>
 
 using namespace qReal;
 
+struct Id::Atom
+{
+	QString string;
+	uint hash;
+};
+
+/// Compares UUIDs in the same order as their QUuid::toString() representations are compared.
+static bool uuidLess(const QUuid &left, const QUuid &right)
+{
+	if (left.data1 != right.data1) {
+		return left.data1 < right.data1;
+	}
+
+	if (left.data2 != right.data2) {
+		return left.data2 < right.data2;
+	}
+
+	if (left.data3 != right.data3) {
+		return left.data3 < right.data3;
+	}
+
+	return memcmp(left.data4, right.data4, sizeof(left.data4)) < 0;
+}
+
 Id Id::loadFromString(const QString &string)
 {
 	const QStringList path = string.split('/');
@@ -27,61 +53,68 @@ Id Id::loadFromString(const QString &string)
 
 	Id result;
 	switch (path.count()) {
-	case 5: result.mId = path[4];
+	case 5: result.setId(path[4]);
 		// Fall-thru
-	case 4: result.mElement = path[3];
+	case 4: result.mElement = intern(path[3]);
 		// Fall-thru
-	case 3: result.mDiagram = path[2];
+	case 3: result.mDiagram = intern(path[2]);
 		// Fall-thru
-	case 2: result.mEditor = path[1];
+	case 2: result.mEditor = intern(path[1]);
 		// Fall-thru
 	}
+
+	result.updateHash();
 	Q_ASSERT(string == result.toString());
 	return result;
 }
 
 Id Id::createElementId(const QString &editor, const QString &diagram, const QString &element)
 {
-	return Id(editor, diagram, element, QUuid::createUuid().toString());
+	Id result(editor, diagram, element);
+	result.mId = nullptr;
+	result.mUuid = QUuid::createUuid();
+	result.updateHash();
+	return result;
 }
 
 Id Id::rootId()
 {
-	return Id("ROOT_ID", "ROOT_ID", "ROOT_ID", "ROOT_ID");
+	static const Id root("ROOT_ID", "ROOT_ID", "ROOT_ID", "ROOT_ID");
+	return root;
 }
 
 Id::Id(const QString &editor, QString  const &diagram, QString  const &element, QString  const &id)
-		: mEditor(editor)
-		, mDiagram(diagram)
-		, mElement(element)
-		, mId(id)
+		: mEditor(intern(editor))
+		, mDiagram(intern(diagram))
+		, mElement(intern(element))
 {
+	setId(id);
+	updateHash();
 	Q_ASSERT(checkIntegrity());
 }
 
 Id::Id(const Id &base, const QString &additional)
-		: mEditor(base.mEditor)
-		, mDiagram(base.mDiagram)
-		, mElement(base.mElement)
-		, mId(base.mId)
+		: Id(base)
 {
 	const unsigned baseSize = base.idSize();
 	switch (baseSize) {
 	case 0:
-		mEditor = additional;
+		mEditor = intern(additional);
 		break;
 	case 1:
-		mDiagram = additional;
+		mDiagram = intern(additional);
 		break;
 	case 2:
-		mElement = additional;
+		mElement = intern(additional);
 		break;
 	case 3:
-		mId = additional;
+		setId(additional);
 		break;
 	default:
 		Q_ASSERT(!"Can not add a part to Id, it will be too long");
 	}
+
+	updateHash();
 	Q_ASSERT(checkIntegrity());
 }
 
@@ -90,57 +123,118 @@ Id::Id()
 {
 }
 
-Id::Id(const Id &other)
-	: Id(other.editor(), other.diagram(), other.element(), other.id())
+Id::Id(const Id &other) = default;
+
+const Id::Atom *Id::intern(const QString &string)
+{
+	// Atoms and the table are never destroyed, Ids with static storage duration may outlive them otherwise.
+	static const Atom * const empty = new Atom{QString(), qHash(QString())};
+	static QReadWriteLock &lock = *new QReadWriteLock();
+	static QHash<QString, const Atom *> &atoms = *new QHash<QString, const Atom *>();
+
+	if (string.isEmpty()) {
+		return empty;
+	}
+
+	{
+		QReadLocker locker(&lock);
+		if (const Atom * const atom = atoms.value(string)) {
+			return atom;
+		}
+	}
+
+	QWriteLocker locker(&lock);
+	const Atom *&atom = atoms[string];
+	if (!atom) {
+		atom = new Atom{string, qHash(string)};
+	}
+
+	return atom;
+}
+
+void Id::setId(const QString &id)
+{
+	// Ids generated by createElementId() and sameTypeId() look like "{xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx}",
+	// other ids are interned as they are.
+	const int uuidLength = 38;
+	if (id.length() == uuidLength && id.startsWith('{')) {
+		const QUuid uuid(id);
+		if (!uuid.isNull() && uuid.toString() == id) {
+			mId = nullptr;
+			mUuid = uuid;
+			return;
+		}
+	}
+
+	mId = intern(id);
+	mUuid = QUuid();
+}
+
+QString Id::idString() const
 {
+	return mId ? mId->string : mUuid.toString();
 }
 
+void Id::updateHash()
+{
+	uint hash = mEditor->hash;
+	hash = hash * 31 + mDiagram->hash;
+	hash = hash * 31 + mElement->hash;
+	mHash = hash * 31 + (mId ? mId->hash : qHash(mUuid));
+}
 
 bool Id::isNull() const
 {
-	return mEditor.isEmpty() && mDiagram.isEmpty()
-			&& mElement.isEmpty() && mId.isEmpty();
+	return idSize() == 0;
 }
 
 QString Id::editor() const
 {
-	return mEditor;
+	return mEditor->string;
 }
 
 QString Id::diagram() const
 {
-	return mDiagram;
+	return mDiagram->string;
 }
 
 QString Id::element() const
 {
-	return mElement;
+	return mElement->string;
 }
 
 QString Id::id() const
 {
-	return mId;
+	return idString();
 }
 
 Id Id::type() const
 {
-	return Id(mEditor, mDiagram, mElement);
+	Id result(*this);
+	result.mId = intern(QString());
+	result.mUuid = QUuid();
+	result.updateHash();
+	return result;
 }
 
 Id Id::sameTypeId() const
 {
-	return Id(mEditor, mDiagram, mElement, QUuid::createUuid().toString());
+	Id result(*this);
+	result.mId = nullptr;
+	result.mUuid = QUuid::createUuid();
+	result.updateHash();
+	return result;
 }
 
 unsigned Id::idSize() const
 {
-	if (!mId.isEmpty()) {
+	if (!mId || !mId->string.isEmpty()) {
 		return 4;
-	} if (!mElement.isEmpty()) {
+	} if (!mElement->string.isEmpty()) {
 		return 3;
-	} if (!mDiagram.isEmpty()) {
+	} if (!mDiagram->string.isEmpty()) {
 		return 2;
-	} if (!mEditor.isEmpty()) {
+	} if (!mEditor->string.isEmpty()) {
 		return 1;
 	}
 	return 0;
@@ -153,13 +247,13 @@ QUrl Id::toUrl() const
 
 QString Id::toString() const
 {
-	QString path = "qrm:/" + mEditor;
-	if (mDiagram != "") {
-		path += "/" + mDiagram;
-	} if (mElement != "") {
-		path += "/" + mElement;
-	} if (mId != "") {
-		path += "/" + mId;
+	QString path = "qrm:/" + mEditor->string;
+	if (!mDiagram->string.isEmpty()) {
+		path += "/" + mDiagram->string;
+	} if (!mElement->string.isEmpty()) {
+		path += "/" + mElement->string;
+	} if (!mId || !mId->string.isEmpty()) {
+		path += "/" + idString();
 	}
 	return path;
 }
@@ -168,29 +262,54 @@ bool Id::checkIntegrity() const
 {
 	bool emptyPartsAllowed = true;
 
-	if (!mId.isEmpty()) {
+	if (!mId || !mId->string.isEmpty()) {
 		emptyPartsAllowed = false;
 	}
 
-	if (!mElement.isEmpty()) {
+	if (!mElement->string.isEmpty()) {
 		emptyPartsAllowed = false;
 	} else if (!emptyPartsAllowed) {
 		return false;
 	}
 
-	if (!mDiagram.isEmpty()) {
+	if (!mDiagram->string.isEmpty()) {
 		emptyPartsAllowed = false;
 	} else if (!emptyPartsAllowed) {
 		return false;
 	}
 
-	if (mEditor.isEmpty() && !emptyPartsAllowed) {
+	if (mEditor->string.isEmpty() && !emptyPartsAllowed) {
 		return false;
 	}
 
 	return true;
 }
 
+bool qReal::operator<(const Id &i1, const Id &i2)
+{
+	if (i1.mEditor != i2.mEditor) {
+		return i1.mEditor->string < i2.mEditor->string;
+	}
+
+	if (i1.mDiagram != i2.mDiagram) {
+		return i1.mDiagram->string < i2.mDiagram->string;
+	}
+
+	if (i1.mElement != i2.mElement) {
+		return i1.mElement->string < i2.mElement->string;
+	}
+
+	if (i1.mId && i2.mId) {
+		return i1.mId != i2.mId && i1.mId->string < i2.mId->string;
+	}
+
+	if (!i1.mId && !i2.mId) {
+		return uuidLess(i1.mUuid, i2.mUuid);
+	}
+
+	return i1.idString() < i2.idString();
+}
+
 QVariant Id::toVariant() const
 {
 	QVariant result;
@@ -15,6 +15,7 @@
 #pragma once
 
 #include <QtCore/QUrl>
+#include <QtCore/QUuid>
 #include <QtCore/QDebug>
 
 #include "kernelDeclSpec.h"
@@ -25,6 +26,9 @@ namespace qReal {
 /// editor (metamodel to which our element belongs to), diagram in that editor
 /// (a tab in palette where this element will appear), element (type of
 /// an element, actually), id (id of an element).
+/// Editor, diagram and element parts are interned in a global symbol table and id part generated by
+/// createElementId() is kept as binary UUID, so Id is copied without reference counting, and its hash is computed
+/// once on construction. Ids are compared in constant time.
 class QRKERNEL_EXPORT Id
 {
 public:
@@ -101,26 +105,50 @@ public:
 
 	// default destructor and copy constuctor are OK
 private:
+	/// Interned string with its precomputed hash. Atoms are never freed, so equal strings share one atom and are
+	/// compared by address.
+	struct Atom;
+
+	/// Returns an atom for a given string, creating it if needed. Thread-safe.
+	static const Atom *intern(const QString &string);
+
+	/// Sets id part of an Id, UUIDs in QUuid::toString() format are kept in binary form.
+	void setId(const QString &id);
+
+	/// Returns id part as it was given, without converting to string.
+	QString idString() const;
+
+	/// Computes mHash from the parts of an Id.
+	void updateHash();
+
 	/// Used only for debug. Checks that Id is correct.
 	bool checkIntegrity() const;
 
-	QString mEditor;
-	QString mDiagram;
-	QString mElement;
-	QString mId;
+	const Atom *mEditor;
+	const Atom *mDiagram;
+	const Atom *mElement;
+
+	/// Id part, or nullptr if it is kept in mUuid.
+	const Atom *mId;
+	QUuid mUuid;
+
+	uint mHash;
 
 	friend bool operator==(const Id &i1, const Id &i2);
-	friend bool operator<(const Id &i1, const Id &i2);
+	friend QRKERNEL_EXPORT bool operator<(const Id &i1, const Id &i2);
 	friend uint qHash(const Id &key);
 };
 
-/// Id equality operator. Ids are equal when all their parts are equal.
+/// Id equality operator. Ids are equal when all their parts are equal. Parts are interned, so they are compared
+/// by address.
 inline bool operator==(const Id &i1, const Id &i2)
 {
-	return i1.mEditor == i2.mEditor
+	return i1.mHash == i2.mHash
+			&& i1.mEditor == i2.mEditor
 			&& i1.mDiagram == i2.mDiagram
 			&& i1.mElement == i2.mElement
-			&& i1.mId == i2.mId;
+			&& i1.mId == i2.mId
+			&& (i1.mId || i1.mUuid == i2.mUuid);
 }
 
 /// Id inequality operator.
@@ -129,20 +157,14 @@ inline bool operator!=(const Id &i1, const Id &i2)
 	return !(i1 == i2);
 }
 
-/// Comparison operator for using Id in maps
-inline bool operator<(const Id &i1, const Id &i2)
-{
-	// Faster implementation then just comapring toString().
-	return i1.mEditor != i2.mEditor ? i1.mEditor < i2.mEditor
-			: i1.mDiagram != i2.mDiagram ? i1.mDiagram < i2.mDiagram
-			: i1.mElement != i2.mElement ? i1.mElement < i2.mElement
-			: i1.mId < i2.mId;
-}
+/// Comparison operator for using Id in maps. Orders Ids by their parts as strings, so the order does not depend
+/// on the way parts are stored.
+QRKERNEL_EXPORT bool operator<(const Id &i1, const Id &i2);
 
 /// Hash function for Id for using it in QHash.
 inline uint qHash(const Id &key)
 {
-	return qHash(key.mEditor) ^ qHash(key.mDiagram) ^ qHash(key.mElement) ^ qHash(key.mId);
+	return key.mHash;
 }
 
 /// Operator for printing Id in QDebug.
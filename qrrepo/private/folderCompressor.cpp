@@ -27,6 +27,8 @@
 
 #define QUAZIP_STATIC
 #include "thirdparty/quazip/quazip/quazip/JlCompress.h"
+#include "thirdparty/quazip/quazip/quazip/quazip.h"
+#include "thirdparty/quazip/quazip/quazip/quazipfile.h"
 
 using namespace qrRepo;
 using namespace qrRepo::details;
@@ -62,6 +64,45 @@ void FolderCompressor::decompressFolder(const QString &sourceFile, const QString
 	}
 }
 
+void FolderCompressor::readFiles(const QString &sourceFile
+		, const std::function<void(const QString &, const QByteArray &)> &fileHandler)
+{
+	if (!QFile(sourceFile).exists()) {
+		throw SaveFileNotFoundException(sourceFile);
+	}
+
+	QuaZip zip(sourceFile);
+	if (!zip.open(QuaZip::mdUnzip) || zip.getEntriesCount() <= 0) {
+		readFilesOld(sourceFile, fileHandler);
+		return;
+	}
+
+	for (bool hasFile = zip.goToFirstFile(); hasFile; hasFile = zip.goToNextFile()) {
+		const QString fileName = zip.getCurrentFileName();
+		if (fileName.endsWith("/")) {
+			// Folder entry.
+			continue;
+		}
+
+		QuaZipFile file(&zip);
+		if (!file.open(QIODevice::ReadOnly)) {
+			throw SaveFileNotReadableException(sourceFile);
+		}
+
+		const QByteArray data = file.readAll();
+		file.close();
+		if (file.getZipError() != UNZ_OK) {
+			throw CorruptSaveFileException(sourceFile);
+		}
+
+		fileHandler(fileName, data);
+	}
+
+	if (zip.getZipError() != UNZ_OK) {
+		throw CorruptSaveFileException(sourceFile);
+	}
+}
+
 void FolderCompressor::decompressFolderOld(const QString &sourceFile, const QString &destinationFolder)
 {
 	QDir dir;
@@ -69,6 +110,29 @@ void FolderCompressor::decompressFolderOld(const QString &sourceFile, const QStr
 		throw CouldNotCreateDestinationFolderException(destinationFolder);
 	}
 
+	readFilesOld(sourceFile, [&dir, &destinationFolder](const QString &fileName, const QByteArray &data) {
+		// create any needed folder
+		for (int i = fileName.length() - 1; i > 0; --i) {
+			if (QString(fileName.at(i)) == "\\" || QString(fileName.at(i)) == "/") {
+				const QString subfolder = fileName.left(i);
+				dir.mkpath(destinationFolder + "/" + subfolder);
+				break;
+			}
+		}
+
+		QFile outFile(destinationFolder + "/" + fileName);
+		if (!outFile.open(QIODevice::WriteOnly)) {
+			throw CouldNotCreateOutFileException(outFile.fileName());
+		}
+
+		outFile.write(data);
+		outFile.close();
+	});
+}
+
+void FolderCompressor::readFilesOld(const QString &sourceFile
+		, const std::function<void(const QString &, const QByteArray &)> &fileHandler)
+{
 	QFile file(sourceFile);
 	if (!file.open(QIODevice::ReadOnly)) {
 		throw SaveFileNotReadableException(sourceFile);
@@ -88,35 +152,14 @@ void FolderCompressor::decompressFolderOld(const QString &sourceFile, const QStr
 
 		if (dataStream.status() != QDataStream::Ok) {
 			// file is in wrong format, metadata is corrupt
-			file.close();
 			throw CorruptSaveFileException(sourceFile);
 		}
 
-		// create any needed folder
-		for (int i = fileName.length() - 1; i > 0; --i) {
-			if (QString(fileName.at(i)) == "\\" || QString(fileName.at(i)) == "/") {
-				const QString subfolder = fileName.left(i);
-				dir.mkpath(destinationFolder + "/" + subfolder);
-				break;
-			}
-		}
-
-		QFile outFile(destinationFolder + "/" + fileName);
-		if (!outFile.open(QIODevice::WriteOnly)) {
-			file.close();
-			throw CouldNotCreateOutFileException(outFile.fileName());
-		}
-
 		const QByteArray uncompressedData = qUncompress(data);
 		if (uncompressedData.isEmpty()) {
-			file.close();
 			throw CorruptSaveFileException(sourceFile);
 		}
 
-		outFile.write(uncompressedData);
-		outFile.close();
+		fileHandler(fileName, uncompressedData);
 	}
-
-	file.close();
 }
-
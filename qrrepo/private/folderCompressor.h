@@ -14,6 +14,8 @@
 
 #pragma once
 
+#include <functional>
+
 #include <QtCore/QFile>
 #include <QtCore/QDir>
 
@@ -35,11 +37,19 @@ public:
 	/// @returns true if operation was successful.
 	static void decompressFolder(const QString &sourceFile, const QString &destinationFolder);
 
+	/// Reads files packed into the given file without unpacking them to disk. Understands the same formats as
+	/// decompressFolder() and throws the same exceptions.
+	/// @param fileHandler - called for each packed file with its path relative to packed folder and its contents.
+	static void readFiles(const QString &sourceFile
+			, const std::function<void(const QString &, const QByteArray &)> &fileHandler);
+
 private:
 	/// Creating is prohibited, utility class instances can not be created.
 	FolderCompressor() = delete;
 
 	static void decompressFolderOld(const QString &sourceFile, const QString &destinationFolder);
+	static void readFilesOld(const QString &sourceFile
+			, const std::function<void(const QString &, const QByteArray &)> &fileHandler);
 };
 
 }
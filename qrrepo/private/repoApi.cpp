@@ -426,6 +426,15 @@ bool RepoApi::saveTo(const QString &workingFile)
 	return false;
 }
 
+bool RepoApi::autosave(const QString &autosaveFile)
+{
+	if (!mIgnoreAutosave && !autosaveFile.isEmpty()) {
+		return mRepository->autosave(autosaveFile);
+	}
+
+	return false;
+}
+
 bool RepoApi::saveDiagramsById(QHash<QString, IdList> const &diagramIds)
 {
 	return mRepository->saveDiagramsById(diagramIds);
@@ -519,8 +528,8 @@ IdList RepoApi::logicalElements(const Id &type) const
 	Q_ASSERT(type.idSize() == 3);
 
 	IdList result;
-	for (Id id : mRepository->elements()) {
-		if (id.element() == type.element() && mRepository->isLogicalId(id))
+	for (const Id &id : mRepository->elementsOfType(type.element())) {
+		if (mRepository->isLogicalId(id))
 			result.append(id);
 	}
 
@@ -532,8 +541,8 @@ IdList RepoApi::graphicalElements(const Id &type) const
 	Q_ASSERT(type.idSize() == 3);
 
 	IdList result;
-	for (Id id : mRepository->elements()) {
-		if (id.element() == type.element() && !mRepository->isLogicalId(id))
+	for (const Id &id : mRepository->elementsOfType(type.element())) {
+		if (!mRepository->isLogicalId(id))
 			result.append(id);
 	}
 
@@ -542,27 +551,7 @@ IdList RepoApi::graphicalElements(const Id &type) const
 
 IdList RepoApi::elementsByType(const QString &type, bool sensitivity, bool regExpression) const
 {
-	const Qt::CaseSensitivity caseSensitivity = sensitivity ? Qt::CaseSensitive : Qt::CaseInsensitive;
-
-	QRegExp *regExp = new QRegExp(type,caseSensitivity);
-
-	IdList result;
-
-	if (regExpression) {
-		for (const Id &id : mRepository->elements()) {
-			if (id.element().contains(*regExp)) {
-				result.append(id);
-			}
-		}
-	} else {
-		for (const Id &id : mRepository->elements()) {
-			if (id.element().contains(type, caseSensitivity)) {
-				result.append(id);
-			}
-		}
-	}
-
-	return result;
+	return mRepository->elementsByType(type, sensitivity, regExpression);
 }
 
 qReal::IdList RepoApi::elementsByProperty(const QString &property, bool sensitivity, bool regExpression) const
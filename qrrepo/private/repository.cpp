@@ -14,6 +14,9 @@
 
 #include "repository.h"
 
+#include <QtCore/QFile>
+#include <QtConcurrent/QtConcurrent>
+
 #include <qrkernel/exception/exception.h>
 #include "singleXmlSerializer.h"
 
@@ -37,6 +40,7 @@ void Repository::init()
 
 Repository::~Repository()
 {
+	waitForAutosave();
 	mSerializer.clearWorkingDir();
 	qDeleteAll(mObjects);
 }
@@ -48,24 +52,10 @@ Serializer &Repository::serializer()
 
 IdList Repository::findElementsByName(const QString &name, bool sensitivity, bool regExpression) const
 {
-	const Qt::CaseSensitivity caseSensitivity = sensitivity ? Qt::CaseSensitive : Qt::CaseInsensitive;
-
-	const QRegExp regExp(name, caseSensitivity);
 	IdList result;
-
-	if (regExpression){
-		for (Object * const element : mObjects.values()) {
-			if (element->property("name").toString().contains(regExp)
-					&& !isLogicalId(mObjects.key(element))) {
-				result.append(mObjects.key(element));
-			}
-		}
-	} else {
-		for (Object * const element : mObjects.values()) {
-			if (element->property("name").toString().contains(name, caseSensitivity)
-					&& !isLogicalId(mObjects.key(element))) {
-				result.append(mObjects.key(element));
-			}
+	for (const Id &id : index().findByName(name, sensitivity, regExpression)) {
+		if (!isLogicalId(id)) {
+			result.append(id);
 		}
 	}
 
@@ -76,11 +66,9 @@ qReal::IdList Repository::elementsByProperty(const QString &property, bool sensi
 		, bool regExpression) const
 {
 	IdList result;
-
-	for (Object *element : mObjects.values()) {
-		if ((element->hasProperty(property, sensitivity, regExpression))
-				&& (!isLogicalId(mObjects.key(element)))) {
-			result.append(mObjects.key(element));
+	for (const Id &id : index().findByPropertyName(property, sensitivity, regExpression)) {
+		if (!isLogicalId(id)) {
+			result.append(id);
 		}
 	}
 
@@ -95,19 +83,19 @@ qReal::IdList Repository::elementsByPropertyContent(const QString &propertyValue
 	const QRegExp regExp(propertyValue, caseSensitivity);
 	IdList result;
 
-	for (Object * const element : mObjects.values()) {
-		QMapIterator<QString, QVariant> iterator = element->propertiesIterator();
+	for (const Id &id : index().candidatesByPropertyContent(propertyValue, regExpression)) {
+		QMapIterator<QString, QVariant> iterator = mObjects[id]->propertiesIterator();
 		if (regExpression) {
 			while (iterator.hasNext()) {
 				if (iterator.next().value().toString().contains(regExp)) {
-					result.append(mObjects.key(element));
+					result.append(id);
 					break;
 				}
 			}
 		} else {
 			while (iterator.hasNext()) {
 				if (iterator.next().value().toString().contains(propertyValue, caseSensitivity)) {
-					result.append(mObjects.key(element));
+					result.append(id);
 					break;
 				}
 			}
@@ -117,10 +105,21 @@ qReal::IdList Repository::elementsByPropertyContent(const QString &propertyValue
 	return result;
 }
 
+IdList Repository::elementsByType(const QString &type, bool sensitivity, bool regExpression) const
+{
+	return index().findByType(type, sensitivity, regExpression);
+}
+
+IdList Repository::elementsOfType(const QString &type) const
+{
+	return index().elementsOfType(type);
+}
+
 void Repository::replaceProperties(const qReal::IdList &toReplace, const QString &value, const QString &newValue)
 {
 	for (const qReal::Id &currentId : toReplace) {
 		mObjects[currentId]->replaceProperties(value, newValue);
+		markChanged(currentId);
 	}
 }
 
@@ -145,6 +144,10 @@ Id Repository::parent(const Id &id) const
 Id Repository::cloneObject(const qReal::Id &id)
 {
 	const Object * const result = mObjects[id]->clone(mObjects);
+	for (const Id &cloned : idsOfAllChildrenOf(result->id())) {
+		markChanged(cloned);
+	}
+
 	return result->id();
 }
 
@@ -155,6 +158,9 @@ void Repository::setParent(const Id &id, const Id &parent)
 			mObjects[id]->setParent(parent);
 			if (!mObjects[parent]->children().contains(id))
 				mObjects[parent]->addChild(id);
+
+			markChanged(id);
+			markChanged(parent);
 		} else {
 			throw Exception("Repository: Adding nonexistent parent " + parent.toString()
 					+ " to  object " + id.toString());
@@ -187,6 +193,9 @@ void Repository::addChild(const Id &id, const Id &child, const Id &logicalId)
 
 			mObjects.insert(child, object);
 		}
+
+		markChanged(id);
+		markChanged(child);
 	} else {
 		throw Exception("Repository: Adding child " + child.toString() + " to nonexistent object " + id.toString());
 	}
@@ -206,6 +215,7 @@ void Repository::stackBefore(const qReal::Id &id, const qReal::Id &child, const
 	}
 
 	mObjects[id]->stackBefore(child, sibling);
+	markChanged(id);
 }
 
 void Repository::removeParent(const Id &id)
@@ -215,6 +225,8 @@ void Repository::removeParent(const Id &id)
 		if (mObjects.contains(parent)) {
 			mObjects[id]->setParent(Id());
 			mObjects[parent]->removeChild(id);
+			markChanged(id);
+			markChanged(parent);
 		} else {
 			throw Exception("Repository: Removing nonexistent parent " + parent.toString()
 					+ " from object " + id.toString());
@@ -229,6 +241,7 @@ void Repository::removeChild(const Id &id, const Id &child)
 	if (mObjects.contains(id)) {
 		if (mObjects.contains(child)) {
 			mObjects[id]->removeChild(child);
+			markChanged(id);
 		} else {
 			throw Exception("Repository: removing nonexistent child " + child.toString()
 					+ " from object " + id.toString());
@@ -246,6 +259,7 @@ void Repository::setProperty(const Id &id, const QString &name, const QVariant &
 //				 ? mObjects[id]->property(name).userType() == value.userType()
 //				 : true);
 		mObjects[id]->setProperty(name, value);
+		markChanged(id);
 	} else {
 		throw Exception("Repository: Setting property of nonexistent object " + id.toString());
 	}
@@ -254,6 +268,7 @@ void Repository::setProperty(const Id &id, const QString &name, const QVariant &
 void Repository::copyProperties(const Id &dest, const Id &src)
 {
 	mObjects[dest]->copyPropertiesFrom(*mObjects[src]);
+	markChanged(dest);
 }
 
 QMap<QString, QVariant> Repository::properties(const Id &id) const
@@ -264,6 +279,7 @@ QMap<QString, QVariant> Repository::properties(const Id &id) const
 void Repository::setProperties(const Id &id, QMap<QString, QVariant> const &properties)
 {
 	mObjects[id]->setProperties(properties);
+	markChanged(id);
 }
 
 QVariant Repository::property(const Id &id, const QString &name) const
@@ -278,7 +294,8 @@ QVariant Repository::property(const Id &id, const QString &name) const
 void Repository::removeProperty(const Id &id, const QString &name)
 {
 	if (mObjects.contains(id)) {
-		return mObjects[id]->removeProperty(name);
+		mObjects[id]->removeProperty(name);
+		markChanged(id);
 	} else {
 		throw Exception("Repository: Removing property of nonexistent object " + id.toString());
 	}
@@ -299,6 +316,7 @@ void Repository::setBackReference(const Id &id, const Id &reference) const
 	if (mObjects.contains(id)) {
 		if (mObjects.contains(reference)) {
 			mObjects[id]->setBackReference(reference);
+			markChanged(id);
 		} else {
 			throw Exception("Repository: setting nonexistent back reference " + reference.toString()
 							+ " to object " + id.toString());
@@ -313,6 +331,7 @@ void Repository::removeBackReference(const Id &id, const Id &reference) const
 	if (mObjects.contains(id)) {
 		if (mObjects.contains(reference)) {
 			mObjects[id]->removeBackReference(reference);
+			markChanged(id);
 		} else {
 			throw Exception("Repository: removing nonexistent back reference " + reference.toString()
 							+ " of object " + id.toString());
@@ -326,6 +345,7 @@ void Repository::setTemporaryRemovedLinks(const Id &id, const QString &direction
 {
 	if (mObjects.contains(id)) {
 		mObjects[id]->setTemporaryRemovedLinks(direction, linkIdList);
+		markChanged(id);
 	} else {
 		throw Exception("Repository: Setting temporaryRemovedLinks of nonexistent object " + id.toString());
 	}
@@ -352,7 +372,8 @@ IdList Repository::temporaryRemovedLinks(const Id &id) const
 void Repository::removeTemporaryRemovedLinks(const Id &id)
 {
 	if (mObjects.contains(id)) {
-		return mObjects[id]->removeTemporaryRemovedLinks();
+		mObjects[id]->removeTemporaryRemovedLinks();
+		markChanged(id);
 	} else {
 		throw Exception("Repository: Removing temporaryRemovedLinks of nonexistent object " + id.toString());
 	}
@@ -360,12 +381,15 @@ void Repository::removeTemporaryRemovedLinks(const Id &id)
 
 void Repository::loadFromDisk()
 {
+	mIndex.reset();
 	mSerializer.loadFromDisk(mObjects, mMetaInfo);
 	addChildrenToRootObject();
 }
 
 void Repository::importFromDisk(const QString &importedFile)
 {
+	waitForAutosave();
+	resetAutosave();
 	mSerializer.setWorkingFile(importedFile);
 	loadFromDisk();
 	mSerializer.setWorkingFile(mWorkingFile);
@@ -426,11 +450,13 @@ bool Repository::exist(const Id &id) const
 
 bool Repository::saveAll() const
 {
+	waitForAutosave();
 	return mSerializer.saveToDisk(mObjects.values(), mMetaInfo);
 }
 
 bool Repository::save(const IdList &list) const
 {
+	waitForAutosave();
 	QList<Object*> toSave;
 	for (const Id &id : list) {
 		toSave.append(allChildrenOf(id));
@@ -441,6 +467,7 @@ bool Repository::save(const IdList &list) const
 
 bool Repository::saveWithLogicalId(const qReal::IdList &list) const
 {
+	waitForAutosave();
 	QList<Object*> toSave;
 	for (const Id &id : list) {
 		toSave << allChildrenOfWithLogicalId(id);
@@ -486,11 +513,104 @@ void Repository::remove(const qReal::Id &id)
 	if (mObjects.contains(id)) {
 		delete mObjects[id];
 		mObjects.remove(id);
+		markRemoved(id);
 	} else {
 		throw Exception("Repository: Trying to remove nonexistent object " + id.toString());
 	}
 }
 
+bool Repository::autosave(const QString &autosaveFile)
+{
+	const bool previousSucceeded = waitForAutosave();
+	// Failed append may leave broken journal in the archive, so it is rewritten completely after any failure.
+	const bool wholeRepository = !previousSucceeded
+			|| autosaveFile != mAutosaveFile
+			|| !QFile::exists(autosaveFile)
+			|| mAutosaveJournalSize > mObjects.size();
+
+	Serializer::Files files;
+	if (wholeRepository) {
+		files = mSerializer.serialize(mObjects.values());
+		files << mSerializer.metaInfoFile(mMetaInfo);
+		mAutosaveJournalSize = 0;
+	} else {
+		QList<Object *> changedObjects;
+		for (const Id &id : mChangedObjects) {
+			if (Object * const object = mObjects.value(id)) {
+				changedObjects << object;
+			}
+		}
+
+		files = mSerializer.serialize(changedObjects);
+		if (!mRemovedObjects.isEmpty()) {
+			files << mSerializer.removedObjectsFile(mRemovedObjects.toList(), mAutosaveJournalSize);
+		}
+
+		if (mMetaInfoChanged) {
+			files << mSerializer.metaInfoFile(mMetaInfo);
+		}
+
+		mAutosaveJournalSize += files.size();
+	}
+
+	mChangedObjects.clear();
+	mRemovedObjects.clear();
+	mMetaInfoChanged = false;
+	mAutosaveFile = autosaveFile;
+
+	if (!files.isEmpty()) {
+		mAutosaveResult = QtConcurrent::run(&Serializer::writeFiles, autosaveFile, files, !wholeRepository);
+	}
+
+	return previousSucceeded;
+}
+
+void Repository::markChanged(const Id &id) const
+{
+	mChangedObjects.insert(id);
+	mRemovedObjects.remove(id);
+	if (mIndex) {
+		if (const Object * const object = mObjects.value(id)) {
+			mIndex->update(*object);
+		}
+	}
+}
+
+void Repository::markRemoved(const Id &id) const
+{
+	mChangedObjects.remove(id);
+	mRemovedObjects.insert(id);
+	if (mIndex) {
+		mIndex->remove(id);
+	}
+}
+
+const RepositoryIndex &Repository::index() const
+{
+	if (!mIndex) {
+		mIndex.reset(new RepositoryIndex());
+		for (const Object * const object : mObjects) {
+			mIndex->update(*object);
+		}
+	}
+
+	return *mIndex;
+}
+
+void Repository::resetAutosave()
+{
+	mAutosaveFile.clear();
+	mChangedObjects.clear();
+	mRemovedObjects.clear();
+	mMetaInfoChanged = false;
+}
+
+bool Repository::waitForAutosave() const
+{
+	mAutosaveResult.waitForFinished();
+	return mAutosaveResult.resultCount() == 0 || mAutosaveResult.result();
+}
+
 void Repository::setWorkingFile(const QString &workingFile)
 {
 	mSerializer.setWorkingFile(workingFile);
@@ -524,6 +644,9 @@ void Repository::printDebug() const
 bool Repository::exterminate()
 {
 	printDebug();
+	waitForAutosave();
+	resetAutosave();
+	mIndex.reset();
 	mObjects.clear();
 	//serializer.clearWorkingDir();
 	bool result = !mWorkingFile.isEmpty() && mSerializer.saveToDisk(mObjects.values(), mMetaInfo);
@@ -536,6 +659,9 @@ bool Repository::exterminate()
 
 void Repository::open(const QString &saveFile)
 {
+	waitForAutosave();
+	resetAutosave();
+	mIndex.reset();
 	mObjects.clear();
 	init();
 	mSerializer.setWorkingFile(saveFile);
@@ -576,6 +702,7 @@ void Repository::createGraphicalPart(const qReal::Id &id, int partIndex)
 	}
 
 	graphicalObject->createGraphicalPart(partIndex);
+	markChanged(id);
 }
 
 QList<int> Repository::graphicalParts(const qReal::Id &id) const
@@ -611,6 +738,7 @@ void Repository::setGraphicalPartProperty(
 	}
 
 	graphicalObject->setGraphicalPartProperty(partIndex, propertyName, value);
+	markChanged(id);
 }
 
 QStringList Repository::metaInformationKeys() const
@@ -626,4 +754,5 @@ QVariant Repository::metaInformation(const QString &key) const
 void Repository::setMetaInformation(const QString &key, const QVariant &info)
 {
 	mMetaInfo[key] = info;
+	mMetaInfoChanged = true;
 }
@@ -15,6 +15,9 @@
 #pragma once
 
 #include <QtCore/QHash>
+#include <QtCore/QSet>
+#include <QtCore/QFuture>
+#include <QtCore/QScopedPointer>
 
 #include <qrkernel/definitions.h>
 #include <qrkernel/ids.h>
@@ -22,6 +25,7 @@
 #include "classes/graphicalObject.h"
 #include "classes/logicalObject.h"
 #include "serializer.h"
+#include "repositoryIndex.h"
 
 namespace qrRepo {
 namespace details {
@@ -54,6 +58,12 @@ public:
 	/// @param name - string that should be contained by names of elements that have input property content
 	qReal::IdList elementsByPropertyContent(const QString &property, bool sensitivity, bool regExpression) const;
 
+	/// Returns ids of elements whose type (element part of id) contains given string or matches given regexp.
+	qReal::IdList elementsByType(const QString &type, bool sensitivity, bool regExpression) const;
+
+	/// Returns ids of elements of exactly given type (element part of id).
+	qReal::IdList elementsOfType(const QString &type) const;
+
 	qReal::IdList children(const qReal::Id &id) const;
 	qReal::Id parent(const qReal::Id &id) const;
 
@@ -109,6 +119,14 @@ public:
 	bool save(const qReal::IdList &list) const;
 	bool saveWithLogicalId(const qReal::IdList &list) const;
 	bool saveDiagramsById(QHash<QString, qReal::IdList> const &diagramIds);
+
+	/// Saves changes made since the previous autosave into the given file. Only changed objects are serialized and
+	/// appended to the file as a journal that overrides their previous versions on load. The whole repository is
+	/// written when the file has no previous autosave or the journal has grown bigger than the repository.
+	/// The archive is written in a background thread, so the method returns before the file is written.
+	/// @returns false if writing of the previous autosave has failed.
+	bool autosave(const QString &autosaveFile);
+
 	void remove(const qReal::IdList &list) const;
 	void setWorkingFile(const QString &workingFile);
 	void exportToXml(const QString &targetFile) const;
@@ -162,9 +180,36 @@ private:
 	QList<Object*> allChildrenOf(qReal::Id id) const;
 	QList<Object*> allChildrenOfWithLogicalId(qReal::Id id) const;
 
+	/// Remembers that object with given id was added or modified since the last autosave and reindexes it.
+	void markChanged(const qReal::Id &id) const;
+	void markRemoved(const qReal::Id &id) const;
+
+	/// Returns search indexes, building them on first use. After that indexes are updated on every change.
+	const RepositoryIndex &index() const;
+
+	/// Makes next autosave write the whole repository.
+	void resetAutosave();
+
+	/// Waits until the last autosave is written, returns true if it succeeded.
+	bool waitForAutosave() const;
+
 	QHash<qReal::Id, Object *> mObjects;
 	QHash<QString, QVariant> mMetaInfo;
 
+	/// Objects added, modified or removed since the last autosave.
+	mutable QSet<qReal::Id> mChangedObjects;
+	mutable QSet<qReal::Id> mRemovedObjects;
+	bool mMetaInfoChanged = false;
+
+	/// File the last autosave was written to and the number of journal files appended to it after the whole
+	/// repository was written.
+	QString mAutosaveFile;
+	int mAutosaveJournalSize = 0;
+	mutable QFuture<bool> mAutosaveResult;
+
+	/// Search indexes, null until the first search.
+	mutable QScopedPointer<RepositoryIndex> mIndex;
+
 	/// Name of the current save file for project.
 	QString mWorkingFile;
 	Serializer mSerializer;
@@ -0,0 +1,187 @@
+/* Copyright 2018 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "repositoryIndex.h"
+
+#include <algorithm>
+
+#include <QtCore/QRegExp>
+
+using namespace qReal;
+using namespace qrRepo::details;
+
+const int trigramLength = 3;
+
+void RepositoryIndex::update(const Object &object)
+{
+	const Id id = object.id();
+	remove(id);
+
+	Entry entry;
+	entry.name = object.property("name").toString();
+	QMapIterator<QString, QVariant> iterator = object.propertiesIterator();
+	while (iterator.hasNext()) {
+		iterator.next();
+		entry.propertyNames << iterator.key();
+		entry.trigrams += trigrams(iterator.value().toString());
+	}
+
+	insert(mNames, entry.name, id);
+	insert(mTypes, id.element(), id);
+	for (const QString &property : entry.propertyNames) {
+		insert(mPropertyNames, property, id);
+	}
+
+	for (const QString &trigram : entry.trigrams) {
+		insert(mTrigrams, trigram, id);
+	}
+
+	mEntries.insert(id, entry);
+}
+
+void RepositoryIndex::remove(const Id &id)
+{
+	const auto it = mEntries.constFind(id);
+	if (it == mEntries.constEnd()) {
+		return;
+	}
+
+	erase(mNames, it->name, id);
+	erase(mTypes, id.element(), id);
+	for (const QString &property : it->propertyNames) {
+		erase(mPropertyNames, property, id);
+	}
+
+	for (const QString &trigram : it->trigrams) {
+		erase(mTrigrams, trigram, id);
+	}
+
+	mEntries.erase(it);
+}
+
+IdList RepositoryIndex::findByName(const QString &name, bool sensitivity, bool regExpression) const
+{
+	return find(mNames, name, sensitivity, regExpression);
+}
+
+IdList RepositoryIndex::findByType(const QString &type, bool sensitivity, bool regExpression) const
+{
+	return find(mTypes, type, sensitivity, regExpression);
+}
+
+IdList RepositoryIndex::elementsOfType(const QString &type) const
+{
+	return mTypes.value(type).toList();
+}
+
+IdList RepositoryIndex::findByPropertyName(const QString &property, bool sensitivity, bool regExpression) const
+{
+	return findExact(mPropertyNames, property, sensitivity, regExpression);
+}
+
+IdList RepositoryIndex::candidatesByPropertyContent(const QString &value, bool regExpression) const
+{
+	if (regExpression || value.length() < trigramLength) {
+		return mEntries.keys();
+	}
+
+	QList<const QSet<Id> *> postings;
+	for (const QString &trigram : trigrams(value)) {
+		const auto it = mTrigrams.constFind(trigram);
+		if (it == mTrigrams.constEnd()) {
+			return {};
+		}
+
+		postings << &it.value();
+	}
+
+	// Intersecting starting from the rarest trigram keeps intermediate sets small.
+	std::sort(postings.begin(), postings.end(), [](const QSet<Id> *left, const QSet<Id> *right) {
+		return left->size() < right->size();
+	});
+
+	QSet<Id> result = *postings.first();
+	for (int i = 1; i < postings.size() && !result.isEmpty(); ++i) {
+		result.intersect(*postings[i]);
+	}
+
+	return result.toList();
+}
+
+IdList RepositoryIndex::find(const QHash<QString, QSet<Id>> &index, const QString &pattern
+		, bool sensitivity, bool regExpression)
+{
+	const Qt::CaseSensitivity caseSensitivity = sensitivity ? Qt::CaseSensitive : Qt::CaseInsensitive;
+	const QRegExp regExp(pattern, caseSensitivity);
+
+	// One object may be found under several matching keys, so it is collected into a set and reported once.
+	QSet<Id> result;
+	for (auto it = index.constBegin(); it != index.constEnd(); ++it) {
+		const bool matches = regExpression
+				? it.key().contains(regExp)
+				: it.key().contains(pattern, caseSensitivity);
+		if (matches) {
+			result.unite(it.value());
+		}
+	}
+
+	return result.toList();
+}
+
+IdList RepositoryIndex::findExact(const QHash<QString, QSet<Id>> &index, const QString &pattern
+		, bool sensitivity, bool regExpression)
+{
+	const Qt::CaseSensitivity caseSensitivity = sensitivity ? Qt::CaseSensitive : Qt::CaseInsensitive;
+	const QRegExp regExp(pattern, caseSensitivity);
+
+	QSet<Id> result;
+	for (auto it = index.constBegin(); it != index.constEnd(); ++it) {
+		const bool matches = regExpression
+				? it.key().contains(regExp)
+				: it.key().compare(pattern, caseSensitivity) == 0;
+		if (matches) {
+			result.unite(it.value());
+		}
+	}
+
+	return result.toList();
+}
+
+QSet<QString> RepositoryIndex::trigrams(const QString &string)
+{
+	// Values are case-folded, so the index serves both case-sensitive and case-insensitive search.
+	const QString folded = string.toCaseFolded();
+	QSet<QString> result;
+	for (int i = 0; i + trigramLength <= folded.length(); ++i) {
+		result.insert(folded.mid(i, trigramLength));
+	}
+
+	return result;
+}
+
+void RepositoryIndex::insert(QHash<QString, QSet<Id>> &index, const QString &key, const Id &id)
+{
+	index[key].insert(id);
+}
+
+void RepositoryIndex::erase(QHash<QString, QSet<Id>> &index, const QString &key, const Id &id)
+{
+	const auto it = index.find(key);
+	if (it != index.end()) {
+		it->remove(id);
+		if (it->isEmpty()) {
+			index.erase(it);
+		}
+	}
+}
@@ -0,0 +1,90 @@
+/* Copyright 2018 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QHash>
+#include <QtCore/QSet>
+
+#include <qrkernel/ids.h>
+
+#include "classes/object.h"
+
+namespace qrRepo {
+namespace details {
+
+/// Secondary indexes of repository objects used by search: objects by name, by type (element part of id),
+/// by names of their properties and by trigrams of their property values. Indexes are updated one object at a time
+/// when the object changes, so search does not have to scan all objects of repository.
+class RepositoryIndex
+{
+public:
+	/// Adds given object to indexes or reindexes it if it is already there.
+	void update(const Object &object);
+
+	/// Removes object with given id from indexes.
+	void remove(const qReal::Id &id);
+
+	/// Returns ids of objects whose name contains given string or matches given regular expression.
+	qReal::IdList findByName(const QString &name, bool sensitivity, bool regExpression) const;
+
+	/// Returns ids of objects whose type contains given string or matches given regular expression.
+	qReal::IdList findByType(const QString &type, bool sensitivity, bool regExpression) const;
+
+	/// Returns ids of objects of exactly given type.
+	qReal::IdList elementsOfType(const QString &type) const;
+
+	/// Returns ids of objects having a property whose name is equal to given one or matches given regular
+	/// expression.
+	qReal::IdList findByPropertyName(const QString &property, bool sensitivity, bool regExpression) const;
+
+	/// Returns ids of objects which may have a property value containing given string, the caller shall check
+	/// the values of these objects. Regular expressions and too short strings can not be looked up by trigrams,
+	/// so all objects are returned for them.
+	qReal::IdList candidatesByPropertyContent(const QString &value, bool regExpression) const;
+
+private:
+	/// Indexed data of one object, kept to remove the object from indexes.
+	struct Entry
+	{
+		QString name;
+		QStringList propertyNames;
+		QSet<QString> trigrams;
+	};
+
+	/// Returns ids of all objects indexed by keys which contain given string or match given regular expression.
+	static qReal::IdList find(const QHash<QString, QSet<qReal::Id>> &index, const QString &pattern
+			, bool sensitivity, bool regExpression);
+
+	/// Returns ids of all objects indexed by keys equal to given string or matching given regular expression.
+	static qReal::IdList findExact(const QHash<QString, QSet<qReal::Id>> &index, const QString &pattern
+			, bool sensitivity, bool regExpression);
+
+	static QSet<QString> trigrams(const QString &string);
+
+	static void insert(QHash<QString, QSet<qReal::Id>> &index, const QString &key, const qReal::Id &id);
+	static void erase(QHash<QString, QSet<qReal::Id>> &index, const QString &key, const qReal::Id &id);
+
+	QHash<qReal::Id, Entry> mEntries;
+
+	QHash<QString, QSet<qReal::Id>> mNames;
+	QHash<QString, QSet<qReal::Id>> mTypes;
+	QHash<QString, QSet<qReal::Id>> mPropertyNames;
+
+	/// Objects by trigrams of case-folded values of their properties.
+	QHash<QString, QSet<qReal::Id>> mTrigrams;
+};
+
+}
+}
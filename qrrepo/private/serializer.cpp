@@ -21,20 +21,40 @@
 
 #include <qrkernel/platformInfo.h>
 #include <qrkernel/exception/exception.h>
-#include <qrutils/outFile.h>
-#include <qrutils/xmlUtils.h>
 #include <qrutils/fileSystemUtils.h>
 
 #include "folderCompressor.h"
 #include "classes/logicalObject.h"
 #include "classes/graphicalObject.h"
 
+#define QUAZIP_STATIC
+#include "thirdparty/quazip/quazip/quazip/quazip.h"
+#include "thirdparty/quazip/quazip/quazip/quazipfile.h"
+
 using namespace qrRepo;
 using namespace details;
 using namespace utils;
 using namespace qReal;
 
 const QString unsavedDir = "%1/unsaved/%2";
+const QString metaInfoFileName = "metaInfo.xml";
+const QString removedObjectsFileName = "journal/removed%1.xml";
+
+/// Packs a file with given path and contents into the archive, returns true if succeeded.
+static bool writeFile(QuaZip &zip, const QString &path, const QByteArray &data)
+{
+	QuaZipNewInfo info(path);
+	info.setPermissions(QFile::ReadOwner | QFile::WriteOwner | QFile::ReadGroup | QFile::ReadOther);
+
+	QuaZipFile file(&zip);
+	if (!file.open(QIODevice::WriteOnly, info)) {
+		return false;
+	}
+
+	const bool written = file.write(data) == data.size();
+	file.close();
+	return written && file.getZipError() == ZIP_OK;
+}
 
 Serializer::Serializer(const QString &workingFile)
 	// Syncroniously running instances of QReal can clear temp dirs of each other.
@@ -81,93 +101,146 @@ bool Serializer::saveToDisk(QList<Object *> const &objects, QHash<QString, QVari
 		, "Serializer::saveToDisk(...)"
 		, "may be Repository of RepoApi (see Models constructor also) has been initialised with empty filename?");
 
-	clearWorkingDir();
-	for (const Object * const object : objects) {
-		const QString filePath = createDirectory(object->id(), object->isLogicalObject());
+	const QFileInfo fileInfo(mWorkingFile);
+	const QString filePath = fileInfo.absolutePath() + "/" + fileInfo.completeBaseName() + ".qrs";
+	return writeFiles(filePath, serialize(objects) << metaInfoFile(metaInfo), false);
+}
 
+Serializer::Files Serializer::serialize(const QList<Object *> &objects) const
+{
+	Files result;
+	for (const Object * const object : objects) {
 		QDomDocument doc;
 		QDomElement root = object->serialize(doc);
 		doc.appendChild(root);
+		result << File(pathInSave(object->id(), object->isLogicalObject()), doc.toByteArray(2));
+	}
 
-		OutFile out(filePath);
-		doc.save(out(), 2);
+	return result;
+}
+
+Serializer::File Serializer::metaInfoFile(const QHash<QString, QVariant> &metaInfo) const
+{
+	return File(metaInfoFileName, serializeMetaInfo(metaInfo));
+}
+
+Serializer::File Serializer::removedObjectsFile(const IdList &ids, int index) const
+{
+	QDomDocument document;
+	QDomElement root = document.createElement("removed");
+	document.appendChild(root);
+	for (const Id &id : ids) {
+		QDomElement element = document.createElement("object");
+		element.setAttribute("id", id.toString());
+		root.appendChild(element);
 	}
 
-	saveMetaInfo(metaInfo);
+	return File(removedObjectsFileName.arg(index), document.toByteArray(2));
+}
 
-	const QFileInfo fileInfo(mWorkingFile);
-	const QString fileName = fileInfo.completeBaseName();
+bool Serializer::writeFiles(const QString &filePath, const Files &files, bool append)
+{
+	if (!append) {
+		QFile previousSave(filePath);
+		if (previousSave.exists()) {
+			previousSave.remove();
+		}
+	}
 
-	const QDir compressDir(mWorkingDir);
-	const QDir dir = fileInfo.absolutePath();
+	// mdAppend would write a second archive after the first one, and readers see only the last central directory.
+	// mdAdd keeps existing entries in the central directory and adds new ones after them.
+	QuaZip zip(filePath);
+	if (!zip.open(append ? QuaZip::mdAdd : QuaZip::mdCreate)) {
+		return false;
+	}
 
-	QFile previousSave(dir.absolutePath() + "/" + fileName +".qrs");
-	if (previousSave.exists()) {
-		previousSave.remove();
+	bool success = true;
+	for (const File &file : files) {
+		success = writeFile(zip, file.first, file.second);
+		if (!success) {
+			break;
+		}
 	}
 
-	const QString filePath = fileInfo.absolutePath() + "/" + fileName + ".qrs";
-	try {
-		FolderCompressor::compressFolder(compressDir.absolutePath(), filePath);
-	} catch (...) {
+	zip.close();
+	if (!success || zip.getZipError() != ZIP_OK) {
+		if (!append) {
+			// Half-written save is useless, but failed append must not destroy everything saved before it.
+			QFile::remove(filePath);
+		}
+
 		return false;
 	}
 
 	// Hiding autosaved files
-	if (fileName.contains("~")) {
+	if (QFileInfo(filePath).completeBaseName().contains("~")) {
 		FileSystemUtils::makeHidden(filePath);
 	}
 
-	clearWorkingDir();
-
 	return true;
 }
 
 void Serializer::loadFromDisk(QHash<qReal::Id, Object*> &objectsHash, QHash<QString, QVariant> &metaInfo)
 {
-	clearWorkingDir();
-	if (QFileInfo::exists(mWorkingFile)) {
-		decompressFile(mWorkingFile);
+	metaInfo.clear();
+	if (!QFileInfo::exists(mWorkingFile)) {
+		return;
 	}
 
-	loadFromDisk(mWorkingDir, objectsHash);
-	loadMetaInfo(metaInfo);
+	FolderCompressor::readFiles(mWorkingFile, [this, &objectsHash, &metaInfo](const QString &path
+			, const QByteArray &data)
+	{
+		loadFile(path, data, objectsHash, metaInfo);
+	});
 }
 
-void Serializer::loadFromDisk(const QString &currentPath, QHash<qReal::Id, Object*> &objectsHash)
+void Serializer::loadFile(const QString &path, const QByteArray &data, QHash<qReal::Id, Object *> &objectsHash
+		, QHash<QString, QVariant> &metaInfo) const
 {
-	QDir dir(currentPath + "/tree");
-	if (dir.cd("logical")) {
-		loadModel(dir, objectsHash);
-		dir.cdUp();
-		dir.cd("graphical");
-		loadModel(dir, objectsHash);
+	// Very old saves may use Windows path separators.
+	const QString normalizedPath = QString(path).replace('\\', '/');
+	if (normalizedPath == metaInfoFileName) {
+		QDomDocument document;
+		document.setContent(data);
+		metaInfo.clear();
+		loadMetaInfo(document, metaInfo);
+		return;
 	}
-}
 
-void Serializer::loadModel(const QDir &dir, QHash<qReal::Id, Object*> &objectsHash)
-{
-	for (const QFileInfo &fileInfo : dir.entryInfoList(QDir::AllEntries | QDir::NoDotAndDotDot)) {
-		const QString path = fileInfo.filePath();
-		if (fileInfo.isDir()) {
-			loadModel(path, objectsHash);
-		} else if (fileInfo.isFile()) {
-			QDomDocument doc = xmlUtils::loadDocument(path);
-			const QDomElement element = doc.documentElement();
+	if (normalizedPath.startsWith("journal/removed")) {
+		QDomDocument document;
+		document.setContent(data);
+		for (QDomElement child = document.documentElement().firstChildElement("object")
+				; !child.isNull()
+				; child = child.nextSiblingElement("object"))
+		{
+			delete objectsHash.take(Id::loadFromString(child.attribute("id")));
+		}
 
-			// To ensure backwards compatibility. Replace this by separate tag names when save updating mechanism
-			// will be implemented.
-			Object * const object = element.hasAttribute("logicalId") && element.attribute("logicalId") != "qrm:/"
-					? dynamic_cast<Object *>(new GraphicalObject(element))
-					: dynamic_cast<Object *>(new LogicalObject(element))
-					;
+		return;
+	}
 
-			objectsHash.insert(object->id(), object);
-		}
+	if (!normalizedPath.startsWith("tree/logical/") && !normalizedPath.startsWith("tree/graphical/")) {
+		return;
 	}
+
+	QDomDocument doc;
+	doc.setContent(data);
+	const QDomElement element = doc.documentElement();
+
+	// To ensure backwards compatibility. Replace this by separate tag names when save updating mechanism
+	// will be implemented.
+	Object * const object = element.hasAttribute("logicalId") && element.attribute("logicalId") != "qrm:/"
+			? dynamic_cast<Object *>(new GraphicalObject(element))
+			: dynamic_cast<Object *>(new LogicalObject(element))
+			;
+
+	// Autosave journal may contain newer versions of the same object, the last one wins.
+	delete objectsHash.value(object->id());
+	objectsHash.insert(object->id(), object);
 }
 
-void Serializer::saveMetaInfo(QHash<QString, QVariant> const &metaInfo) const
+QByteArray Serializer::serializeMetaInfo(QHash<QString, QVariant> const &metaInfo) const
 {
 	QDomDocument document;
 	QDomElement root = document.createElement("metaInformation");
@@ -180,21 +253,11 @@ void Serializer::saveMetaInfo(QHash<QString, QVariant> const &metaInfo) const
 		root.appendChild(element);
 	}
 
-	const QString filePath = mWorkingDir + "/metaInfo.xml";
-	OutFile out(filePath);
-	out() << document.toString(4);
+	return document.toByteArray(4);
 }
 
-void Serializer::loadMetaInfo(QHash<QString, QVariant> &metaInfo) const
+void Serializer::loadMetaInfo(const QDomDocument &document, QHash<QString, QVariant> &metaInfo) const
 {
-	metaInfo.clear();
-
-	const QString filePath = mWorkingDir + "/metaInfo.xml";
-	if (!QFile::exists(filePath)) {
-		return;
-	}
-
-	const QDomDocument document = xmlUtils::loadDocument(filePath);
 	for (QDomElement child = document.documentElement().firstChildElement("info")
 			; !child.isNull()
 			; child = child.nextSiblingElement("info"))
@@ -217,22 +280,17 @@ QString Serializer::pathToElement(const Id &id) const
 	return dirName + "/" + partsList[partsList.size() - 1];
 }
 
-QString Serializer::createDirectory(const Id &id, bool logical) const
+QString Serializer::pathInSave(const Id &id, bool logical) const
 {
-	QString dirName = mWorkingDir + "/tree";
-	dirName += logical ? "/logical" : "/graphical";
+	QString path = logical ? "tree/logical" : "tree/graphical";
 
 	const QStringList partsList = id.toString().split('/');
 	Q_ASSERT(partsList.size() >= 1 && partsList.size() <= 5);
-	for (int i = 1; i < partsList.size() - 1; ++i) {
-		dirName += "/" + partsList[i];
+	for (int i = 1; i < partsList.size(); ++i) {
+		path += "/" + partsList[i];
 	}
 
-	QDir dir;
-	dir.rmdir(mWorkingDir);
-	dir.mkpath(dirName);
-
-	return dirName + "/" + partsList[partsList.size() - 1];
+	return path;
 }
 
 void Serializer::decompressFile(const QString &fileName)
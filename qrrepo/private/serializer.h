@@ -28,9 +28,17 @@ namespace qrRepo {
 namespace details {
 
 /// Class that is responsible for saving repository contents to disk as .qrs file.
+/// Save is a zip archive with one XML file per object under "tree/logical" or "tree/graphical" folder and
+/// "metaInfo.xml" file. Objects are packed into the archive and read from it right in memory, without unpacking
+/// the save to working directory. Autosaves may also have a journal: files appended to the archive later override
+/// earlier files with the same name, "journal/removed*.xml" files list objects removed since the previous entries.
 class Serializer
 {
 public:
+	/// Path of a file inside of save and its contents.
+	typedef QPair<QString, QByteArray> File;
+	typedef QList<File> Files;
+
 	explicit Serializer(const QString &workingFile);
 	~Serializer();
 
@@ -49,15 +57,35 @@ public:
 	/// Decompresses given file into working directory.
 	void decompressFile(const QString &fileName);
 
+	/// Serializes given objects into files of save.
+	Files serialize(const QList<Object *> &objects) const;
+
+	/// Serializes meta-information into a file of save.
+	File metaInfoFile(const QHash<QString, QVariant> &metaInfo) const;
+
+	/// Serializes a journal record about removal of given objects.
+	/// @param index - number making the name of the record unique in the save.
+	File removedObjectsFile(const qReal::IdList &ids, int index) const;
+
+	/// Packs given files into the archive with given path. Does not use serializer state, so it may be called from
+	/// any thread.
+	/// @param append - if true, files are appended to existing archive, otherwise the archive is rewritten.
+	/// @returns true if succeeded. If appending failed, the archive is kept, but its tail may be broken, so the next
+	/// write to it must rewrite it completely.
+	static bool writeFiles(const QString &filePath, const Files &files, bool append);
+
 private:
-	void loadFromDisk(const QString &currentPath, QHash<qReal::Id, Object *> &objectsHash);
-	void loadModel(const QDir &dir, QHash<qReal::Id, Object *> &objectsHash);
+	/// Creates an object or reads meta-information from a file packed into save.
+	void loadFile(const QString &path, const QByteArray &data, QHash<qReal::Id, Object *> &objectsHash
+			, QHash<QString, QVariant> &metaInfo) const;
 
-	void saveMetaInfo(const QHash<QString, QVariant> &metaInfo) const;
-	void loadMetaInfo(QHash<QString, QVariant> &metaInfo) const;
+	QByteArray serializeMetaInfo(const QHash<QString, QVariant> &metaInfo) const;
+	void loadMetaInfo(const QDomDocument &document, QHash<QString, QVariant> &metaInfo) const;
 
 	QString pathToElement(const qReal::Id &id) const;
-	QString createDirectory(const qReal::Id &id, bool logical) const;
+
+	/// Returns a path of a file with given object inside of save.
+	QString pathInSave(const qReal::Id &id, bool logical) const;
 
 	QString mWorkingDir;
 	QString mWorkingFile;
@@ -23,6 +23,7 @@ win32 {
 
 HEADERS += \
 	$$PWD/private/repository.h \
+	$$PWD/private/repositoryIndex.h \
 	$$PWD/private/folderCompressor.h \
 	$$PWD/private/qrRepoGlobal.h \
 	$$PWD/private/serializer.h \
@@ -35,6 +36,7 @@ HEADERS += \
 
 SOURCES += \
 	$$PWD/private/repository.cpp \
+	$$PWD/private/repositoryIndex.cpp \
 	$$PWD/private/folderCompressor.cpp \
 	$$PWD/private/repoApi.cpp \
 	$$PWD/private/serializer.cpp \
@@ -64,4 +66,4 @@ HEADERS += \
 
 DEFINES += QRREPO_LIBRARY
 
-QT += xml
+QT += xml concurrent
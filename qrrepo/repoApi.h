@@ -134,6 +134,7 @@ public:
 	bool saveAll() const override;
 	bool save(const qReal::IdList &list) const override;
 	bool saveTo(const QString &workingFile) override;
+	bool autosave(const QString &autosaveFile) override;
 	bool saveDiagramsById(QHash<QString, qReal::IdList> const &diagramIds) override;
 
 	void open(const QString &saveFile) override;
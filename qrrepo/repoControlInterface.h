@@ -46,6 +46,10 @@ public:
 	virtual bool save(const qReal::IdList &list) const = 0;
 	virtual bool saveTo(const QString &workingFile) = 0;
 
+	/// Saves changes made since the previous autosave into given file without changing the working file.
+	/// The file is written in background, returns false if writing of the previous autosave has failed.
+	virtual bool autosave(const QString &autosaveFile) = 0;
+
 	/// exports repo contents to a single XML file
 	virtual void exportToXml(const QString &targetFile) const = 0;
 
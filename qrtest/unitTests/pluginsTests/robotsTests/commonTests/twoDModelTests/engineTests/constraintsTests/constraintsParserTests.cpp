@@ -169,6 +169,111 @@ TEST_F(ConstraintsParserTests, timerWithoutDropTest)
 	ASSERT_TRUE(eventFired);
 }
 
+TEST_F(ConstraintsParserTests, timersTimeoutsTest)
+{
+	const QString xml =
+			"<constraints>"
+			"	<timelimit value=\"2000\"/>"
+			"	<event id=\"event\" dropsOnFire=\"false\">"
+			"		<conditions glue=\"or\">"
+			"			<timer timeout=\"1000\" forceDropOnTimeout=\"false\"/>"
+			"			<timer timeout=\"300\" forceDropOnTimeout=\"false\"/>"
+			"		</conditions>"
+			"		<trigger>"
+			"			<success/>"
+			"		</trigger>"
+			"	</event>"
+			"</constraints>";
+	ASSERT_TRUE(mParser.parse(xml));
+	Event * const event = mEvents["event"];
+	ASSERT_NE(event, nullptr);
+	ASSERT_FALSE(event->hasVolatileCondition());
+
+	// Timers are not started until the event is setted up.
+	ASSERT_EQ(-1, event->nextTimeout(0));
+
+	mTimeline.setTimestamp(100);
+	event->setUp();
+	ASSERT_EQ(400, event->nextTimeout(100));
+	ASSERT_EQ(1100, event->nextTimeout(400));
+	ASSERT_EQ(-1, event->nextTimeout(1100));
+}
+
+TEST_F(ConstraintsParserTests, volatileConditionsTest)
+{
+	auto testCase = [this](const QString &condition, bool isVolatile) {
+		mEvents.clear();
+		const QString xml = QString(
+				"<constraints>"
+				"	<timelimit value=\"2000\"/>"
+				"	<event id=\"event\" settedUpInitially=\"true\">"
+				"		<condition>"
+				"			%1"
+				"		</condition>"
+				"		<trigger>"
+				"			<setState object=\"testObject\" property=\"intProperty\">"
+				"				<objectState object=\"testObject.intProperty\"/>"
+				"			</setState>"
+				"		</trigger>"
+				"	</event>"
+				"</constraints>").arg(condition);
+		ASSERT_TRUE(mParser.parse(xml));
+		Event * const event = mEvents["event"];
+		ASSERT_NE(event, nullptr);
+		ASSERT_EQ(isVolatile, event->hasVolatileCondition());
+	};
+
+	// Objects are not volatile, checker tracks their reads with StatusReporter::objectRead().
+	testCase("<equals><variableValue name=\"x\"/><int value=\"1\"/></equals>", false);
+	testCase("<settedUp id=\"event\"/>", false);
+	testCase("<timer timeout=\"10\"/>", false);
+	testCase("<equals><objectState object=\"testObject.intProperty\"/><int value=\"1\"/></equals>", false);
+	testCase("<equals><variableValue name=\"x.y\"/><int value=\"1\"/></equals>", false);
+	testCase("<equals><typeOf objectId=\"testObject\"/><string value=\"\"/></equals>", false);
+	testCase("<using><setter name=\"x\"><int value=\"1\"/></setter>"
+			"<return><bool value=\"false\"/></return></using>", true);
+	testCase("<dropped id=\"unknownEvent\"/>", true);
+}
+
+TEST_F(ConstraintsParserTests, objectReadsTest)
+{
+	const QString xml =
+			"<constraints>"
+			"	<timelimit value=\"2000\"/>"
+			"	<event id=\"event\" settedUpInitially=\"true\">"
+			"		<conditions glue=\"and\">"
+			"			<equals>"
+			"				<variableValue name=\"x\"/>"
+			"				<int value=\"1\"/>"
+			"			</equals>"
+			"			<equals>"
+			"				<objectState object=\"testObject.intProperty\"/>"
+			"				<int value=\"1\"/>"
+			"			</equals>"
+			"		</conditions>"
+			"		<trigger>"
+			"			<success/>"
+			"		</trigger>"
+			"	</event>"
+			"</constraints>";
+	ASSERT_TRUE(mParser.parse(xml));
+	Event * const event = mEvents["event"];
+	ASSERT_NE(event, nullptr);
+	event->setUp();
+
+	QList<QObject *> reads;
+	ScopedConnection connection = QObject::connect(&mStatus, &StatusReporter::objectRead
+			, [&reads](QObject *object) { reads << object; });
+
+	// Short-circuited condition does not read the object.
+	ASSERT_FALSE(event->check());
+	ASSERT_TRUE(reads.isEmpty());
+
+	mVariables["x"] = 1;
+	ASSERT_FALSE(event->check());
+	ASSERT_EQ(QList<QObject *>({&mTestObject}), reads);
+}
+
 TEST_F(ConstraintsParserTests, timerWithDropTest)
 {
 	const QString xml =
@@ -555,6 +660,54 @@ TEST_F(ConstraintsParserTests, objectStateTest)
 	testCase("object.otherObject.pointProperty.y", "20", "int");
 }
 
+TEST_F(ConstraintsParserTests, objectStateRebindingTest)
+{
+	const QString xml =
+			"<constraints>"
+			"	<timelimit value=\"2000\"/>"
+			"	<event id=\"event\" settedUpInitially=\"true\">"
+			"		<condition>"
+			"			<equals>"
+			"				<objectState object=\"object.otherObject.intProperty\"/>"
+			"				<int value=\"2\"/>"
+			"			</equals>"
+			"		</condition>"
+			"		<trigger>"
+			"			<success/>"
+			"		</trigger>"
+			"	</event>"
+			"</constraints>";
+	ASSERT_TRUE(mParser.parse(xml));
+	Event * const event = mEvents["event"];
+	ASSERT_NE(event, nullptr);
+
+	bool eventFired = false;
+	ScopedConnection c = QObject::connect(event, &Event::fired, [&eventFired]() { eventFired = true; });
+
+	TestObjectB first;
+	first.otherObject()->setIntProperty(1);
+	TestObjectB second;
+	second.otherObject()->setIntProperty(2);
+
+	mObjects["object"] = &first;
+	event->check();
+	ASSERT_FALSE(eventFired);
+
+	// Object resolved on previous check must not be used after another object is bound with the same id.
+	mObjects["object"] = &second;
+	event->check();
+	ASSERT_TRUE(eventFired);
+
+	// The longest bound prefix of the path must be taken after new objects binding.
+	eventFired = false;
+	mObjects["object"] = &first;
+	TestObjectA other;
+	other.setIntProperty(2);
+	mObjects["object.otherObject"] = &other;
+	event->check();
+	ASSERT_TRUE(eventFired);
+}
+
 TEST_F(ConstraintsParserTests, setObjectStateTest)
 {
 	auto testCase = [this](const QString &object, const QString &property, const QString &valueXml) {
@@ -0,0 +1,100 @@
+/* Copyright 2018 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QElapsedTimer>
+#include <QtXml/QDomDocument>
+
+#include <Box2D/Box2D.h>
+#include <gtest/gtest.h>
+
+#include <kitBase/robotModel/robotParts/touchSensor.h>
+
+#include "twoDModel/engine/model/robotModel.h"
+#include "twoDModel/engine/model/settings.h"
+#include "twoDModel/engine/model/worldModel.h"
+#include "src/engine/model/physics/box2DPhysicsEngine.h"
+#include "src/robotModel/nullTwoDRobotModel.h"
+
+using namespace twoDModel::model;
+using namespace kitBase::robotModel;
+
+namespace {
+
+const PortInfo sensorPort("A1", input);
+
+/// Robot with two wheels and one port for a touch sensor.
+class TestRobotModel : public twoDModel::robotModel::NullTwoDRobotModel
+{
+public:
+	TestRobotModel()
+		: NullTwoDRobotModel("testRobot")
+	{
+		addAllowedConnection(sensorPort, { DeviceInfo::create<robotParts::TouchSensor>() });
+	}
+
+	QList<QPointF> wheelsPosition() const override
+	{
+		return { QPointF(0, 0), QPointF(0, 50) };
+	}
+};
+
+/// Lets queued initialization of the physics engine run.
+void processEvents()
+{
+	QElapsedTimer timer;
+	timer.start();
+	while (timer.elapsed() < 50) {
+		QCoreApplication::processEvents();
+	}
+}
+
+/// Puts a touch sensor to sensorPort of \a robot or clears that port if \a withSensor is false.
+void configureSensor(RobotModel &robot, bool withSensor)
+{
+	QDomDocument document;
+	QDomElement sensors = document.createElement("sensors");
+	QDomElement sensor = document.createElement("sensor");
+	sensors.appendChild(sensor);
+	sensor.setAttribute("port", sensorPort.toString());
+	sensor.setAttribute("type", withSensor ? DeviceInfo::create<robotParts::TouchSensor>().toString() : QString());
+	sensor.setAttribute("position", "75:25");
+	robot.configuration().deserialize(sensors);
+}
+
+}
+
+TEST(Box2DPhysicsEngineTest, headlessSensorBodiesTest)
+{
+	// Headless model has no sensor items, sensor bodies must follow the sensors configuration anyway.
+	WorldModel worldModel;
+	Settings settings;
+	TestRobotModel robotInfo;
+	RobotModel robot(robotInfo, settings);
+	physics::Box2DPhysicsEngine engine(worldModel, {});
+
+	engine.addRobot(&robot);
+	configureSensor(robot, true);
+	processEvents();
+	const int bodiesWithSensor = engine.box2DWorld().GetBodyCount();
+
+	configureSensor(robot, false);
+	ASSERT_EQ(bodiesWithSensor - 1, engine.box2DWorld().GetBodyCount());
+
+	configureSensor(robot, true);
+	ASSERT_EQ(bodiesWithSensor, engine.box2DWorld().GetBodyCount());
+
+	engine.removeRobot(&robot);
+	ASSERT_EQ(0, engine.box2DWorld().GetBodyCount());
+}
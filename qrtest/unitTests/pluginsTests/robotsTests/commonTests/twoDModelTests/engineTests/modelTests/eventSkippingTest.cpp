@@ -0,0 +1,145 @@
+/* Copyright 2018 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QScopedPointer>
+#include <QtXml/QDomDocument>
+
+#include <gtest/gtest.h>
+
+#include <twoDModel/engine/model/model.h>
+#include <utils/abstractTimer.h>
+
+#include <mocks/plugins/robots/common/kitBase/include/kitBase/robotModel/interpreterControlInterfaceMock.h>
+#include <mocks/qrgui/plugins/toolPluginInterface/usedInterfaces/errorReporterMock.h>
+
+using namespace twoDModel::model;
+using namespace qrTest;
+using ::testing::_;
+using ::testing::Invoke;
+using ::testing::NiceMock;
+
+namespace {
+
+const QString constraints =
+		"<root>"
+		"	<constraints>"
+		"		<timelimit value=\"5000\"/>"
+		"		<event id=\"first\" settedUpInitially=\"true\">"
+		"			<condition>"
+		"				<timer timeout=\"1234\"/>"
+		"			</condition>"
+		"			<triggers>"
+		"				<setter name=\"stage\">"
+		"					<int value=\"1\"/>"
+		"				</setter>"
+		"				<setUp id=\"second\"/>"
+		"			</triggers>"
+		"		</event>"
+		"		<event id=\"second\">"
+		"			<conditions glue=\"and\">"
+		"				<timer timeout=\"505\"/>"
+		"				<equals>"
+		"					<variableValue name=\"stage\"/>"
+		"					<int value=\"1\"/>"
+		"				</equals>"
+		"			</conditions>"
+		"			<trigger>"
+		"				<success/>"
+		"			</trigger>"
+		"		</event>"
+		"	</constraints>"
+		"</root>";
+
+/// What checker and trajectory reporter see during the run of the model.
+struct Report
+{
+	/// Messages of the program and the checker prefixed with timestamps.
+	QStringList messages;
+
+	/// Timestamps of all ticks including skipped ones.
+	QList<quint64> ticks;
+
+	/// Number of skipped ticks.
+	int idleTicks = 0;
+};
+
+/// Runs a program which sleeps on its timers and reacts through queued calls, like blocks do, in the model
+/// with constraints. Model time advances in fast-forward mode, idle ticks are skipped if \a eventSkipping is true.
+Report runModel(bool eventSkipping)
+{
+	Model model;
+	NiceMock<ErrorReporterMock> errorReporter;
+	NiceMock<InterpreterControlInterfaceMock> interpreterControl;
+	Timeline &timeline = model.timeline();
+	Report report;
+
+	const auto log = [&report, &timeline](const QString &message) {
+		report.messages << QString("%1: %2").arg(timeline.timestamp()).arg(message);
+	};
+
+	const auto logMessage = [&log](const QString &message, const qReal::Id &) { log(message); };
+	ON_CALL(errorReporter, addInformation(_, _)).WillByDefault(Invoke(logMessage));
+	ON_CALL(errorReporter, addError(_, _)).WillByDefault(Invoke(logMessage));
+	ON_CALL(interpreterControl, stopRobot(_)).WillByDefault(Invoke([&timeline](
+			qReal::interpretation::StopReason reason) { timeline.stop(reason); }));
+
+	model.init(errorReporter, interpreterControl);
+	QDomDocument document;
+	document.setContent(constraints);
+	model.deserialize(document, QDomDocument());
+
+	QObject::connect(&timeline, &Timeline::tick, [&report, &timeline]() { report.ticks << timeline.timestamp(); });
+	QObject::connect(&timeline, &Timeline::idleTick, [&report, &timeline]() {
+		report.ticks << timeline.timestamp();
+		++report.idleTicks;
+	});
+
+	QObject context;
+	QScopedPointer<utils::AbstractTimer> timer(timeline.produceTimer());
+	const QList<int> intervals = { 0, 300, 15, 1000, 7 };
+	int step = 0;
+	QObject::connect(timer.data(), &utils::AbstractTimer::timeout, &context, [&]() {
+		log(QString("step %1").arg(step));
+		++step;
+		if (step < intervals.size()) {
+			timer->start(intervals[step]);
+		}
+	}, Qt::QueuedConnection);
+
+	timeline.setFastForwardMode(true);
+	model.setEventSkipping(eventSkipping);
+	timer->start(intervals.first());
+	timeline.start();
+	while (timeline.isStarted()) {
+		QCoreApplication::processEvents();
+	}
+
+	return report;
+}
+
+}
+
+TEST(EventSkippingTest, sameReportTest)
+{
+	// Checker and trajectory must not notice that nothing was computed on idle ticks.
+	const Report stepByStep = runModel(false);
+	const Report skipping = runModel(true);
+
+	ASSERT_EQ(0, stepByStep.idleTicks);
+	ASSERT_GT(skipping.idleTicks, 0);
+	ASSERT_EQ(stepByStep.messages, skipping.messages);
+	ASSERT_EQ(stepByStep.ticks, skipping.ticks);
+	ASSERT_TRUE(stepByStep.messages.last().endsWith("The task is accomplished!"));
+}
@@ -0,0 +1,108 @@
+/* Copyright 2018 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include <gtest/gtest.h>
+
+#include "src/engine/model/robotTrace.h"
+
+using namespace twoDModel::model;
+
+namespace {
+
+QList<QLineF> segments(const RobotTrace &trace)
+{
+	QList<QLineF> result;
+	trace.iterate([&result](const QVariant &segment) { result << segment.value<QLineF>(); });
+	return result;
+}
+
+}
+
+TEST(RobotTraceTest, joiningTest)
+{
+	RobotTrace trace;
+	const QPen red(Qt::red);
+	const QPen blue(Qt::blue);
+
+	trace.append(red, QPointF(0, 0), QPointF(10, 0));
+	trace.append(red, QPointF(10, 0), QPointF(10, 10));
+	// Two markers draw at the same time, both polylines must be continued.
+	trace.append(blue, QPointF(100, 100), QPointF(110, 100));
+	trace.append(red, QPointF(10, 10), QPointF(0, 10));
+	trace.append(blue, QPointF(110, 100), QPointF(110, 110));
+	// Gap in a trace starts a new polyline.
+	trace.append(red, QPointF(50, 50), QPointF(60, 60));
+
+	ASSERT_EQ(3, trace.polylines().size());
+	ASSERT_EQ(4, trace.polylines()[0].chunks.first().points.size());
+	ASSERT_EQ(3, trace.polylines()[1].chunks.first().points.size());
+	ASSERT_EQ(2, trace.polylines()[2].chunks.first().points.size());
+
+	ASSERT_EQ(6, trace.size());
+	ASSERT_FALSE(trace.isEmpty());
+	ASSERT_EQ(QLineF(0, 0, 10, 0), trace.first().value<QLineF>());
+	ASSERT_EQ(QLineF(50, 50, 60, 60), trace.last().value<QLineF>());
+	ASSERT_EQ(6, segments(trace).size());
+	ASSERT_EQ(QLineF(10, 10, 0, 10), segments(trace)[2]);
+}
+
+TEST(RobotTraceTest, chunksTest)
+{
+	RobotTrace trace;
+	const QPen pen(Qt::black, 6);
+	const int count = 3 * RobotTrace::chunkSize;
+	for (int i = 0; i < count; ++i) {
+		trace.append(pen, QPointF(i, i % 2), QPointF(i + 1, (i + 1) % 2));
+	}
+
+	ASSERT_EQ(1, trace.polylines().size());
+	const QVector<RobotTrace::Chunk> &chunks = trace.polylines().first().chunks;
+	ASSERT_EQ(4, chunks.size());
+	for (int i = 1; i < chunks.size(); ++i) {
+		// Neighbouring chunks share their boundary point, so nothing is lost between them.
+		ASSERT_EQ(chunks[i - 1].points.last(), chunks[i].points.first());
+		ASSERT_LE(chunks[i].points.size(), RobotTrace::chunkSize);
+	}
+
+	const QList<QLineF> lines = segments(trace);
+	ASSERT_EQ(count, lines.size());
+	for (int i = 0; i < count; ++i) {
+		ASSERT_EQ(QLineF(i, i % 2, i + 1, (i + 1) % 2), lines[i]);
+	}
+
+	ASSERT_EQ(QRectF(0, 0, count, 1), chunks.first().bounds.united(chunks.last().bounds).united(chunks[1].bounds)
+			.united(chunks[2].bounds));
+	ASSERT_TRUE(trace.boundingRect().contains(QRectF(-3, -3, count + 6, 7)));
+}
+
+TEST(RobotTraceTest, clearTest)
+{
+	RobotTrace trace;
+	const QRectF painted = trace.append(QPen(Qt::black, 2), QPointF(0, 0), QPointF(10, 20));
+	ASSERT_TRUE(painted.contains(QRectF(0, 0, 10, 20)));
+	ASSERT_EQ(painted, trace.boundingRect());
+
+	trace.clear();
+	ASSERT_TRUE(trace.isEmpty());
+	ASSERT_EQ(0, trace.size());
+	ASSERT_TRUE(trace.polylines().isEmpty());
+	ASSERT_TRUE(trace.boundingRect().isEmpty());
+	ASSERT_FALSE(trace.first().isValid());
+	ASSERT_FALSE(trace.last().isValid());
+
+	// Cleared trace is not continued.
+	trace.append(QPen(Qt::black, 2), QPointF(10, 20), QPointF(0, 0));
+	ASSERT_EQ(1, trace.polylines().size());
+	ASSERT_EQ(1, trace.size());
+}
@@ -0,0 +1,146 @@
+/* Copyright 2018 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include <limits>
+
+#include <QtCore/qmath.h>
+
+#include <gtest/gtest.h>
+
+#include "twoDModel/engine/model/worldModel.h"
+#include "src/engine/items/wallItem.h"
+#include "src/engine/model/sectorCaster.h"
+
+using namespace twoDModel;
+using namespace twoDModel::model;
+
+namespace {
+
+/// Range reading as it was computed before SectorCaster: binary search of the least distance in centimeters
+/// at which sector-shaped scanning region intersects united path of obstacles.
+int pathRangeReading(const WorldModel &model, const QPainterPath &obstacles
+		, const QPointF &position, qreal direction, int maxDistance, qreal maxAngle)
+{
+	const auto touches = [&](int distance) {
+		return model.rangeSensorScanningRegion(position, direction
+				, QPair<qreal, int>(maxAngle, distance)).intersects(obstacles);
+	};
+
+	if (!touches(maxDistance)) {
+		return maxDistance;
+	}
+
+	int minRange = 0;
+	int maxRange = maxDistance;
+	while (minRange < maxRange) {
+		const int currentRange = (minRange + maxRange) / 2;
+		if (touches(currentRange)) {
+			maxRange = currentRange;
+		} else {
+			minRange = currentRange + 1;
+		}
+	}
+
+	return minRange;
+}
+
+/// Compares readings of the model with the path-based ones for sensors placed on a grid, looking in all
+/// directions with a set of scanning angles. Sector arcs are approximated with curves in the old method,
+/// so readings may differ by one centimeter.
+void checkLayout(const QList<QLineF> &layout)
+{
+	WorldModel model;
+	QList<items::WallItem *> walls;
+	QPainterPath obstacles;
+	for (const QLineF &line : layout) {
+		items::WallItem * const wall = new items::WallItem(line.p1(), line.p2());
+		model.addWall(wall);
+		obstacles.addPath(wall->path());
+		walls << wall;
+	}
+
+	const int maxDistance = 255;
+	for (int x = -250; x <= 250; x += 125) {
+		for (int y = -250; y <= 250; y += 125) {
+			for (qreal direction = 0; direction < 360; direction += 22.5) {
+				for (const qreal angle : {10.0, 45.0, 90.0, 360.0}) {
+					const QPointF position(x, y);
+					const int expected = pathRangeReading(model, obstacles, position, direction, maxDistance, angle);
+					const int actual = model.rangeReading(position, direction, maxDistance, angle);
+					ASSERT_LE(qAbs(expected - actual), 1) << "position " << x << ":" << y
+							<< ", direction " << direction << ", angle " << angle;
+				}
+			}
+		}
+	}
+
+	qDeleteAll(walls);
+}
+
+}
+
+TEST(SectorCasterTest, segmentTest)
+{
+	// Perpendicular foot inside the sector.
+	SectorCaster foot(QPointF(0, 0), 0, 90);
+	foot.cast(QPolygonF() << QPointF(10, -100) << QPointF(10, 100));
+	ASSERT_NEAR(10, foot.distance(), 1e-9);
+
+	// Segment end is the nearest point inside the sector.
+	SectorCaster end(QPointF(0, 0), 0, 90);
+	end.cast(QPolygonF() << QPointF(10, 5) << QPointF(10, 100));
+	ASSERT_NEAR(qSqrt(125), end.distance(), 1e-9);
+
+	// Segment crosses the side of the sector, the crossing point is the nearest one.
+	SectorCaster side(QPointF(0, 0), 0, 90);
+	side.cast(QPolygonF() << QPointF(20, 30) << QPointF(40, 30));
+	ASSERT_NEAR(30 * qSqrt(2), side.distance(), 1e-9);
+
+	// Segment is entirely outside the sector.
+	SectorCaster outside(QPointF(0, 0), 0, 90);
+	outside.cast(QPolygonF() << QPointF(-10, -100) << QPointF(-10, 100));
+	ASSERT_EQ(std::numeric_limits<qreal>::infinity(), outside.distance());
+
+	// Full circle sees everything around.
+	SectorCaster circle(QPointF(0, 0), 0, 360);
+	circle.cast(QPolygonF() << QPointF(-10, -100) << QPointF(-10, 100));
+	ASSERT_NEAR(10, circle.distance(), 1e-9);
+
+	// Apex inside an obstacle.
+	SectorCaster inside(QPointF(0, 0), 0, 10);
+	inside.cast(QPolygonF() << QPointF(-5, -5) << QPointF(5, -5) << QPointF(5, 5) << QPointF(-5, 5));
+	ASSERT_EQ(0, inside.distance());
+}
+
+TEST(SectorCasterTest, singleWallTest)
+{
+	checkLayout({QLineF(100, -300, 100, 300)});
+}
+
+TEST(SectorCasterTest, roomTest)
+{
+	checkLayout({QLineF(-320, -320, 320, -320), QLineF(320, -320, 320, 320)
+			, QLineF(320, 320, -320, 320), QLineF(-320, 320, -320, -320)});
+}
+
+TEST(SectorCasterTest, scatteredWallsTest)
+{
+	QList<QLineF> layout;
+	for (int i = 0; i < 12; ++i) {
+		const QPointF begin((i * 137) % 600 - 300, (i * 251) % 600 - 300);
+		layout << QLineF(begin, begin + QPointF((i * 53) % 200 - 100, (i * 89) % 160 - 80));
+	}
+
+	checkLayout(layout);
+}
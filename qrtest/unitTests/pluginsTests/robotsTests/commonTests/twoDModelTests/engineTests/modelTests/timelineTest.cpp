@@ -0,0 +1,216 @@
+/* Copyright 2018 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include <limits>
+
+#include <QtCore/QAtomicInt>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QEventLoop>
+#include <QtCore/QScopedPointer>
+#include <QtCore/QThread>
+
+#include <gtest/gtest.h>
+
+#include <twoDModel/engine/model/timeline.h>
+#include <utils/abstractTimer.h>
+
+using namespace twoDModel::model;
+
+namespace {
+
+/// Runs \a timeline in fast-forward mode till somebody stops it.
+void run(Timeline &timeline)
+{
+	timeline.setFastForwardMode(true);
+	timeline.start();
+	while (timeline.isStarted()) {
+		QCoreApplication::processEvents();
+	}
+}
+
+/// Program thread which computes something before it waits for its first timer, like a script does.
+class ProgramThread : public QThread
+{
+public:
+	explicit ProgramThread(Timeline &timeline)
+		: mTimeline(timeline)
+	{
+	}
+
+	/// Becomes true right before the thread waits for its timer for the first time.
+	QAtomicInt waited;
+
+protected:
+	void run() override
+	{
+		msleep(50);
+
+		utils::AbstractTimer *timer = mTimeline.produceTimer();
+		QEventLoop loop;
+		QObject::connect(timer, &utils::AbstractTimer::timeout, &loop, &QEventLoop::quit);
+		waited.store(1);
+		mTimeline.beginWaiting(timer);
+		timer->start(100);
+		loop.exec();
+		mTimeline.endWaiting();
+		timer->deleteLater();
+	}
+
+private:
+	Timeline &mTimeline;
+};
+
+/// Runs a program which reacts on its timers through queued calls, like blocks do, and returns timestamps of
+/// its steps. Timeline advances in fast-forward mode if \a fastForward is true and tick by tick otherwise.
+QList<quint64> runQueuedProgram(bool fastForward)
+{
+	Timeline timeline;
+	QObject context;
+	QScopedPointer<utils::AbstractTimer> timer(timeline.produceTimer());
+	const QList<int> intervals = { 0, 7, 15, 0, 30, 1, 0, 100, 5 };
+	QList<quint64> steps;
+	QObject::connect(timer.data(), &utils::AbstractTimer::timeout, &context, [&]() {
+		steps << timeline.timestamp();
+		if (steps.size() < intervals.size()) {
+			timer->start(intervals[steps.size()]);
+		} else {
+			timeline.stop(qReal::interpretation::StopReason::finised);
+		}
+	}, Qt::QueuedConnection);
+
+	if (fastForward) {
+		timeline.setFastForwardMode(true);
+	} else {
+		timeline.setImmediateMode(true);
+	}
+
+	timer->start(intervals.first());
+	timeline.start();
+	while (timeline.isStarted()) {
+		QCoreApplication::processEvents();
+	}
+
+	return steps;
+}
+
+}
+
+TEST(TimelineTest, timersOrderTest)
+{
+	Timeline timeline;
+	QList<QPair<quint64, QString>> fired;
+	const auto produce = [&timeline, &fired](const QString &name) {
+		utils::AbstractTimer *timer = timeline.produceTimer();
+		QObject::connect(timer, &utils::AbstractTimer::timeout, [&timeline, &fired, name]() {
+			fired << qMakePair(timeline.timestamp(), name);
+		});
+		return timer;
+	};
+
+	// Timers must fire on the same ticks and in the same order as when each of them counted ticks itself.
+	QScopedPointer<utils::AbstractTimer> a(produce("a"));
+	QScopedPointer<utils::AbstractTimer> b(produce("b"));
+	QScopedPointer<utils::AbstractTimer> c(produce("c"));
+	QScopedPointer<utils::AbstractTimer> d(produce("d"));
+	QScopedPointer<utils::AbstractTimer> stopped(produce("stopped"));
+	QScopedPointer<utils::AbstractTimer> finish(produce("finish"));
+	QObject::connect(finish.data(), &utils::AbstractTimer::timeout, [&timeline]() {
+		timeline.stop(qReal::interpretation::StopReason::finised);
+	});
+
+	d->setRepeatable(true);
+	d->start(30);
+	a->start(25);
+	b->start(20);
+	c->start(0);
+	stopped->start(50);
+	finish->start(100);
+	stopped->stop();
+
+	run(timeline);
+
+	const QList<QPair<quint64, QString>> expected = {
+		{10, "c"}, {20, "b"}, {30, "a"}, {30, "d"}, {60, "d"}, {90, "d"}, {100, "finish"}
+	};
+
+	ASSERT_EQ(expected, fired);
+	ASSERT_TRUE(d->isTicking());
+	ASSERT_FALSE(a->isTicking());
+}
+
+TEST(TimelineTest, resetTest)
+{
+	Timeline timeline;
+	QScopedPointer<utils::AbstractTimer> first(timeline.produceTimer());
+	QScopedPointer<utils::AbstractTimer> second(timeline.produceTimer());
+	QObject::connect(first.data(), &utils::AbstractTimer::timeout, [&timeline]() {
+		timeline.stop(qReal::interpretation::StopReason::finised);
+	});
+
+	quint64 secondTimestamp = 0;
+	QObject::connect(second.data(), &utils::AbstractTimer::timeout, [&timeline, &secondTimestamp]() {
+		secondTimestamp = timeline.timestamp();
+		timeline.stop(qReal::interpretation::StopReason::finised);
+	});
+
+	first->start(40);
+	second->start(100);
+	run(timeline);
+	ASSERT_EQ(static_cast<quint64>(40), timeline.timestamp());
+
+	// Waiting timers keep the rest of their time when model time returns to zero.
+	timeline.reset();
+	run(timeline);
+	ASSERT_EQ(static_cast<quint64>(60), secondTimestamp);
+}
+
+TEST(TimelineTest, fastForwardTimestampsTest)
+{
+	// Queued reactions of the program must happen on the same model ticks no matter how fast the host is.
+	const QList<quint64> stepByStep = runQueuedProgram(false);
+	const QList<quint64> fastForward = runQueuedProgram(true);
+	ASSERT_EQ(9, stepByStep.size());
+	ASSERT_EQ(stepByStep, fastForward);
+}
+
+TEST(TimelineTest, startingThreadTest)
+{
+	// Program thread may act at any moment after it is started, ticks must not be skipped before it waits.
+	Timeline timeline;
+	timeline.setIdleTicksSkipping([]() { return std::numeric_limits<quint64>::max(); });
+	ProgramThread program(timeline);
+	int idleTicks = 0;
+	bool skippedWhileWorking = false;
+	QObject::connect(&timeline, &Timeline::idleTick, [&]() {
+		++idleTicks;
+		skippedWhileWorking |= program.waited.load() == 0;
+	});
+
+	QObject::connect(&program, &QThread::finished, &timeline, [&timeline]() {
+		timeline.stop(qReal::interpretation::StopReason::finised);
+	});
+
+	timeline.setFastForwardMode(true);
+	timeline.start();
+	timeline.expectThread();
+	program.start();
+	while (timeline.isStarted()) {
+		QCoreApplication::processEvents();
+	}
+
+	program.wait();
+	ASSERT_FALSE(skippedWhileWorking);
+	ASSERT_EQ(1, program.waited.load());
+	ASSERT_GT(idleTicks, 0);
+}
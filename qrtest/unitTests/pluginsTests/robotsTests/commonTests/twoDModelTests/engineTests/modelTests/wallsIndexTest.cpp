@@ -0,0 +1,156 @@
+/* Copyright 2018 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include <gtest/gtest.h>
+
+#include "src/engine/items/wallItem.h"
+#include "src/engine/model/wallsIndex.h"
+
+using namespace twoDModel;
+using namespace twoDModel::model;
+
+namespace {
+
+/// Pseudo-random but reproducible wall layout: long and short walls of all directions spread over
+/// several grid cells, including the ones with negative coordinates.
+QList<items::WallItem *> createWalls(int count)
+{
+	QList<items::WallItem *> result;
+	for (int i = 0; i < count; ++i) {
+		const QPointF begin((i * 137) % 1100 - 300, (i * 251) % 900 - 200);
+		const QPointF end(begin.x() + (i * 53) % 400 - 200, begin.y() + (i * 89) % 300 - 150);
+		result << new items::WallItem(begin, end);
+	}
+
+	return result;
+}
+
+/// Areas of different size that partially overlap the walls, lie between them or cover the whole world.
+QList<QRectF> queryAreas()
+{
+	QList<QRectF> result;
+	for (int i = 0; i < 50; ++i) {
+		const qreal size = 5 + (i * 29) % 250;
+		result << QRectF((i * 173) % 1300 - 400, (i * 97) % 1100 - 300, size, size / 2 + 1);
+	}
+
+	result << QRectF(-1000, -1000, 3000, 3000) << QRectF(10000, 10000, 10, 10);
+	return result;
+}
+
+/// Brute-force scan over all walls: walls that really intersect \a area.
+QSet<items::WallItem *> intersectingWalls(const QList<items::WallItem *> &walls, const QRectF &area)
+{
+	QSet<items::WallItem *> result;
+	for (items::WallItem * const wall : walls) {
+		if (wall->path().intersects(area)) {
+			result << wall;
+		}
+	}
+
+	return result;
+}
+
+QPainterPath unitedPath(const QList<items::WallItem *> &walls)
+{
+	QPainterPath result;
+	for (items::WallItem * const wall : walls) {
+		result.addPath(wall->path());
+	}
+
+	return result;
+}
+
+/// Checks that the index returns every wall found by brute force and returns each candidate only once.
+void checkAgainstBruteForce(WallsIndex &index, const QList<items::WallItem *> &walls)
+{
+	const QPainterPath allWalls = unitedPath(walls);
+	for (const QRectF &area : queryAreas()) {
+		const QList<items::WallItem *> candidates = index.walls(area);
+		const QSet<items::WallItem *> candidatesSet = candidates.toSet();
+		ASSERT_EQ(candidates.size(), candidatesSet.size());
+		ASSERT_TRUE(candidatesSet.contains(intersectingWalls(walls, area)));
+		QList<QPolygonF> polygons;
+		for (items::WallItem * const wall : candidates) {
+			ASSERT_TRUE(walls.contains(wall));
+			ASSERT_TRUE(wall->path().boundingRect().intersects(area.adjusted(-2, -2, 2, 2)));
+			polygons << wall->path().toSubpathPolygons();
+		}
+
+		ASSERT_EQ(allWalls.intersects(area), index.path(area).intersects(area));
+		ASSERT_EQ(polygons, index.polygons(area));
+	}
+}
+
+}
+
+TEST(WallsIndexTest, queriesMatchBruteForceTest)
+{
+	const QList<items::WallItem *> walls = createWalls(200);
+	WallsIndex index;
+	for (items::WallItem * const wall : walls) {
+		index.insert(wall);
+	}
+
+	checkAgainstBruteForce(index, walls);
+	qDeleteAll(walls);
+}
+
+TEST(WallsIndexTest, movedWallsTest)
+{
+	const QList<items::WallItem *> walls = createWalls(100);
+	WallsIndex index(50);
+	for (items::WallItem * const wall : walls) {
+		index.insert(wall);
+	}
+
+	checkAgainstBruteForce(index, walls);
+
+	// Moves every third wall to other cells, index must re-read its geometry only after invalidation.
+	for (int i = 0; i < walls.size(); i += 3) {
+		walls[i]->setCoordinates(QRectF(QPointF((i * 71) % 800 - 100, (i * 43) % 600), QSizeF(120, -(i % 90))));
+		index.invalidate(walls[i]);
+	}
+
+	checkAgainstBruteForce(index, walls);
+	qDeleteAll(walls);
+}
+
+TEST(WallsIndexTest, removedWallsTest)
+{
+	QList<items::WallItem *> walls = createWalls(100);
+	WallsIndex index;
+	for (items::WallItem * const wall : walls) {
+		index.insert(wall);
+	}
+
+	QList<items::WallItem *> removed;
+	for (int i = walls.size() - 1; i >= 0; i -= 2) {
+		// Invalidated but not yet re-indexed walls must be forgotten too.
+		index.invalidate(walls[i]);
+		index.remove(walls[i]);
+		removed << walls.takeAt(i);
+	}
+
+	checkAgainstBruteForce(index, walls);
+	for (items::WallItem * const wall : removed) {
+		ASSERT_FALSE(index.walls(wall->path().boundingRect()).contains(wall));
+	}
+
+	index.clear();
+	ASSERT_TRUE(index.walls(QRectF(-1000, -1000, 3000, 3000)).isEmpty());
+
+	qDeleteAll(walls);
+	qDeleteAll(removed);
+}
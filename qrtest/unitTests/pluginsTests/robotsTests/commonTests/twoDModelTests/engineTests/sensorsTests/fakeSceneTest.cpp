@@ -0,0 +1,81 @@
+/* Copyright 2018 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include <gtest/gtest.h>
+
+#include "twoDModel/engine/model/worldModel.h"
+#include "src/engine/items/rectangleItem.h"
+#include "src/engine/items/wallItem.h"
+#include "src/engine/view/scene/fakeScene.h"
+
+using namespace twoDModel;
+using namespace twoDModel::view;
+
+namespace {
+
+/// Area spanning several tiles on both sides of the scene origin.
+const QRect area(-200, -150, 500, 400);
+
+/// Checks that the floor sampled from cached tiles is the same as the one rendered directly without the cache.
+/// Sampling also fills the cache, so the next check fails if some change does not drop outdated tiles.
+void checkSample(FakeScene &scene)
+{
+	const QPointF center(area.left() + area.width() / 2.0, area.top() + area.height() / 2.0);
+	ASSERT_EQ(scene.render(area), scene.sample(center, 0, area.size()));
+}
+
+}
+
+TEST(FakeSceneTest, colorFieldTest)
+{
+	model::WorldModel world;
+	FakeScene scene(world);
+	checkSample(scene);
+
+	items::RectangleItem rectangle(QPointF(-50, -40), QPointF(60, 70));
+	rectangle.setFilled(true);
+	rectangle.setColor(Qt::red);
+	world.addColorField(&rectangle);
+	checkSample(scene);
+
+	// Moving the item to other tiles must refresh both the tiles it left and the ones it came to.
+	rectangle.setCoordinates(QRectF(QPointF(120, 100), QPointF(250, 200)));
+	checkSample(scene);
+
+	rectangle.setColor(Qt::green);
+	checkSample(scene);
+
+	rectangle.setThickness(12);
+	checkSample(scene);
+
+	world.removeColorField(&rectangle);
+	checkSample(scene);
+}
+
+TEST(FakeSceneTest, wallTest)
+{
+	model::WorldModel world;
+	FakeScene scene(world);
+	checkSample(scene);
+
+	items::WallItem wall(QPointF(-100, 0), QPointF(200, 0));
+	world.addWall(&wall);
+	checkSample(scene);
+
+	wall.setCoordinates(QRectF(QPointF(0, -120), QPointF(0, 220)));
+	checkSample(scene);
+
+	world.removeWall(&wall);
+	checkSample(scene);
+}
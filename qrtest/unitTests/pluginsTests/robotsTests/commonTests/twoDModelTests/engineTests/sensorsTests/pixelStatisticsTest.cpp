@@ -0,0 +1,167 @@
+/* Copyright 2018 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QHash>
+#include <QtCore/QDebug>
+
+#include <gtest/gtest.h>
+
+#include <twoDModel/engine/model/pixelStatistics.h>
+
+using namespace twoDModel::model;
+
+namespace {
+
+/// Pseudo-random image where palette colors, close to black colors and arbitrary colors are mixed.
+QVector<QRgb> testImage(int size)
+{
+	QVector<QRgb> result(size);
+	quint32 seed = 239;
+	for (int i = 0; i < size; ++i) {
+		seed = seed * 1103515245 + 12345;
+		switch ((seed >> 16) % 3) {
+		case 0:
+			result[i] = PixelStatistics::palette()[(seed >> 8) % PixelStatistics::paletteSize];
+			break;
+		case 1:
+			result[i] = qRgb((seed >> 4) & 0x0F, (seed >> 8) & 0x0F, (seed >> 12) & 0x0F);
+			break;
+		default:
+			result[i] = seed;
+		}
+	}
+
+	return result;
+}
+
+/// Straightforward per-pixel reference implementations of the kernels, as sensors used to compute them.
+quint64 referenceBrightnessSum(const QVector<QRgb> &pixels)
+{
+	quint64 sum = 0;
+	for (const QRgb color : pixels) {
+		sum += static_cast<uint>(0.2126 * qRed(color) + 0.7152 * qGreen(color) + 0.0722 * qBlue(color));
+	}
+
+	return sum;
+}
+
+QHash<uint, int> referenceHistogram(const QVector<QRgb> &pixels)
+{
+	QHash<uint, int> result;
+	for (const QRgb color : pixels) {
+		++result[color];
+	}
+
+	return result;
+}
+
+int referenceCloseColorsCount(const QVector<QRgb> &pixels, QRgb sample, int tolerance, qint64 &indicesSum)
+{
+	int result = 0;
+	indicesSum = 0;
+	for (int i = 0; i < pixels.size(); ++i) {
+		const QRgb color = pixels[i];
+		if (qAlpha(color) > 0 && qMax(qAbs(qRed(color) - qRed(sample))
+				, qMax(qAbs(qGreen(color) - qGreen(sample)), qAbs(qBlue(color) - qBlue(sample)))) < tolerance) {
+			++result;
+			indicesSum += i;
+		}
+	}
+
+	return result;
+}
+
+}
+
+TEST(PixelStatisticsTest, brightnessSumTest)
+{
+	// Odd sizes check that vectorized part and its tail agree.
+	for (const int size : {0, 1, 3, 4, 7, 1001, 100003}) {
+		const QVector<QRgb> image = testImage(size);
+		ASSERT_EQ(referenceBrightnessSum(image), PixelStatistics::brightnessSum(image.constData(), size));
+	}
+}
+
+TEST(PixelStatisticsTest, paletteHistogramTest)
+{
+	for (const int size : {0, 5, 1001, 100003}) {
+		const QVector<QRgb> image = testImage(size);
+		const QHash<uint, int> reference = referenceHistogram(image);
+		const QVector<int> histogram = PixelStatistics::paletteHistogram(image.constData(), size);
+		ASSERT_EQ(PixelStatistics::paletteSize + 1, histogram.size());
+
+		int others = size;
+		for (int i = 0; i < PixelStatistics::paletteSize; ++i) {
+			const int count = reference.value(PixelStatistics::palette()[i]);
+			ASSERT_EQ(count, histogram[i]);
+			others -= count;
+		}
+
+		ASSERT_EQ(others, histogram[PixelStatistics::paletteSize]);
+	}
+}
+
+TEST(PixelStatisticsTest, closeColorsCountTest)
+{
+	for (const int size : {0, 2, 9, 1001, 100003}) {
+		const QVector<QRgb> image = testImage(size);
+		for (const int tolerance : {0, 1, 10, 300}) {
+			qint64 referenceIndicesSum = 0;
+			qint64 indicesSum = 0;
+			const QRgb sample = qRgb(5, 5, 5);
+			ASSERT_EQ(referenceCloseColorsCount(image, sample, tolerance, referenceIndicesSum)
+					, PixelStatistics::closeColorsCount(image.constData(), size, sample, tolerance, indicesSum));
+			ASSERT_EQ(referenceIndicesSum, indicesSum);
+		}
+	}
+}
+
+TEST(PixelStatisticsTest, averageColorTest)
+{
+	const QVector<QRgb> image = { qRgb(10, 20, 30), qRgb(20, 40, 60), qRgba(255, 255, 255, 0) };
+	ASSERT_EQ(qRgb(15, 30, 45), PixelStatistics::averageColor(image.constData(), image.size()));
+	ASSERT_EQ(qRgb(255, 255, 255), PixelStatistics::averageColor(image.constData(), 0));
+}
+
+/// Benchmark, not a test: it is disabled and is run explicitly with --gtest_also_run_disabled_tests.
+TEST(PixelStatisticsTest, DISABLED_kernelsBenchmark)
+{
+	// Sensor images are small, so benchmark reads the same image many times like a checker run does.
+	const int size = 40 * 40;
+	const int iterations = 2000;
+	const QVector<QRgb> image = testImage(size);
+
+	QElapsedTimer timer;
+	quint64 checksum = 0;
+
+	timer.start();
+	for (int i = 0; i < iterations; ++i) {
+		checksum += referenceBrightnessSum(image);
+		checksum += referenceHistogram(image).value(PixelStatistics::palette()[0]);
+	}
+
+	const qint64 referenceTime = timer.elapsed();
+
+	timer.restart();
+	for (int i = 0; i < iterations; ++i) {
+		checksum -= PixelStatistics::brightnessSum(image.constData(), size);
+		checksum -= PixelStatistics::paletteHistogram(image.constData(), size)[0];
+	}
+
+	const qint64 kernelsTime = timer.elapsed();
+
+	ASSERT_EQ(static_cast<quint64>(0), checksum);
+	qDebug() << "Per-pixel loops:" << referenceTime << "ms, kernels:" << kernelsTime << "ms";
+}
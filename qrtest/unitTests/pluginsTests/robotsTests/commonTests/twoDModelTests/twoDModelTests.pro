@@ -30,11 +30,21 @@ HEADERS += \
 
 SOURCES += \
 	$$PWD/engineTests/constraintsTests/constraintsParserTests.cpp \
+	$$PWD/engineTests/modelTests/box2DPhysicsEngineTest.cpp \
+	$$PWD/engineTests/modelTests/eventSkippingTest.cpp \
+	$$PWD/engineTests/modelTests/robotTraceTest.cpp \
+	$$PWD/engineTests/modelTests/sectorCasterTest.cpp \
+	$$PWD/engineTests/modelTests/timelineTest.cpp \
+	$$PWD/engineTests/modelTests/wallsIndexTest.cpp \
+	$$PWD/engineTests/sensorsTests/fakeSceneTest.cpp \
+	$$PWD/engineTests/sensorsTests/pixelStatisticsTest.cpp \
 
 # Support classes
 HEADERS += \
 	$$PWD/support/testTimeline.h \
 	$$PWD/support/testObject.h \
+	$$PWD/../../../../mocks/plugins/robots/common/kitBase/include/kitBase/robotModel/interpreterControlInterfaceMock.h \
+	$$PWD/../../../../mocks/qrgui/plugins/toolPluginInterface/usedInterfaces/errorReporterMock.h \
 
 SOURCES += \
 	$$PWD/support/testTimeline.cpp \
@@ -162,3 +162,25 @@ TEST(IdsTest, idInputOutputStreamTest) {
 
 	EXPECT_EQ(in, out);
 }
+
+TEST(IdsTest, internedIdsTest) {
+	const Id generated = Id::createElementId("editor", "diagram", "element");
+	const Id loaded = Id::loadFromString(generated.toString());
+	EXPECT_EQ(loaded, generated);
+	EXPECT_EQ(qHash(loaded), qHash(generated));
+	EXPECT_EQ(loaded.id(), QUuid(generated.id()).toString());
+
+	const Id upperCase("editor", "diagram", "element", generated.id().toUpper());
+	EXPECT_NE(upperCase, generated);
+	EXPECT_EQ(upperCase.id(), generated.id().toUpper());
+
+	const Id first("editor", "diagram", "element", "{00000000-0000-0000-0000-00000000000a}");
+	const Id second("editor", "diagram", "element", "{00000000-0000-0000-0000-0000000000a0}");
+	const Id named("editor", "diagram", "element", "named");
+	EXPECT_TRUE(first < second);
+	EXPECT_FALSE(second < first);
+	EXPECT_TRUE(second < named);
+	EXPECT_FALSE(named < first);
+	EXPECT_TRUE(generated.type() < generated);
+	EXPECT_EQ(generated.type(), Id("editor", "diagram", "element"));
+}
@@ -16,6 +16,7 @@
 
 #include <QtCore/QFile>
 #include <QtCore/QDir>
+#include <QtCore/QElapsedTimer>
 
 #include <qrrepo/private/classes/logicalObject.h>
 #include <qrkernel/exception/exception.h>
@@ -48,6 +49,30 @@ const Id notExistingId("1", "1", "1", "1");
 const Id newId1("editor1", "diagram1", "element1", "id1");
 const Id newId2("editor2", "diagram2", "element2", "id2");
 
+namespace {
+
+/// Id as it was stored before interning, used as a reference in benchmark: all four parts are hashed and compared
+/// on every lookup.
+struct StringId
+{
+	QString editor;
+	QString diagram;
+	QString element;
+	QString id;
+};
+
+bool operator==(const StringId &i1, const StringId &i2)
+{
+	return i1.editor == i2.editor && i1.diagram == i2.diagram && i1.element == i2.element && i1.id == i2.id;
+}
+
+uint qHash(const StringId &key)
+{
+	return qHash(key.editor) ^ qHash(key.diagram) ^ qHash(key.element) ^ qHash(key.id);
+}
+
+}
+
 
 void RepositoryTest::removeDirectory(QString const &dirName)
 {
@@ -205,6 +230,18 @@ TEST_F(RepositoryTest, elementsByPropertyTest) {
 	EXPECT_TRUE(list.contains(child1_child));
 }
 
+TEST_F(RepositoryTest, elementsByPropertyNoDuplicatesTest) {
+	// Element is reported once even if several of its property names match the pattern.
+	mRepository->setProperty(root, "property2", "value2");
+
+	IdList list = mRepository->elementsByProperty("property[12]", false, true);
+	EXPECT_EQ(list.count(root), 1);
+	EXPECT_EQ(list.toSet().size(), list.size());
+
+	list = mRepository->findElementsByName("child", false, false);
+	EXPECT_EQ(list.toSet().size(), list.size());
+}
+
 TEST_F(RepositoryTest, elementsByPropertyContentTest) {
 	IdList list = mRepository->elementsByPropertyContent("value", false, false);
 	EXPECT_EQ(list.size(), 2);
@@ -227,6 +264,39 @@ TEST_F(RepositoryTest, elementsByPropertyContentTest) {
 	EXPECT_TRUE(list.contains(root));
 }
 
+TEST_F(RepositoryTest, searchIndexUpdateTest) {
+	ASSERT_EQ(mRepository->elementsByPropertyContent("value", false, false).size(), 2);
+
+	mRepository->setProperty(child1, "name", "renamed");
+	mRepository->setProperty(child2, "property4", "another VALUE");
+	mRepository->removeProperty(root, "property1");
+
+	IdList list = mRepository->findElementsByName("child1", false, false);
+	EXPECT_EQ(list, IdList() << child1_child);
+
+	list = mRepository->findElementsByName("renamed", true, false);
+	EXPECT_EQ(list, IdList() << child1);
+
+	list = mRepository->elementsByProperty("property1", false, false);
+	EXPECT_TRUE(list.isEmpty());
+
+	list = mRepository->elementsByPropertyContent("value", false, false);
+	EXPECT_EQ(list.size(), 2);
+	EXPECT_TRUE(list.contains(child2));
+	EXPECT_TRUE(list.contains(child3_child));
+
+	list = mRepository->elementsByPropertyContent("VALUE", true, false);
+	EXPECT_EQ(list, IdList() << child2);
+
+	mRepository->remove(child2);
+	list = mRepository->elementsByPropertyContent("value", false, false);
+	EXPECT_EQ(list, IdList() << child3_child);
+
+	list = mRepository->elementsByType("element3", true, false);
+	EXPECT_EQ(list, IdList() << child1);
+	EXPECT_EQ(mRepository->elementsOfType("element4"), IdList() << child3);
+}
+
 TEST_F(RepositoryTest, parentOperationsTest) {
 	EXPECT_EQ(mRepository->parent(child1), root);
 	EXPECT_EQ(mRepository->parent(child2), root);
@@ -641,3 +711,93 @@ TEST_F(RepositoryTest, saveDiagramsByIdTest) {
 
 	QFile::remove("diagram1.qrs");
 }
+
+TEST_F(RepositoryTest, incrementalAutosaveTest) {
+	ASSERT_TRUE(mRepository->autosave("autosave.qrs"));
+
+	mRepository->setProperty(child2, "property3", "newValue");
+	mRepository->remove(child3_child);
+	mRepository->removeChild(child3, child3_child);
+	mRepository->setMetaInformation("key", "value");
+	ASSERT_TRUE(mRepository->autosave("autosave.qrs"));
+
+	mRepository->addChild(child3, newId1);
+	ASSERT_TRUE(mRepository->autosave("autosave.qrs"));
+
+	mRepository->open("autosave.qrs");
+
+	EXPECT_EQ(mRepository->elements().size(), 9);
+	EXPECT_FALSE(mRepository->exist(child3_child));
+	EXPECT_TRUE(mRepository->exist(newId1));
+	EXPECT_EQ(mRepository->parent(newId1), child3);
+	EXPECT_EQ(mRepository->children(child3), IdList() << newId1);
+	EXPECT_EQ(mRepository->property(child2, "property3").toString(), "newValue");
+	EXPECT_EQ(mRepository->property(child2, "name").toString(), "child2");
+	EXPECT_EQ(mRepository->metaInformation("key").toString(), "value");
+	EXPECT_EQ(mRepository->workingFile(), "autosave.qrs");
+
+	QFile::remove("autosave.qrs");
+}
+
+// Timing only, the usual run skips it; pass --gtest_also_run_disabled_tests to measure.
+TEST_F(RepositoryTest, DISABLED_idsBenchmark) {
+	// Repository keeps objects in a hash by Id, so lookups by Id dominate most of repository operations.
+	const int elementsCount = 10000;
+	const int iterations = 20;
+
+	IdList ids;
+	QList<StringId> stringIds;
+	QHash<Id, int> idsHash;
+	QHash<StringId, int> stringIdsHash;
+	for (int i = 0; i < elementsCount; ++i) {
+		const Id id = Id::createElementId("editor1", "diagram1", "element" + QString::number(i % 10));
+		const StringId stringId = { id.editor(), id.diagram(), id.element(), id.id() };
+		ids << id;
+		stringIds << stringId;
+		idsHash[id] = i;
+		stringIdsHash[stringId] = i;
+		mRepository->addChild(root, id);
+		mRepository->setProperty(id, "name", i);
+	}
+
+	QElapsedTimer timer;
+	qint64 checksum = 0;
+
+	timer.start();
+	for (int i = 0; i < iterations; ++i) {
+		for (const StringId &id : stringIds) {
+			checksum += stringIdsHash.value(id);
+		}
+	}
+
+	const qint64 stringIdsTime = timer.elapsed();
+
+	timer.restart();
+	for (int i = 0; i < iterations; ++i) {
+		for (const Id &id : ids) {
+			checksum -= idsHash.value(id);
+		}
+	}
+
+	const qint64 idsTime = timer.elapsed();
+
+	ASSERT_EQ(0, checksum);
+
+	timer.restart();
+	for (int i = 0; i < iterations; ++i) {
+		for (const Id &id : ids) {
+			checksum += mRepository->property(id, "name").toInt();
+			checksum -= mRepository->parent(id) == root ? 0 : 1;
+		}
+
+		checksum += mRepository->children(root).size();
+	}
+
+	const qint64 repositoryTime = timer.elapsed();
+
+	const qint64 elementsSum = static_cast<qint64>(elementsCount) * (elementsCount - 1) / 2;
+	ASSERT_EQ(iterations * (elementsSum + elementsCount + 3), checksum);
+	qDebug() << "Looked up" << elementsCount << "ids" << iterations << "times."
+			<< "Ids of four strings:" << stringIdsTime << "ms, interned ids:" << idsTime << "ms,"
+			<< "repository operations:" << repositoryTime << "ms";
+}
@@ -150,3 +150,30 @@ TEST_F(SerializerTest, saveAndLoadGraphicalPartsTest)
 
 	ASSERT_EQ(QPointF(10, 20), deserializedGraphicalObject->graphicalPartProperty(0, "Coord"));
 }
+
+TEST_F(SerializerTest, saveAndLoadDoNotUseWorkingDirectoryTest)
+{
+	const Id id("editor1", "diagram1", "element1", "id1");
+	LogicalObject obj(id);
+	obj.setProperty("property1", "value1");
+
+	mSerializer->saveToDisk({&obj}, QHash<QString, QVariant>());
+
+	const QDir workingDirectory(mSerializer->workingDirectory());
+	EXPECT_TRUE(workingDirectory.entryList(QDir::NoDotAndDotDot | QDir::AllEntries).isEmpty());
+
+	QHash<Id, Object *> map;
+	QHash<QString, QVariant> metaInfo;
+	mSerializer->setWorkingFile("saveFile.qrs");
+	mSerializer->loadFromDisk(map, metaInfo);
+
+	EXPECT_TRUE(workingDirectory.entryList(QDir::NoDotAndDotDot | QDir::AllEntries).isEmpty());
+	ASSERT_TRUE(map.contains(id));
+	EXPECT_EQ("value1", map.value(id)->property("property1").toString());
+	qDeleteAll(map);
+
+	// Save still has the layout of unpacked repository, so it can be unpacked by older versions.
+	mSerializer->decompressFile("saveFile.qrs");
+	EXPECT_TRUE(QFile::exists(mSerializer->workingDirectory() + "/tree/logical/editor1/diagram1/element1/id1"));
+	EXPECT_TRUE(QFile::exists(mSerializer->workingDirectory() + "/metaInfo.xml"));
+}
@@ -14,12 +14,70 @@
 
 #include "luaLexerTest.h"
 
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDirIterator>
+#include <QtCore/QElapsedTimer>
+
+#include <qrrepo/repoApi.h>
+
 #include "gtest/gtest.h"
 
 using namespace qrtext::lua::details;
 using namespace qrtext::core;
 using namespace qrTest;
 
+namespace {
+
+using RegexpLexer = Lexer<LuaTokenTypes>;
+
+void expectSameTokens(const QList<Token<LuaTokenTypes>> &expected, const QList<Token<LuaTokenTypes>> &actual)
+{
+	ASSERT_EQ(expected.size(), actual.size());
+	for (int i = 0; i < expected.size(); ++i) {
+		EXPECT_EQ(expected[i].token(), actual[i].token());
+		EXPECT_EQ(expected[i].lexeme(), actual[i].lexeme());
+		EXPECT_EQ(expected[i].range().start(), actual[i].range().start());
+		EXPECT_EQ(expected[i].range().end(), actual[i].range().end());
+	}
+}
+
+void expectSameErrors(const QList<Error> &expected, const QList<Error> &actual)
+{
+	ASSERT_EQ(expected.size(), actual.size());
+	for (int i = 0; i < expected.size(); ++i) {
+		EXPECT_EQ(expected[i].connection(), actual[i].connection());
+		EXPECT_EQ(expected[i].errorMessage(), actual[i].errorMessage());
+		EXPECT_EQ(expected[i].errorType(), actual[i].errorType());
+		EXPECT_EQ(expected[i].severity(), actual[i].severity());
+	}
+}
+
+/// Collects all string properties of all elements in saves found in the given directory.
+QStringList propertiesOfExamples(const QString &path)
+{
+	QStringList result;
+	QDirIterator iterator(path, {"*.qrs"}, QDir::Files, QDirIterator::Subdirectories);
+	while (iterator.hasNext()) {
+		const qrRepo::RepoApi repoApi(iterator.next(), true);
+		for (const qReal::Id &id : repoApi.graphicalElements()) {
+			const qReal::Id logicalId = repoApi.logicalId(id);
+			if (logicalId.isNull()) {
+				continue;
+			}
+
+			for (const QVariant &value : repoApi.properties(logicalId)) {
+				if (value.type() == QVariant::String && !value.toString().isEmpty()) {
+					result << value.toString();
+				}
+			}
+		}
+	}
+
+	return result;
+}
+
+}
+
 void LuaLexerTest::SetUp()
 {
 	mErrors.clear();
@@ -363,3 +421,72 @@ TEST_F(LuaLexerTest, comments)
 	EXPECT_EQ(Connection(57, 3, 0), comments[2].range().start());
 	EXPECT_EQ(Connection(58, 3, 1), comments[2].range().end());
 }
+
+TEST_F(LuaLexerTest, sameAsRegexpLexer)
+{
+	const QStringList streams = {
+		"x = 0x  0xg 0x.5 0x1e.5p 0x1P+a 1. .5 1e 1e+ 1.5e- 1.e5 0e5 07 12ab"
+		, "a...b..c.d :: : ; , ~= ~ != ! == = <= << < >= >> > // / && & || |"
+		, "'unterminated \\' \"a\\\nb\" 'x\\"
+		, "s = \"multi\\\nline\\\n\" -- comment\r\nnext\r line"
+		, "\t\tИмя_1 = ошибка$ @@@\tчисло2 --\n--"
+		, "if a then b() elseif c then d = {1, 2; [3] = 4} else return nil end"
+	};
+
+	for (const QString &stream : streams) {
+		mErrors.clear();
+		const auto expected = mLexer->RegexpLexer::tokenize(stream);
+		const auto expectedComments = mLexer->RegexpLexer::comments();
+		const QList<Error> expectedErrors = mErrors;
+
+		mErrors.clear();
+		const auto actual = mLexer->tokenize(stream);
+
+		expectSameTokens(expected, actual);
+		expectSameTokens(expectedComments, mLexer->comments());
+		expectSameErrors(expectedErrors, mErrors);
+	}
+}
+
+// Measures lexers on real code, so it is not a part of the usual run: use --gtest_also_run_disabled_tests.
+TEST_F(LuaLexerTest, DISABLED_examplesBenchmark)
+{
+	// Properties of example saves are mostly short expressions, so every property is tokenized several times.
+	const QStringList properties = propertiesOfExamples(QCoreApplication::applicationDirPath() + "/examples");
+	const int iterations = 10;
+
+	for (const QString &property : properties) {
+		mErrors.clear();
+		const auto expected = mLexer->RegexpLexer::tokenize(property);
+		const QList<Error> expectedErrors = mErrors;
+
+		mErrors.clear();
+		expectSameTokens(expected, mLexer->tokenize(property));
+		expectSameErrors(expectedErrors, mErrors);
+	}
+
+	QElapsedTimer timer;
+	int tokensCount = 0;
+
+	timer.start();
+	for (int i = 0; i < iterations; ++i) {
+		for (const QString &property : properties) {
+			tokensCount += mLexer->RegexpLexer::tokenize(property).size();
+		}
+	}
+
+	const qint64 regexpTime = timer.elapsed();
+
+	timer.restart();
+	for (int i = 0; i < iterations; ++i) {
+		for (const QString &property : properties) {
+			tokensCount -= mLexer->tokenize(property).size();
+		}
+	}
+
+	const qint64 handWrittenTime = timer.elapsed();
+
+	ASSERT_EQ(0, tokensCount);
+	qDebug() << "Tokenized" << properties.size() << "properties of examples" << iterations << "times."
+			<< "Regexp lexer:" << regexpTime << "ms, hand-written lexer:" << handWrittenTime << "ms";
+}
@@ -77,6 +77,24 @@ TEST_F(LuaToolboxTest, intrinsicFunctionAsIdentifier)
 	EXPECT_EQ(2, mToolbox->errors().size());
 }
 
+TEST_F(LuaToolboxTest, semanticErrorReplacesAst)
+{
+	mToolbox->addIntrinsicFunction("f", new types::Integer(), {new types::Integer()}
+			, [] (QList<QVariant> params) { return params[0].toInt() + 2; }
+			);
+
+	qReal::Id const testId = qReal::Id("1", "2", "3", "test");
+
+	EXPECT_EQ(3, mToolbox->interpret<int>(testId, "test", "1 + 2"));
+	const QSharedPointer<qrtext::core::ast::Node> oldAst = mToolbox->ast(testId, "test");
+
+	// Wrong code shall not leave the property with AST of its previous code.
+	const QSharedPointer<qrtext::core::ast::Node> newAst = mToolbox->parse(testId, "test", "f = 1");
+	EXPECT_FALSE(mToolbox->errors().isEmpty());
+	EXPECT_NE(oldAst, newAst);
+	EXPECT_EQ(newAst, mToolbox->ast(testId, "test"));
+}
+
 TEST_F(LuaToolboxTest, errorProcessingSanityCheck)
 {
 	mToolbox->interpret<int>("true ||| false");
@@ -177,3 +195,23 @@ TEST_F(LuaToolboxTest, twoFunctions)
 	mToolbox->interpret<int>("cos(1)");
 	ASSERT_TRUE(mToolbox->errors().isEmpty());
 }
+
+TEST_F(LuaToolboxTest, sameCodeSharesAst)
+{
+	const qReal::Id firstId = qReal::Id("1", "2", "3", "first");
+	const qReal::Id secondId = qReal::Id("1", "2", "3", "second");
+
+	EXPECT_EQ(3, mToolbox->interpret<int>(firstId, "test", "1 + 2"));
+	EXPECT_EQ(3, mToolbox->interpret<int>(secondId, "test", "1 + 2"));
+	ASSERT_TRUE(mToolbox->errors().isEmpty());
+
+	EXPECT_EQ(mToolbox->ast(firstId, "test"), mToolbox->ast(secondId, "test"));
+	EXPECT_TRUE(mToolbox->type(mToolbox->ast(secondId, "test"))->is<types::Integer>());
+
+	// Changing code of one block shall not spoil the AST of another.
+	EXPECT_EQ(5, mToolbox->interpret<int>(firstId, "test", "2 + 3"));
+	EXPECT_NE(mToolbox->ast(firstId, "test"), mToolbox->ast(secondId, "test"));
+	EXPECT_TRUE(mToolbox->type(mToolbox->ast(secondId, "test"))->is<types::Integer>());
+	EXPECT_EQ(3, mToolbox->interpret<int>(secondId, "test", "1 + 2"));
+	EXPECT_TRUE(mToolbox->errors().isEmpty());
+}
@@ -0,0 +1,140 @@
+/* Copyright 2018 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "luaVirtualMachineTest.h"
+
+#include "qrtext/lua/types/integer.h"
+
+using namespace qrTest;
+using namespace qrtext;
+using namespace qrtext::lua;
+using namespace qrtext::lua::details;
+
+void LuaVirtualMachineTest::SetUp()
+{
+	mAnalyzer.reset(new LuaSemanticAnalyzer(mErrors));
+	mParser.reset(new LuaParser(mErrors));
+	mLexer.reset(new LuaLexer(mErrors));
+	mInterpreter.reset(new LuaInterpreter(mErrors));
+	mCompiler.reset(new LuaCompiler(*mInterpreter));
+	mVirtualMachine.reset(new LuaVirtualMachine(*mInterpreter, mErrors));
+}
+
+QSharedPointer<qrtext::core::ast::Node> LuaVirtualMachineTest::parseAndAnalyze(const QString &code)
+{
+	return mAnalyzer->analyze(mParser->parse(mLexer->tokenize(code), mLexer->userFriendlyTokenNames()));
+}
+
+QVariant LuaVirtualMachineTest::run(const QString &code)
+{
+	const auto ast = parseAndAnalyze(code);
+	return mErrors.isEmpty() ? mVirtualMachine->run(*mCompiler->compile(ast), *mAnalyzer) : QVariant();
+}
+
+QVariant LuaVirtualMachineTest::interpret(const QString &code)
+{
+	const auto ast = parseAndAnalyze(code);
+	return mErrors.isEmpty() ? mInterpreter->interpret(ast, *mAnalyzer) : QVariant();
+}
+
+TEST_F(LuaVirtualMachineTest, sameResultsAsTreeInterpreter)
+{
+	const QStringList expressions = {
+		"1", "2.5", "'abc'", "true", "false", "nil"
+		, "5.2 + 2.4", "5 - 7", "6 * 6", "5 / 2", "5 // 2", "-7 // 2", "5 % 3", "2 ^ 10", "2.5 ^ 3.2"
+		, "2 & 3", "6 | 3", "1 << 3", "6 >> 1", "~2", "-(1)", "-1.5", "'ab' .. 'cd'"
+		, "1 < 2", "2.5 <= 2", "1 > 2", "2 >= 2", "1 == 1", "'a' == 'a'", "1 ~= 2", "0.1 + 0.2 == 0.3"
+		, "true and false", "1 and 2", "1 and 0", "0 or 0", "true or false", "false || 2"
+		, "not false", "not 'abcd'", "not ''", "not 1", "not 0", "not nil"
+		, "#'asdf'", "{1, 2} == {1, 2}"
+	};
+
+	for (const QString &expression : expressions) {
+		const QVariant expected = interpret(expression);
+		const QVariant actual = run(expression);
+		ASSERT_TRUE(mErrors.isEmpty()) << expression.toStdString();
+		EXPECT_EQ(expected.userType(), actual.userType()) << expression.toStdString();
+		EXPECT_EQ(expected, actual) << expression.toStdString();
+	}
+}
+
+TEST_F(LuaVirtualMachineTest, variables)
+{
+	run("a = 1; b = a + 2");
+	ASSERT_TRUE(mErrors.isEmpty());
+	EXPECT_EQ(3, mInterpreter->value("b").toInt());
+	EXPECT_EQ(1, mInterpreter->value("a").toInt());
+	EXPECT_TRUE(mInterpreter->identifiers().contains("b"));
+
+	// Variables are shared with tree interpreter.
+	mInterpreter->setVariableValue("a", 10);
+	EXPECT_EQ(12, run("a + 2").toInt());
+	EXPECT_EQ(12, interpret("a + 2").toInt());
+
+	mInterpreter->forgetIdentifier("a");
+	EXPECT_FALSE(mInterpreter->identifiers().contains("a"));
+	EXPECT_FALSE(run("a").isValid());
+}
+
+TEST_F(LuaVirtualMachineTest, readOnlyVariable)
+{
+	mInterpreter->setVariableValue("x", 5);
+	mInterpreter->addReadOnlyVariable("x");
+
+	run("x = 1");
+	EXPECT_EQ(1, mErrors.size());
+	EXPECT_EQ(5, mInterpreter->value("x").toInt());
+}
+
+TEST_F(LuaVirtualMachineTest, divisionByZero)
+{
+	EXPECT_EQ(0, run("5 / 0").toInt());
+	EXPECT_EQ(1, mErrors.size());
+	mErrors.clear();
+
+	EXPECT_EQ(0, run("5 % 0").toInt());
+	EXPECT_EQ(1, mErrors.size());
+}
+
+TEST_F(LuaVirtualMachineTest, intrinsicFunctionsAndShortCircuit)
+{
+	int calls = 0;
+	mAnalyzer->addIntrinsicFunction("f", QSharedPointer<types::Function>(new types::Function(
+			QSharedPointer<core::types::TypeExpression>(new types::Integer())
+			, {QSharedPointer<core::types::TypeExpression>(new types::Integer())}
+			)));
+
+	mInterpreter->addIntrinsicFunction("f", [&calls](const QList<QVariant> &params) {
+		++calls;
+		return params[0].toInt() * 2;
+	});
+
+	EXPECT_EQ(10, run("f(5)").toInt());
+	EXPECT_EQ(1, calls);
+
+	EXPECT_FALSE(run("0 and f(1)").toBool());
+	EXPECT_TRUE(run("1 or f(1)").toBool());
+	EXPECT_EQ(1, calls);
+
+	EXPECT_TRUE(run("1 and f(1)").toBool());
+	EXPECT_EQ(2, calls);
+	EXPECT_TRUE(mErrors.isEmpty());
+}
+
+TEST_F(LuaVirtualMachineTest, tablesAreInterpretedByTreeInterpreter)
+{
+	EXPECT_EQ(40, run("a = {10, 20}; a[2] = 30; a[0] + a[2]").toInt());
+	EXPECT_EQ(4, run("s = 'asdf'; #s").toInt());
+	ASSERT_TRUE(mErrors.isEmpty());
+}
@@ -0,0 +1,52 @@
+/* Copyright 2018 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QScopedPointer>
+
+#include <gtest/gtest.h>
+
+#include "qrtext/src/lua/luaInterpreter.h"
+#include "qrtext/src/lua/luaCompiler.h"
+#include "qrtext/src/lua/luaVirtualMachine.h"
+#include "qrtext/src/lua/luaSemanticAnalyzer.h"
+#include "qrtext/src/lua/luaParser.h"
+#include "qrtext/src/lua/luaLexer.h"
+
+namespace qrTest {
+
+class LuaVirtualMachineTest : public testing::Test
+{
+protected:
+	void SetUp() override;
+
+	QSharedPointer<qrtext::core::ast::Node> parseAndAnalyze(const QString &code);
+
+	/// Compiles given code and runs it on virtual machine.
+	QVariant run(const QString &code);
+
+	/// Interprets given code by tree interpreter.
+	QVariant interpret(const QString &code);
+
+	QScopedPointer<qrtext::lua::details::LuaInterpreter> mInterpreter;
+	QScopedPointer<qrtext::lua::details::LuaCompiler> mCompiler;
+	QScopedPointer<qrtext::lua::details::LuaVirtualMachine> mVirtualMachine;
+	QScopedPointer<qrtext::lua::details::LuaSemanticAnalyzer> mAnalyzer;
+	QScopedPointer<qrtext::lua::details::LuaParser> mParser;
+	QScopedPointer<qrtext::lua::details::LuaLexer> mLexer;
+	QList<qrtext::core::Error> mErrors;
+};
+
+}
@@ -18,7 +18,7 @@ include(../common.pri)
 
 include(../../../qrtext/qrtext.pri)
 
-links(qslog)
+links(qslog qrrepo)
 
 INCLUDEPATH += ../../../qrtext/include
 
@@ -30,6 +30,7 @@ HEADERS += \
 	luaParserTest.h \
 	luaSemanticAnalyzerTest.h \
 	luaToolboxTest.h \
+	luaVirtualMachineTest.h \
 
 SOURCES += \
 	luaInterpreterIncorrectInputTest.cpp \
@@ -38,6 +39,7 @@ SOURCES += \
 	luaParserTest.cpp \
 	luaSemanticAnalyzerTest.cpp \
 	luaToolboxTest.cpp \
+	luaVirtualMachineTest.cpp \
 	luaLexerTest.cpp \
 	luaStringEscapeUtilsTest.cpp \
 
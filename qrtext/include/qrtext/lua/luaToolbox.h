@@ -29,6 +29,10 @@ class LuaLexer;
 class LuaParser;
 class LuaSemanticAnalyzer;
 class LuaInterpreter;
+class LuaCompiler;
+class LuaVirtualMachine;
+class LuaAstCache;
+struct LuaBytecode;
 }
 
 typedef core::Error Error;
@@ -42,6 +46,12 @@ typedef core::Error Error;
 /// future uses, or can parse it and then return AST for node/property by request (note that it uses all ASTs
 /// as a context for parsing next chunks).
 ///
+/// Successfully parsed chunks are cached by their code, so identical code fragments of different blocks (like "0",
+/// "true" or "sensor == 1") are parsed, analyzed and compiled once and share the same AST.
+///
+/// Parsed chunks are compiled into bytecode once, so interpreting the same chunk again costs neither tree traversal
+/// nor variable lookups by name. Constructs not supported by the compiler are interpreted by the tree interpreter.
+///
 /// Note that types of variables may change during parsing next chunks, so, for example, after parsing "a = 123" type
 /// of "a" will be inferred as Integer, but after parsing "a = 1.0" it will be changed to Float. Generators may reliably
 /// use type information only when all code in a program is parsed.
@@ -135,16 +145,36 @@ private:
 
 	void reportErrors();
 
+	/// Makes given AST the AST of given node and property.
+	void setAst(const qReal::Id &id, const QString &propertyName, const QString &code
+			, const QSharedPointer<core::ast::Node> &ast);
+
+	/// Forgets types and bytecode of given AST if it is neither used by some node nor cached.
+	void release(const QSharedPointer<core::ast::Node> &ast);
+
 	QList<core::Error> mErrors;
 
 	QScopedPointer<details::LuaLexer> mLexer;
 	QScopedPointer<details::LuaParser> mParser;
 	QScopedPointer<details::LuaSemanticAnalyzer> mAnalyzer;
 	QScopedPointer<details::LuaInterpreter> mInterpreter;
+	QScopedPointer<details::LuaCompiler> mCompiler;
+	QScopedPointer<details::LuaVirtualMachine> mVirtualMachine;
+
+	QScopedPointer<details::LuaAstCache> mAstCache;
 
 	QHash<qReal::Id, QHash<QString, QSharedPointer<core::ast::Node>>> mAstRoots;
+
+	/// Code of ASTs from mAstRoots, if they are known to be successfully analyzed.
 	QHash<qReal::Id, QHash<QString, QString>> mParsedCache;
 
+	/// Number of node properties which use an AST, the same AST may be shared by different nodes.
+	QHash<const core::ast::Node *, int> mAstUsers;
+
+	/// Compiled code of ASTs from mAstRoots or AST cache. Keys keep their ASTs alive, so an address of a released AST
+	/// reused by a new one never finds stale bytecode; entries are removed by release().
+	QHash<QSharedPointer<core::ast::Node>, QSharedPointer<details::LuaBytecode>> mBytecode;
+
 	QStringList mSpecialConstants;
 	QStringList mSpecialIdentifiers;
 };
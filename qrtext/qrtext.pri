@@ -108,6 +108,9 @@ HEADERS += \
 	$$PWD/include/qrtext/lua/types/number.h \
 	$$PWD/include/qrtext/lua/types/string.h \
 	$$PWD/include/qrtext/lua/types/table.h \
+	$$PWD/src/lua/luaAstCache.h \
+	$$PWD/src/lua/luaBytecode.h \
+	$$PWD/src/lua/luaCompiler.h \
 	$$PWD/src/lua/luaGeneralizationsTable.h \
 	$$PWD/src/lua/luaInterpreter.h \
 	$$PWD/src/lua/luaLexer.h \
@@ -115,6 +118,7 @@ HEADERS += \
 	$$PWD/src/lua/luaPrecedenceTable.h \
 	$$PWD/src/lua/luaSemanticAnalyzer.h \
 	$$PWD/src/lua/luaTokenTypes.h \
+	$$PWD/src/lua/luaVirtualMachine.h \
 
 SOURCES += \
 	$$PWD/src/core/connection.cpp \
@@ -123,6 +127,8 @@ SOURCES += \
 	$$PWD/src/core/ast/node.cpp \
 	$$PWD/src/core/semantics/semanticAnalyzer.cpp \
 	$$PWD/src/core/types/typeVariable.cpp \
+	$$PWD/src/lua/luaAstCache.cpp \
+	$$PWD/src/lua/luaCompiler.cpp \
 	$$PWD/src/lua/luaGeneralizationsTable.cpp \
 	$$PWD/src/lua/luaInterpreter.cpp \
 	$$PWD/src/lua/luaLexer.cpp \
@@ -131,6 +137,7 @@ SOURCES += \
 	$$PWD/src/lua/luaSemanticAnalyzer.cpp \
 	$$PWD/src/lua/luaStringEscapeUtils.cpp \
 	$$PWD/src/lua/luaToolbox.cpp \
+	$$PWD/src/lua/luaVirtualMachine.cpp \
 
 TRANSLATIONS = \
 	$$PWD/../qrtranslations/ru/qrtext_ru.ts \
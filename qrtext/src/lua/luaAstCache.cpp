@@ -0,0 +1,72 @@
+/* Copyright 2018 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "qrtext/src/lua/luaAstCache.h"
+
+using namespace qrtext;
+using namespace qrtext::lua::details;
+
+LuaAstCache::LuaAstCache(int capacity)
+	: mCapacity(capacity)
+{
+}
+
+QSharedPointer<core::ast::Node> LuaAstCache::find(const QString &code)
+{
+	const auto entry = mEntries.find(code);
+	if (entry == mEntries.end()) {
+		return QSharedPointer<core::ast::Node>();
+	}
+
+	mUsageOrder.erase(entry->usage);
+	entry->usage = mUsageOrder.insert(mUsageOrder.end(), code);
+	return entry->ast;
+}
+
+bool LuaAstCache::contains(const QSharedPointer<core::ast::Node> &ast) const
+{
+	return mCodes.contains(ast.data());
+}
+
+QList<QSharedPointer<core::ast::Node>> LuaAstCache::insert(const QString &code
+		, const QSharedPointer<core::ast::Node> &ast)
+{
+	if (find(code)) {
+		return {};
+	}
+
+	mEntries.insert(code, Entry{ast, mUsageOrder.insert(mUsageOrder.end(), code)});
+	mCodes.insert(ast.data(), code);
+
+	QList<QSharedPointer<core::ast::Node>> evicted;
+	while (mEntries.size() > mCapacity) {
+		const QString leastRecentlyUsed = mUsageOrder.first();
+		evicted << mEntries.value(leastRecentlyUsed).ast;
+		remove(leastRecentlyUsed);
+	}
+
+	return evicted;
+}
+
+void LuaAstCache::remove(const QString &code)
+{
+	const auto entry = mEntries.find(code);
+	if (entry == mEntries.end()) {
+		return;
+	}
+
+	mUsageOrder.erase(entry->usage);
+	mCodes.remove(entry->ast.data());
+	mEntries.erase(entry);
+}
@@ -0,0 +1,67 @@
+/* Copyright 2018 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QHash>
+#include <QtCore/QLinkedList>
+#include <QtCore/QSharedPointer>
+
+#include "qrtext/core/ast/node.h"
+
+namespace qrtext {
+namespace lua {
+namespace details {
+
+/// Cache of successfully parsed chunks keyed by their code, so the same code in different blocks is parsed once and
+/// shares one AST (and so types and bytecode bound to its nodes). Holds at most given number of ASTs, the least
+/// recently used ones are evicted first.
+class LuaAstCache
+{
+public:
+	/// Constructor.
+	/// @param capacity - maximal number of ASTs in cache.
+	explicit LuaAstCache(int capacity);
+
+	/// Returns AST parsed from given code and marks it as recently used, or null pointer if there is no such AST.
+	QSharedPointer<core::ast::Node> find(const QString &code);
+
+	/// Returns true if given AST is in cache.
+	bool contains(const QSharedPointer<core::ast::Node> &ast) const;
+
+	/// Adds AST parsed from given code, or marks already cached AST for this code as recently used.
+	/// Returns ASTs evicted from cache to keep its size within capacity.
+	QList<QSharedPointer<core::ast::Node>> insert(const QString &code, const QSharedPointer<core::ast::Node> &ast);
+
+	/// Removes AST for given code from cache, so the code will be parsed anew.
+	void remove(const QString &code);
+
+private:
+	struct Entry
+	{
+		QSharedPointer<core::ast::Node> ast;
+		QLinkedList<QString>::iterator usage;
+	};
+
+	const int mCapacity;
+	QHash<QString, Entry> mEntries;
+	QHash<const core::ast::Node *, QString> mCodes;
+
+	/// Codes of cached ASTs, from least to most recently used.
+	QLinkedList<QString> mUsageOrder;
+};
+
+}
+}
+}
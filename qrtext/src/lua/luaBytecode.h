@@ -0,0 +1,254 @@
+/* Copyright 2018 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QSharedPointer>
+#include <QtCore/QVariant>
+#include <QtCore/QVector>
+
+#include "qrtext/core/ast/node.h"
+
+namespace qrtext {
+namespace lua {
+namespace details {
+
+/// Value of a register of Lua virtual machine. Integers, floats and booleans are kept unboxed, so arithmetic on them
+/// needs neither QVariant construction nor type dispatch by QVariant. Everything else is kept in QVariant.
+class LuaValue
+{
+public:
+	enum class Type : quint8
+	{
+		nil
+		, boolean
+		, integer
+		, real
+		, variant
+	};
+
+	LuaValue()
+		: mType(Type::nil)
+		, mReal(0)
+	{
+	}
+
+	static LuaValue fromBool(bool value)
+	{
+		LuaValue result;
+		result.mType = Type::boolean;
+		result.mBoolean = value;
+		return result;
+	}
+
+	static LuaValue fromInt(int value)
+	{
+		LuaValue result;
+		result.mType = Type::integer;
+		result.mInteger = value;
+		return result;
+	}
+
+	static LuaValue fromReal(double value)
+	{
+		LuaValue result;
+		result.mType = Type::real;
+		result.mReal = value;
+		return result;
+	}
+
+	/// Unboxes numbers and booleans, other values are kept as is.
+	static LuaValue fromVariant(const QVariant &value)
+	{
+		switch (value.userType()) {
+		case QMetaType::UnknownType:
+			return LuaValue();
+		case QMetaType::Bool:
+			return fromBool(value.toBool());
+		case QMetaType::Int:
+			return fromInt(value.toInt());
+		case QMetaType::Double:
+			return fromReal(value.toDouble());
+		default:
+			LuaValue result;
+			result.mType = Type::variant;
+			result.mVariant = value;
+			return result;
+		}
+	}
+
+	Type type() const
+	{
+		return mType;
+	}
+
+	/// Converts value to integer exactly as QVariant::toInt() does.
+	int toInt() const
+	{
+		return mType == Type::integer ? mInteger : toVariant().toInt();
+	}
+
+	/// Converts value to double exactly as QVariant::toDouble() does.
+	double toReal() const
+	{
+		switch (mType) {
+		case Type::integer:
+			return mInteger;
+		case Type::real:
+			return mReal;
+		default:
+			return toVariant().toDouble();
+		}
+	}
+
+	/// Converts value to boolean exactly as QVariant::toBool() does.
+	bool toBool() const
+	{
+		switch (mType) {
+		case Type::boolean:
+			return mBoolean;
+		case Type::integer:
+			return mInteger != 0;
+		default:
+			return toVariant().toBool();
+		}
+	}
+
+	/// Returns true if QVariant for this value is null.
+	bool isNull() const
+	{
+		switch (mType) {
+		case Type::nil:
+			return true;
+		case Type::variant:
+			return mVariant.isNull();
+		default:
+			return false;
+		}
+	}
+
+	/// Compares values exactly as QVariant comparison does.
+	bool equals(const LuaValue &other) const
+	{
+		if (mType == Type::integer && other.mType == Type::integer) {
+			return mInteger == other.mInteger;
+		}
+
+		if (mType == Type::boolean && other.mType == Type::boolean) {
+			return mBoolean == other.mBoolean;
+		}
+
+		return toVariant() == other.toVariant();
+	}
+
+	/// Boxes value into QVariant, the result is the same as tree interpreter returns for the same expression.
+	QVariant toVariant() const
+	{
+		switch (mType) {
+		case Type::nil:
+			return QVariant();
+		case Type::boolean:
+			return mBoolean;
+		case Type::integer:
+			return mInteger;
+		case Type::real:
+			return mReal;
+		default:
+			return mVariant;
+		}
+	}
+
+private:
+	Type mType;
+	union {
+		bool mBoolean;
+		int mInteger;
+		double mReal;
+	};
+
+	QVariant mVariant;
+};
+
+/// Operation codes of Lua bytecode. A, B and C are operands of an instruction, registers are denoted as R(x).
+/// Unary and binary operations take operands from R(B) and R(C) and put the result into R(A).
+/// Errors like assignment to read-only variable or division by zero are reported at Instruction::node.
+enum class OpCode : quint8
+{
+	/// R(A) := constants[B].
+	loadConstant
+	/// R(A) := value of variable in slot B.
+	, loadVariable
+	/// Variable in slot B := R(A), R(A) := nil.
+	, storeVariable
+	/// R(A) := intrinsic function B called with C arguments taken from R(A) .. R(A + C - 1).
+	, call
+	/// R(A) := result of tree interpreter for nodes[B], used for constructs the compiler does not support.
+	, interpret
+	/// Goto B.
+	, jump
+	/// If R(A) converted to integer is zero goto B.
+	, jumpIfZero
+	/// If R(A) converted to integer is not zero goto B.
+	, jumpIfNotZero
+	, unaryMinus
+	, logicalNot
+	, bitwiseNegation
+	, addition
+	, subtraction
+	, multiplication
+	, division
+	, integerDivision
+	, modulo
+	, exponentiation
+	, bitwiseAnd
+	, bitwiseOr
+	, bitwiseXor
+	, bitwiseLeftShift
+	, bitwiseRightShift
+	, concatenation
+	, lessThan
+	, lessOrEqual
+	, greaterThan
+	, greaterOrEqual
+	, equality
+	, inequality
+};
+
+/// One instruction of Lua bytecode.
+struct Instruction
+{
+	OpCode code;
+	int a;
+	int b;
+	int c;
+
+	/// Index of the AST node in LuaBytecode::nodes runtime errors of this instruction are reported at, or -1.
+	int node;
+};
+
+/// A chunk of Lua code compiled by LuaCompiler for LuaVirtualMachine. The result of a chunk is left in R(0).
+struct LuaBytecode
+{
+	QVector<Instruction> code;
+	QVector<LuaValue> constants;
+
+	/// Nodes interpreted by tree interpreter and nodes runtime errors are reported at.
+	QVector<QSharedPointer<core::ast::Node>> nodes;
+
+	int registersCount = 1;
+};
+
+}
+}
+}
@@ -0,0 +1,382 @@
+/* Copyright 2018 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "qrtext/src/lua/luaCompiler.h"
+
+#include "qrtext/src/lua/luaInterpreter.h"
+
+#include "qrtext/lua/ast/assignment.h"
+#include "qrtext/lua/ast/block.h"
+#include "qrtext/lua/ast/false.h"
+#include "qrtext/lua/ast/floatNumber.h"
+#include "qrtext/lua/ast/functionCall.h"
+#include "qrtext/lua/ast/identifier.h"
+#include "qrtext/lua/ast/integerNumber.h"
+#include "qrtext/lua/ast/nil.h"
+#include "qrtext/lua/ast/string.h"
+#include "qrtext/lua/ast/true.h"
+
+#include "qrtext/lua/ast/unaryMinus.h"
+#include "qrtext/lua/ast/not.h"
+#include "qrtext/lua/ast/bitwiseNegation.h"
+
+#include "qrtext/lua/ast/addition.h"
+#include "qrtext/lua/ast/subtraction.h"
+#include "qrtext/lua/ast/multiplication.h"
+#include "qrtext/lua/ast/division.h"
+#include "qrtext/lua/ast/integerDivision.h"
+#include "qrtext/lua/ast/exponentiation.h"
+#include "qrtext/lua/ast/modulo.h"
+#include "qrtext/lua/ast/bitwiseAnd.h"
+#include "qrtext/lua/ast/bitwiseXor.h"
+#include "qrtext/lua/ast/bitwiseOr.h"
+#include "qrtext/lua/ast/bitwiseRightShift.h"
+#include "qrtext/lua/ast/bitwiseLeftShift.h"
+#include "qrtext/lua/ast/concatenation.h"
+#include "qrtext/lua/ast/lessThan.h"
+#include "qrtext/lua/ast/greaterThan.h"
+#include "qrtext/lua/ast/lessOrEqual.h"
+#include "qrtext/lua/ast/greaterOrEqual.h"
+#include "qrtext/lua/ast/equality.h"
+#include "qrtext/lua/ast/inequality.h"
+#include "qrtext/lua/ast/logicalAnd.h"
+#include "qrtext/lua/ast/logicalOr.h"
+
+using namespace qrtext;
+using namespace qrtext::lua;
+using namespace qrtext::lua::details;
+
+LuaCompiler::LuaCompiler(LuaInterpreter &interpreter)
+	: mInterpreter(interpreter)
+	, mTarget(0)
+	, mCompiled(false)
+{
+}
+
+QSharedPointer<LuaBytecode> LuaCompiler::compile(const QSharedPointer<core::ast::Node> &root)
+{
+	mBytecode.reset(new LuaBytecode());
+	if (root) {
+		compile(root, 0);
+	}
+
+	const QSharedPointer<LuaBytecode> result = mBytecode;
+	mBytecode.reset();
+	return result;
+}
+
+void LuaCompiler::compile(const QSharedPointer<core::ast::Node> &node, int target)
+{
+	const int outerTarget = mTarget;
+	mTarget = useRegister(target);
+
+	// Visit methods set this flag when they generate code, nodes without them are left to tree interpreter.
+	mCompiled = false;
+	node->accept(*this, node, wrap(nullptr));
+	if (!mCompiled) {
+		fallback(node, target);
+	}
+
+	mTarget = outerTarget;
+	mCompiled = true;
+}
+
+void LuaCompiler::compileUnaryOperator(const QSharedPointer<core::ast::UnaryOperator> &node, OpCode code)
+{
+	mCompiled = true;
+	const int target = mTarget;
+	compile(node->operand(), target);
+	emit(code, target, target);
+}
+
+void LuaCompiler::compileBinaryOperator(const QSharedPointer<core::ast::BinaryOperator> &node, OpCode code
+		, bool reportsErrors)
+{
+	mCompiled = true;
+	const int target = mTarget;
+	compile(node->leftOperand(), target);
+	compile(node->rightOperand(), target + 1);
+	emit(code, target, target, target + 1, reportsErrors ? addNode(node) : -1);
+}
+
+void LuaCompiler::fallback(const QSharedPointer<core::ast::Node> &node, int target)
+{
+	emit(OpCode::interpret, target, addNode(node));
+}
+
+int LuaCompiler::emit(OpCode code, int a, int b, int c, int node)
+{
+	mBytecode->code.append({code, a, b, c, node});
+	return mBytecode->code.size() - 1;
+}
+
+void LuaCompiler::patchJump(int instruction)
+{
+	mBytecode->code[instruction].b = mBytecode->code.size();
+}
+
+int LuaCompiler::addNode(const QSharedPointer<core::ast::Node> &node)
+{
+	mBytecode->nodes << node;
+	return mBytecode->nodes.size() - 1;
+}
+
+int LuaCompiler::useRegister(int index)
+{
+	mBytecode->registersCount = qMax(mBytecode->registersCount, index + 1);
+	return index;
+}
+
+int LuaCompiler::addConstant(const LuaValue &value)
+{
+	mBytecode->constants << value;
+	return mBytecode->constants.size() - 1;
+}
+
+void LuaCompiler::visit(const QSharedPointer<ast::UnaryMinus> &node, const QSharedPointer<core::ast::Node> &)
+{
+	compileUnaryOperator(node, OpCode::unaryMinus);
+}
+
+void LuaCompiler::visit(const QSharedPointer<ast::Not> &node, const QSharedPointer<core::ast::Node> &)
+{
+	compileUnaryOperator(node, OpCode::logicalNot);
+}
+
+void LuaCompiler::visit(const QSharedPointer<ast::BitwiseNegation> &node, const QSharedPointer<core::ast::Node> &)
+{
+	compileUnaryOperator(node, OpCode::bitwiseNegation);
+}
+
+void LuaCompiler::visit(const QSharedPointer<ast::LogicalAnd> &node, const QSharedPointer<core::ast::Node> &)
+{
+	// Right operand is calculated only if the left one is true, just like C++ '&&' in tree interpreter does.
+	mCompiled = true;
+	const int target = mTarget;
+	compile(node->leftOperand(), target);
+	const int leftIsFalse = emit(OpCode::jumpIfZero, target);
+	compile(node->rightOperand(), target);
+	const int rightIsFalse = emit(OpCode::jumpIfZero, target);
+	emit(OpCode::loadConstant, target, addConstant(LuaValue::fromBool(true)));
+	const int end = emit(OpCode::jump, 0);
+	patchJump(leftIsFalse);
+	patchJump(rightIsFalse);
+	emit(OpCode::loadConstant, target, addConstant(LuaValue::fromBool(false)));
+	patchJump(end);
+}
+
+void LuaCompiler::visit(const QSharedPointer<ast::LogicalOr> &node, const QSharedPointer<core::ast::Node> &)
+{
+	mCompiled = true;
+	const int target = mTarget;
+	compile(node->leftOperand(), target);
+	const int leftIsTrue = emit(OpCode::jumpIfNotZero, target);
+	compile(node->rightOperand(), target);
+	const int rightIsTrue = emit(OpCode::jumpIfNotZero, target);
+	emit(OpCode::loadConstant, target, addConstant(LuaValue::fromBool(false)));
+	const int end = emit(OpCode::jump, 0);
+	patchJump(leftIsTrue);
+	patchJump(rightIsTrue);
+	emit(OpCode::loadConstant, target, addConstant(LuaValue::fromBool(true)));
+	patchJump(end);
+}
+
+void LuaCompiler::visit(const QSharedPointer<ast::Addition> &node, const QSharedPointer<core::ast::Node> &)
+{
+	compileBinaryOperator(node, OpCode::addition);
+}
+
+void LuaCompiler::visit(const QSharedPointer<ast::Subtraction> &node, const QSharedPointer<core::ast::Node> &)
+{
+	compileBinaryOperator(node, OpCode::subtraction);
+}
+
+void LuaCompiler::visit(const QSharedPointer<ast::Multiplication> &node, const QSharedPointer<core::ast::Node> &)
+{
+	compileBinaryOperator(node, OpCode::multiplication);
+}
+
+void LuaCompiler::visit(const QSharedPointer<ast::Division> &node, const QSharedPointer<core::ast::Node> &)
+{
+	compileBinaryOperator(node, OpCode::division, true);
+}
+
+void LuaCompiler::visit(const QSharedPointer<ast::IntegerDivision> &node, const QSharedPointer<core::ast::Node> &)
+{
+	compileBinaryOperator(node, OpCode::integerDivision, true);
+}
+
+void LuaCompiler::visit(const QSharedPointer<ast::Modulo> &node, const QSharedPointer<core::ast::Node> &)
+{
+	compileBinaryOperator(node, OpCode::modulo, true);
+}
+
+void LuaCompiler::visit(const QSharedPointer<ast::Exponentiation> &node, const QSharedPointer<core::ast::Node> &)
+{
+	compileBinaryOperator(node, OpCode::exponentiation);
+}
+
+void LuaCompiler::visit(const QSharedPointer<ast::BitwiseAnd> &node, const QSharedPointer<core::ast::Node> &)
+{
+	compileBinaryOperator(node, OpCode::bitwiseAnd);
+}
+
+void LuaCompiler::visit(const QSharedPointer<ast::BitwiseOr> &node, const QSharedPointer<core::ast::Node> &)
+{
+	compileBinaryOperator(node, OpCode::bitwiseOr);
+}
+
+void LuaCompiler::visit(const QSharedPointer<ast::BitwiseXor> &node, const QSharedPointer<core::ast::Node> &)
+{
+	compileBinaryOperator(node, OpCode::bitwiseXor);
+}
+
+void LuaCompiler::visit(const QSharedPointer<ast::BitwiseLeftShift> &node, const QSharedPointer<core::ast::Node> &)
+{
+	compileBinaryOperator(node, OpCode::bitwiseLeftShift);
+}
+
+void LuaCompiler::visit(const QSharedPointer<ast::BitwiseRightShift> &node, const QSharedPointer<core::ast::Node> &)
+{
+	compileBinaryOperator(node, OpCode::bitwiseRightShift);
+}
+
+void LuaCompiler::visit(const QSharedPointer<ast::Concatenation> &node, const QSharedPointer<core::ast::Node> &)
+{
+	compileBinaryOperator(node, OpCode::concatenation);
+}
+
+void LuaCompiler::visit(const QSharedPointer<ast::Equality> &node, const QSharedPointer<core::ast::Node> &)
+{
+	compileBinaryOperator(node, OpCode::equality);
+}
+
+void LuaCompiler::visit(const QSharedPointer<ast::LessThan> &node, const QSharedPointer<core::ast::Node> &)
+{
+	compileBinaryOperator(node, OpCode::lessThan);
+}
+
+void LuaCompiler::visit(const QSharedPointer<ast::LessOrEqual> &node, const QSharedPointer<core::ast::Node> &)
+{
+	compileBinaryOperator(node, OpCode::lessOrEqual);
+}
+
+void LuaCompiler::visit(const QSharedPointer<ast::Inequality> &node, const QSharedPointer<core::ast::Node> &)
+{
+	compileBinaryOperator(node, OpCode::inequality);
+}
+
+void LuaCompiler::visit(const QSharedPointer<ast::GreaterThan> &node, const QSharedPointer<core::ast::Node> &)
+{
+	compileBinaryOperator(node, OpCode::greaterThan);
+}
+
+void LuaCompiler::visit(const QSharedPointer<ast::GreaterOrEqual> &node, const QSharedPointer<core::ast::Node> &)
+{
+	compileBinaryOperator(node, OpCode::greaterOrEqual);
+}
+
+void LuaCompiler::visit(const QSharedPointer<ast::IntegerNumber> &node, const QSharedPointer<core::ast::Node> &)
+{
+	mCompiled = true;
+	bool ok = false;
+	const int value = node->stringRepresentation().toInt(&ok, 0);
+	emit(OpCode::loadConstant, mTarget, addConstant(LuaValue::fromInt(value)));
+}
+
+void LuaCompiler::visit(const QSharedPointer<ast::FloatNumber> &node, const QSharedPointer<core::ast::Node> &)
+{
+	mCompiled = true;
+	const double value = node->stringRepresentation().toDouble();
+	emit(OpCode::loadConstant, mTarget, addConstant(LuaValue::fromReal(value)));
+}
+
+void LuaCompiler::visit(const QSharedPointer<ast::String> &node, const QSharedPointer<core::ast::Node> &)
+{
+	mCompiled = true;
+	emit(OpCode::loadConstant, mTarget, addConstant(LuaValue::fromVariant(node->string())));
+}
+
+void LuaCompiler::visit(const QSharedPointer<ast::True> &, const QSharedPointer<core::ast::Node> &)
+{
+	mCompiled = true;
+	emit(OpCode::loadConstant, mTarget, addConstant(LuaValue::fromBool(true)));
+}
+
+void LuaCompiler::visit(const QSharedPointer<ast::False> &, const QSharedPointer<core::ast::Node> &)
+{
+	mCompiled = true;
+	emit(OpCode::loadConstant, mTarget, addConstant(LuaValue::fromBool(false)));
+}
+
+void LuaCompiler::visit(const QSharedPointer<ast::Nil> &, const QSharedPointer<core::ast::Node> &)
+{
+	mCompiled = true;
+	emit(OpCode::loadConstant, mTarget, addConstant(LuaValue()));
+}
+
+void LuaCompiler::visit(const QSharedPointer<ast::Identifier> &node, const QSharedPointer<core::ast::Node> &)
+{
+	mCompiled = true;
+	emit(OpCode::loadVariable, mTarget, mInterpreter.variableIndex(node->name()));
+}
+
+void LuaCompiler::visit(const QSharedPointer<ast::FunctionCall> &node, const QSharedPointer<core::ast::Node> &)
+{
+	if (!node->function()->is<ast::Identifier>()) {
+		return;
+	}
+
+	const int function = mInterpreter.intrinsicFunctionIndex(as<ast::Identifier>(node->function())->name());
+	if (function < 0) {
+		return;
+	}
+
+	mCompiled = true;
+	const int target = mTarget;
+	const auto &arguments = node->arguments();
+	for (int i = 0; i < arguments.size(); ++i) {
+		compile(arguments[i], target + i);
+	}
+
+	emit(OpCode::call, target, function, arguments.size());
+}
+
+void LuaCompiler::visit(const QSharedPointer<ast::Assignment> &node, const QSharedPointer<core::ast::Node> &)
+{
+	// Assignments to table elements depend on types of indexers, so they are left to tree interpreter.
+	if (!node->variable()->is<ast::Identifier>()) {
+		return;
+	}
+
+	mCompiled = true;
+	const int target = mTarget;
+	const int variable = mInterpreter.variableIndex(as<ast::Identifier>(node->variable())->name());
+	compile(node->value(), target);
+	emit(OpCode::storeVariable, target, variable, 0, addNode(node));
+}
+
+void LuaCompiler::visit(const QSharedPointer<ast::Block> &node, const QSharedPointer<core::ast::Node> &)
+{
+	mCompiled = true;
+	const int target = mTarget;
+	const auto statements = node->children();
+	if (statements.isEmpty()) {
+		emit(OpCode::loadConstant, target, addConstant(LuaValue()));
+	}
+
+	for (const auto &statement : statements) {
+		compile(statement, target);
+	}
+}
@@ -0,0 +1,105 @@
+/* Copyright 2018 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include "qrtext/lua/luaAstVisitorInterface.h"
+#include "qrtext/src/lua/luaBytecode.h"
+
+namespace qrtext {
+namespace lua {
+namespace details {
+
+class LuaInterpreter;
+
+/// Lowers analyzed Lua AST to bytecode for LuaVirtualMachine. Variables and intrinsic functions are resolved to
+/// interpreter slots once, during compilation. Constructs which depend on types of expressions (tables, length
+/// operator) and everything else the compiler does not support are left to the tree interpreter.
+class LuaCompiler : private LuaAstVisitorInterface
+{
+public:
+	/// Constructor.
+	/// @param interpreter - interpreter which owns variables and intrinsic functions and interprets unsupported
+	///        constructs.
+	explicit LuaCompiler(LuaInterpreter &interpreter);
+
+	/// Compiles given AST. Never fails, unsupported subtrees are compiled into calls of tree interpreter.
+	QSharedPointer<LuaBytecode> compile(const QSharedPointer<core::ast::Node> &root);
+
+private:
+	/// Compiles code calculating the value of \a node into register \a target. Registers after \a target may be
+	/// used for temporary values.
+	void compile(const QSharedPointer<core::ast::Node> &node, int target);
+
+	void compileUnaryOperator(const QSharedPointer<core::ast::UnaryOperator> &node, OpCode code);
+	void compileBinaryOperator(const QSharedPointer<core::ast::BinaryOperator> &node, OpCode code
+			, bool reportsErrors = false);
+
+	/// Compiles a call of tree interpreter for the given node.
+	void fallback(const QSharedPointer<core::ast::Node> &node, int target);
+
+	int emit(OpCode code, int a, int b = 0, int c = 0, int node = -1);
+	void patchJump(int instruction);
+	int addNode(const QSharedPointer<core::ast::Node> &node);
+	int addConstant(const LuaValue &value);
+	int useRegister(int index);
+
+	void visit(const QSharedPointer<ast::UnaryMinus> &node, const QSharedPointer<core::ast::Node> &) override;
+	void visit(const QSharedPointer<ast::Not> &node, const QSharedPointer<core::ast::Node> &) override;
+	void visit(const QSharedPointer<ast::BitwiseNegation> &node, const QSharedPointer<core::ast::Node> &) override;
+	void visit(const QSharedPointer<ast::LogicalAnd> &node, const QSharedPointer<core::ast::Node> &) override;
+	void visit(const QSharedPointer<ast::LogicalOr> &node, const QSharedPointer<core::ast::Node> &) override;
+	void visit(const QSharedPointer<ast::Addition> &node, const QSharedPointer<core::ast::Node> &) override;
+	void visit(const QSharedPointer<ast::Subtraction> &node, const QSharedPointer<core::ast::Node> &) override;
+	void visit(const QSharedPointer<ast::Multiplication> &node, const QSharedPointer<core::ast::Node> &) override;
+	void visit(const QSharedPointer<ast::Division> &node, const QSharedPointer<core::ast::Node> &) override;
+	void visit(const QSharedPointer<ast::IntegerDivision> &node, const QSharedPointer<core::ast::Node> &) override;
+	void visit(const QSharedPointer<ast::Modulo> &node, const QSharedPointer<core::ast::Node> &) override;
+	void visit(const QSharedPointer<ast::Exponentiation> &node, const QSharedPointer<core::ast::Node> &) override;
+	void visit(const QSharedPointer<ast::BitwiseAnd> &node, const QSharedPointer<core::ast::Node> &) override;
+	void visit(const QSharedPointer<ast::BitwiseOr> &node, const QSharedPointer<core::ast::Node> &) override;
+	void visit(const QSharedPointer<ast::BitwiseXor> &node, const QSharedPointer<core::ast::Node> &) override;
+	void visit(const QSharedPointer<ast::BitwiseLeftShift> &node, const QSharedPointer<core::ast::Node> &) override;
+	void visit(const QSharedPointer<ast::BitwiseRightShift> &node, const QSharedPointer<core::ast::Node> &) override;
+	void visit(const QSharedPointer<ast::Concatenation> &node, const QSharedPointer<core::ast::Node> &) override;
+	void visit(const QSharedPointer<ast::Equality> &node, const QSharedPointer<core::ast::Node> &) override;
+	void visit(const QSharedPointer<ast::LessThan> &node, const QSharedPointer<core::ast::Node> &) override;
+	void visit(const QSharedPointer<ast::LessOrEqual> &node, const QSharedPointer<core::ast::Node> &) override;
+	void visit(const QSharedPointer<ast::Inequality> &node, const QSharedPointer<core::ast::Node> &) override;
+	void visit(const QSharedPointer<ast::GreaterThan> &node, const QSharedPointer<core::ast::Node> &) override;
+	void visit(const QSharedPointer<ast::GreaterOrEqual> &node, const QSharedPointer<core::ast::Node> &) override;
+	void visit(const QSharedPointer<ast::IntegerNumber> &node, const QSharedPointer<core::ast::Node> &) override;
+	void visit(const QSharedPointer<ast::FloatNumber> &node, const QSharedPointer<core::ast::Node> &) override;
+	void visit(const QSharedPointer<ast::String> &node, const QSharedPointer<core::ast::Node> &) override;
+	void visit(const QSharedPointer<ast::True> &node, const QSharedPointer<core::ast::Node> &) override;
+	void visit(const QSharedPointer<ast::False> &node, const QSharedPointer<core::ast::Node> &) override;
+	void visit(const QSharedPointer<ast::Nil> &node, const QSharedPointer<core::ast::Node> &) override;
+	void visit(const QSharedPointer<ast::Identifier> &node, const QSharedPointer<core::ast::Node> &) override;
+	void visit(const QSharedPointer<ast::FunctionCall> &node, const QSharedPointer<core::ast::Node> &) override;
+	void visit(const QSharedPointer<ast::Assignment> &node, const QSharedPointer<core::ast::Node> &) override;
+	void visit(const QSharedPointer<ast::Block> &node, const QSharedPointer<core::ast::Node> &) override;
+
+	LuaInterpreter &mInterpreter;
+	QSharedPointer<LuaBytecode> mBytecode;
+
+	/// Register the currently visited node shall put its value into.
+	int mTarget;
+
+	/// True if the currently visited node was compiled by one of visit() methods.
+	bool mCompiled;
+};
+
+}
+}
+}
@@ -102,15 +102,7 @@ QVariant LuaInterpreter::interpret(const QSharedPointer<core::ast::Node> &root
 
 		if (variable->is<ast::Identifier>()) {
 			const auto name = as<ast::Identifier>(variable)->name();
-
-			if (mReadOnlyVariables.contains(name)) {
-				mErrors.append(core::Error(root->start(), QObject::tr("Variable %1 is read-only")
-						, core::ErrorType::runtimeError, core::Severity::error));
-
-				return QVariant();
-			}
-
-			mIdentifierValues.insert(name, interpretedValue);
+			assignVariable(variableIndex(name), interpretedValue, root->start());
 			return QVariant();
 		} else if (variable->is<ast::IndexingExpression>()) {
 			assignToTableElement(variable, interpretedValue, semanticAnalyzer);
@@ -123,7 +115,7 @@ QVariant LuaInterpreter::interpret(const QSharedPointer<core::ast::Node> &root
 		return QVariant();
 
 	} else if (root->is<ast::Identifier>()) {
-		return mIdentifierValues.value(as<ast::Identifier>(root)->name());
+		return value(as<ast::Identifier>(root)->name());
 	} else if (root->is<ast::FunctionCall>()) {
 		auto function = as<ast::FunctionCall>(root)->function();
 		auto name = as<ast::Identifier>(function)->name();
@@ -134,7 +126,7 @@ QVariant LuaInterpreter::interpret(const QSharedPointer<core::ast::Node> &root
 			actualParameters << interpret(parameter, semanticAnalyzer);
 		}
 
-		return mIntrinsicFunctions[name](actualParameters);
+		return callIntrinsicFunction(intrinsicFunctionIndex(name), actualParameters);
 	} else if (root->is<ast::IndexingExpression>()) {
 		return slice(root, semanticAnalyzer);
 	} else if (root->is<ast::UnaryOperator>()) {
@@ -158,22 +150,40 @@ QVariant LuaInterpreter::interpret(const QSharedPointer<core::ast::Node> &root
 void LuaInterpreter::addIntrinsicFunction(const QString &name
 		, std::function<QVariant(const QList<QVariant> &)> const &semantic)
 {
-	mIntrinsicFunctions.insert(name, semantic);
+	const int index = intrinsicFunctionIndex(name);
+	if (index >= 0) {
+		mIntrinsicFunctions[index] = semantic;
+	} else {
+		mIntrinsicFunctionIndices.insert(name, mIntrinsicFunctions.size());
+		mIntrinsicFunctions << semantic;
+	}
 }
 
 QStringList LuaInterpreter::identifiers() const
 {
-	return mIdentifierValues.keys();
+	QStringList result;
+	for (const Variable &variable : mVariables) {
+		if (variable.defined) {
+			result << variable.name;
+		}
+	}
+
+	return result;
 }
 
 void LuaInterpreter::forgetIdentifier(const QString &identifier)
 {
-	mIdentifierValues.remove(identifier);
+	const int index = mVariableIndices.value(identifier, -1);
+	if (index >= 0) {
+		mVariables[index].value = QVariant();
+		mVariables[index].defined = false;
+	}
 }
 
 QVariant LuaInterpreter::value(const QString &identifier) const
 {
-	return mIdentifierValues.value(identifier);
+	const int index = mVariableIndices.value(identifier, -1);
+	return index >= 0 ? mVariables[index].value : QVariant();
 }
 
 void LuaInterpreter::setVariableValue(const QString &name, const QVariant &value)
@@ -187,21 +197,75 @@ void LuaInterpreter::setVariableValue(const QString &name, const QVariant &value
 		// It is a string variable, chop off quotes.
 		valueString.remove(0, 1);
 		valueString.chop(1);
-		mIdentifierValues.insert(name, valueString);
+		storeVariable(name, valueString);
 	} else {
-		mIdentifierValues.insert(name, value);
+		storeVariable(name, value);
 	}
 }
 
 void LuaInterpreter::addReadOnlyVariable(const QString &name)
 {
-	mReadOnlyVariables.insert(name);
+	mVariables[variableIndex(name)].readOnly = true;
 }
 
 void LuaInterpreter::clear()
 {
-	mIdentifierValues.clear();
-	mReadOnlyVariables.clear();
+	for (Variable &variable : mVariables) {
+		variable.value = QVariant();
+		variable.defined = false;
+		variable.readOnly = false;
+	}
+}
+
+int LuaInterpreter::variableIndex(const QString &name)
+{
+	const auto existing = mVariableIndices.constFind(name);
+	if (existing != mVariableIndices.constEnd()) {
+		return existing.value();
+	}
+
+	Variable variable;
+	variable.name = name;
+	mVariables << variable;
+	mVariableIndices.insert(name, mVariables.size() - 1);
+	return mVariables.size() - 1;
+}
+
+const QVariant &LuaInterpreter::variableValue(int index) const
+{
+	return mVariables[index].value;
+}
+
+bool LuaInterpreter::assignVariable(int index, const QVariant &value, const core::Connection &connection)
+{
+	Variable &variable = mVariables[index];
+	if (variable.readOnly) {
+		mErrors.append(core::Error(connection, QObject::tr("Variable %1 is read-only")
+				, core::ErrorType::runtimeError, core::Severity::error));
+
+		return false;
+	}
+
+	variable.value = value;
+	variable.defined = true;
+	return true;
+}
+
+int LuaInterpreter::intrinsicFunctionIndex(const QString &name) const
+{
+	return mIntrinsicFunctionIndices.value(name, -1);
+}
+
+QVariant LuaInterpreter::callIntrinsicFunction(int index, const QList<QVariant> &arguments) const
+{
+	return index >= 0 ? mIntrinsicFunctions[index](arguments) : QVariant();
+}
+
+void LuaInterpreter::storeVariable(const QString &name, const QVariant &value)
+{
+	Variable &variable = mVariables[variableIndex(name)];
+	variable.value = value;
+	variable.defined = true;
 }
 
 QVariant LuaInterpreter::interpretUnaryOperator(const QSharedPointer<core::ast::Node> &root
@@ -359,7 +423,7 @@ QVariant LuaInterpreter::operateOnIndexingExpressionRecursive(const QSharedPoint
 		const auto name = as<ast::Identifier>(node->table())->name();
 		if (semanticAnalyzer.type(node->indexer())->is<types::Number>()) {
 			const auto index = interpret(node->indexer(), semanticAnalyzer).toInt();
-			const auto table = mIdentifierValues.value(name).value<QVariantList>();
+			const auto table = value(name).value<QVariantList>();
 
 			return action(name, table, QVector<int>{index} + currentIndex, node->start());
 		}
@@ -425,7 +489,7 @@ void LuaInterpreter::assignToTableElement(const QSharedPointer<core::ast::Node>
 			, const QVector<int> &index
 			, const core::Connection &connection)
 	{
-		mIdentifierValues.insert(name, doAssignToTableElement(table, interpretedValue, index, connection));
+		storeVariable(name, doAssignToTableElement(table, interpretedValue, index, connection));
 		return QVariant();
 	};
 
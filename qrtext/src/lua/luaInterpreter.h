@@ -17,6 +17,7 @@
 #include <functional>
 #include <QtCore/QHash>
 #include <QtCore/QVariantList>
+#include <QtCore/QVector>
 
 #include "qrtext/core/error.h"
 #include "qrtext/core/ast/node.h"
@@ -67,7 +68,37 @@ public:
 	/// Clear all execution state, except added intrinsic functions.
 	void clear();
 
+	/// Returns the number of the slot where variable with given name is stored, registers the slot if needed.
+	/// Slots are never removed, so compiled code may refer to variables by these numbers.
+	int variableIndex(const QString &name);
+
+	/// Returns a value of a variable stored in the given slot.
+	const QVariant &variableValue(int index) const;
+
+	/// Assigns a value to a variable stored in the given slot as assignment statement does: reports an error
+	/// with given connection and returns false if the variable is read-only.
+	bool assignVariable(int index, const QVariant &value, const core::Connection &connection);
+
+	/// Returns the number of an intrinsic function with given name or -1 if there is no such function.
+	int intrinsicFunctionIndex(const QString &name) const;
+
+	/// Calls an intrinsic function with given number.
+	QVariant callIntrinsicFunction(int index, const QList<QVariant> &arguments) const;
+
 private:
+	/// A variable in a slot. Forgotten and cleared variables keep their slots, but are not defined.
+	struct Variable
+	{
+		QString name;
+		QVariant value;
+		bool defined = false;
+
+		/// Variable can be modified only by setVariableValue() call (used to support sensor variables and ailases).
+		bool readOnly = false;
+	};
+
+	void storeVariable(const QString &name, const QVariant &value);
+
 	QVariant interpretUnaryOperator(const QSharedPointer<core::ast::Node> &root
 			, const core::SemanticAnalyzer &semanticAnalyzer);
 
@@ -102,12 +133,10 @@ private:
 					, const QVector<int> &
 					, const core::Connection &)> &action);
 
-	QHash<QString, QVariant> mIdentifierValues;
-	QHash<QString, std::function<QVariant(const QList<QVariant> &)>> mIntrinsicFunctions;
-
-	/// A set of variables which can be modified only by setVariableValue() call (used to support sensor variables and
-	/// ailases)
-	QSet<QString> mReadOnlyVariables;
+	QHash<QString, int> mVariableIndices;
+	QVector<Variable> mVariables;
+	QHash<QString, int> mIntrinsicFunctionIndices;
+	QVector<std::function<QVariant(const QList<QVariant> &)>> mIntrinsicFunctions;
 
 	QList<core::Error> &mErrors;
 };
@@ -18,11 +18,230 @@ using namespace qrtext::lua;
 using namespace qrtext::lua::details;
 using namespace qrtext::core;
 
+namespace {
+
+struct Keyword
+{
+	LuaTokenTypes type;
+	const char *lexeme;
+};
+
+const Keyword keywords[] = {
+	{LuaTokenTypes::andKeyword, "and"}
+	, {LuaTokenTypes::breakKeyword, "break"}
+	, {LuaTokenTypes::doKeyword, "do"}
+	, {LuaTokenTypes::elseKeyword, "else"}
+	, {LuaTokenTypes::elseifKeyword, "elseif"}
+	, {LuaTokenTypes::endKeyword, "end"}
+	, {LuaTokenTypes::falseKeyword, "false"}
+	, {LuaTokenTypes::forKeyword, "for"}
+	, {LuaTokenTypes::functionKeyword, "function"}
+	, {LuaTokenTypes::gotoKeyword, "goto"}
+	, {LuaTokenTypes::ifKeyword, "if"}
+	, {LuaTokenTypes::inKeyword, "in"}
+	, {LuaTokenTypes::localKeyword, "local"}
+	, {LuaTokenTypes::nilKeyword, "nil"}
+	, {LuaTokenTypes::notKeyword, "not"}
+	, {LuaTokenTypes::orKeyword, "or"}
+	, {LuaTokenTypes::repeatKeyword, "repeat"}
+	, {LuaTokenTypes::returnKeyword, "return"}
+	, {LuaTokenTypes::thenKeyword, "then"}
+	, {LuaTokenTypes::trueKeyword, "true"}
+	, {LuaTokenTypes::untilKeyword, "until"}
+	, {LuaTokenTypes::whileKeyword, "while"}
+};
+
+/// Character classes of ASCII symbols, everything above 127 is either a letter or an unknown symbol.
+enum CharacterClass : quint8
+{
+	other = 0
+	, letter = 1
+	, digit = 2
+	, hexDigit = 4
+	, space = 8
+};
+
+struct CharacterTable
+{
+	CharacterTable()
+	{
+		for (int c = 0; c < 128; ++c) {
+			quint8 value = other;
+			if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_') {
+				value |= letter;
+			}
+
+			if (c >= '0' && c <= '9') {
+				value |= digit | hexDigit;
+			}
+
+			if ((c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F')) {
+				value |= hexDigit;
+			}
+
+			if (c == ' ' || c == '\t') {
+				value |= space;
+			}
+
+			classes[c] = value;
+		}
+	}
+
+	quint8 classes[128];
+};
+
+const CharacterTable characterTable;
+
+inline bool hasClass(const QString &input, int position, quint8 characterClass)
+{
+	if (position >= input.length()) {
+		return false;
+	}
+
+	const ushort c = input.at(position).unicode();
+	return c < 128 && (characterTable.classes[c] & characterClass);
+}
+
+inline bool isOneOf(const QString &input, int position, char first, char second)
+{
+	if (position >= input.length()) {
+		return false;
+	}
+
+	const QChar c = input.at(position);
+	return c == QLatin1Char(first) || c == QLatin1Char(second);
+}
+
+/// Returns the number of UTF-16 code units taken by a letter at the given position (as \p{L} in regexps, so
+/// letters outside of Basic Multilingual Plane are supported), or 0 if there is no letter there.
+inline int letterLength(const QString &input, int position)
+{
+	const ushort c = input.at(position).unicode();
+	if (c < 128) {
+		return (characterTable.classes[c] & letter) ? 1 : 0;
+	}
+
+	if (QChar::isHighSurrogate(c) && position + 1 < input.length()
+			&& QChar::isLowSurrogate(input.at(position + 1).unicode()))
+	{
+		return QChar::isLetter(QChar::surrogateToUcs4(c, input.at(position + 1).unicode())) ? 2 : 0;
+	}
+
+	return QChar::isLetter(c) ? 1 : 0;
+}
+
+const QHash<QString, LuaTokenTypes> &keywordTypes()
+{
+	static const QHash<QString, LuaTokenTypes> result = [] {
+		QHash<QString, LuaTokenTypes> types;
+		for (const Keyword &keyword : keywords) {
+			types.insert(keyword.lexeme, keyword.type);
+		}
+
+		return types;
+	}();
+
+	return result;
+}
+
+}
+
 LuaLexer::LuaLexer(QList<core::Error> &errors)
 	: Lexer<LuaTokenTypes>(initPatterns(), errors)
+	, mErrors(errors)
 {
 }
 
+QList<Token<LuaTokenTypes>> LuaLexer::tokenize(const QString &input)
+{
+	mComments.clear();
+
+	QList<Token<LuaTokenTypes>> result;
+
+	// Connection is maintained exactly as core::Lexer does it.
+	int absolutePosition = 0;
+	int line = 0;
+	int column = 0;
+
+	while (absolutePosition < input.length()) {
+		LuaTokenTypes tokenType = LuaTokenTypes::whitespace;
+		const int length = scanToken(input, absolutePosition, tokenType);
+
+		if (length == 0) {
+			const auto errorConnection = Connection(absolutePosition, line, column);
+			const int errorStart = absolutePosition;
+
+			// Panic mode: syncing on nearest whitespace or newline.
+			while (absolutePosition < input.length()
+					&& !hasClass(input, absolutePosition, space)
+					&& input.at(absolutePosition) != QLatin1Char('\n'))
+			{
+				++absolutePosition;
+				++column;
+			}
+
+			mErrors << Error(errorConnection
+					, QObject::tr("Unknown sequence of symbols: ")
+							+ input.mid(errorStart, absolutePosition - errorStart)
+					, ErrorType::lexicalError
+					, Severity::error);
+
+			continue;
+		}
+
+		switch (tokenType) {
+		case LuaTokenTypes::whitespace:
+			column += length;
+			break;
+		case LuaTokenTypes::newline:
+			++line;
+			column = 0;
+			break;
+		case LuaTokenTypes::comment:
+			mComments << Token<LuaTokenTypes>(tokenType
+					, Range(Connection(absolutePosition, line, column)
+							, Connection(absolutePosition + length - 1, line, column + length - 1))
+					, input.mid(absolutePosition, length));
+			column += length;
+			break;
+		default: {
+			const QString lexeme = input.mid(absolutePosition, length);
+			int tokenEndLine = line;
+			int tokenEndColumn = column + length - 1;
+
+			// String is the only token that can span multiple lines.
+			if (tokenType == LuaTokenTypes::string) {
+				const int lastNewLine = lexeme.lastIndexOf(QLatin1Char('\n'));
+				if (lastNewLine != -1) {
+					tokenEndLine += lexeme.count(QLatin1Char('\n'));
+					tokenEndColumn = length - lastNewLine - 2;
+				}
+			} else if (tokenType == LuaTokenTypes::identifier) {
+				tokenType = keywordTypes().value(lexeme, LuaTokenTypes::identifier);
+			}
+
+			result << Token<LuaTokenTypes>(tokenType
+					, Range(Connection(absolutePosition, line, column)
+							, Connection(absolutePosition + length - 1, tokenEndLine, tokenEndColumn))
+					, lexeme);
+
+			line = tokenEndLine;
+			column = tokenEndColumn + 1;
+			break;
+		}
+		}
+
+		absolutePosition += length;
+	}
+
+	return result;
+}
+
+QList<Token<LuaTokenTypes>> LuaLexer::comments() const
+{
+	return mComments;
+}
+
 TokenPatterns<LuaTokenTypes> LuaLexer::initPatterns()
 {
 	TokenPatterns<LuaTokenTypes> tokenDefinitions;
@@ -33,28 +252,9 @@ TokenPatterns<LuaTokenTypes> LuaLexer::initPatterns()
 			, QRegularExpression(R"([\p{L}_][\p{L}0-9_]*)")
 			, QObject::tr("identifier"));
 
-	tokenDefinitions.defineKeyword(LuaTokenTypes::andKeyword, "and");
-	tokenDefinitions.defineKeyword(LuaTokenTypes::breakKeyword, "break");
-	tokenDefinitions.defineKeyword(LuaTokenTypes::doKeyword, "do");
-	tokenDefinitions.defineKeyword(LuaTokenTypes::elseKeyword, "else");
-	tokenDefinitions.defineKeyword(LuaTokenTypes::elseifKeyword, "elseif");
-	tokenDefinitions.defineKeyword(LuaTokenTypes::endKeyword, "end");
-	tokenDefinitions.defineKeyword(LuaTokenTypes::falseKeyword, "false");
-	tokenDefinitions.defineKeyword(LuaTokenTypes::forKeyword, "for");
-	tokenDefinitions.defineKeyword(LuaTokenTypes::functionKeyword, "function");
-	tokenDefinitions.defineKeyword(LuaTokenTypes::gotoKeyword, "goto");
-	tokenDefinitions.defineKeyword(LuaTokenTypes::ifKeyword, "if");
-	tokenDefinitions.defineKeyword(LuaTokenTypes::inKeyword, "in");
-	tokenDefinitions.defineKeyword(LuaTokenTypes::localKeyword, "local");
-	tokenDefinitions.defineKeyword(LuaTokenTypes::nilKeyword, "nil");
-	tokenDefinitions.defineKeyword(LuaTokenTypes::notKeyword, "not");
-	tokenDefinitions.defineKeyword(LuaTokenTypes::orKeyword, "or");
-	tokenDefinitions.defineKeyword(LuaTokenTypes::repeatKeyword, "repeat");
-	tokenDefinitions.defineKeyword(LuaTokenTypes::returnKeyword, "return");
-	tokenDefinitions.defineKeyword(LuaTokenTypes::thenKeyword, "then");
-	tokenDefinitions.defineKeyword(LuaTokenTypes::trueKeyword, "true");
-	tokenDefinitions.defineKeyword(LuaTokenTypes::untilKeyword, "until");
-	tokenDefinitions.defineKeyword(LuaTokenTypes::whileKeyword, "while");
+	for (const Keyword &keyword : keywords) {
+		tokenDefinitions.defineKeyword(keyword.type, keyword.lexeme);
+	}
 
 	tokenDefinitions.defineToken(LuaTokenTypes::plus, QRegularExpression("\\+"), "+");
 	tokenDefinitions.defineToken(LuaTokenTypes::minus, QRegularExpression("-"), "-");
@@ -126,3 +326,184 @@ TokenPatterns<LuaTokenTypes> LuaLexer::initPatterns()
 
 	return tokenDefinitions;
 }
+
+int LuaLexer::scanToken(const QString &input, int position, LuaTokenTypes &tokenType)
+{
+	const int size = input.length();
+	const auto at = [&input, size](int index) {
+		return index < size ? input.at(index).unicode() : 0;
+	};
+
+	const ushort c = at(position);
+
+	if (hasClass(input, position, space)) {
+		int end = position + 1;
+		while (hasClass(input, end, space)) {
+			++end;
+		}
+
+		tokenType = LuaTokenTypes::whitespace;
+		return end - position;
+	}
+
+	if (hasClass(input, position, digit)) {
+		return scanNumber(input, position, tokenType);
+	}
+
+	int letterSize = letterLength(input, position);
+	if (letterSize > 0) {
+		int end = position + letterSize;
+		while (end < size) {
+			letterSize = hasClass(input, end, digit) ? 1 : letterLength(input, end);
+			if (letterSize == 0) {
+				break;
+			}
+
+			end += letterSize;
+		}
+
+		tokenType = LuaTokenTypes::identifier;
+		return end - position;
+	}
+
+	// Operators, the longest one wins.
+	const auto token = [&tokenType](LuaTokenTypes type, int length) {
+		tokenType = type;
+		return length;
+	};
+
+	const ushort next = at(position + 1);
+
+	switch (c) {
+	case '\n':
+		return token(LuaTokenTypes::newline, 1);
+	case '"':
+	case '\'': {
+		tokenType = LuaTokenTypes::string;
+		return scanString(input, position);
+	}
+	case '-':
+		if (next == '-') {
+			const int end = input.indexOf(QLatin1Char('\n'), position);
+			return token(LuaTokenTypes::comment, (end == -1 ? size : end) - position);
+		}
+
+		return token(LuaTokenTypes::minus, 1);
+	case '+':
+		return token(LuaTokenTypes::plus, 1);
+	case '*':
+		return token(LuaTokenTypes::asterick, 1);
+	case '/':
+		return next == '/' ? token(LuaTokenTypes::doubleSlash, 2) : token(LuaTokenTypes::slash, 1);
+	case '%':
+		return token(LuaTokenTypes::percent, 1);
+	case '^':
+		return token(LuaTokenTypes::hat, 1);
+	case '#':
+		return token(LuaTokenTypes::sharp, 1);
+	case '&':
+		return next == '&' ? token(LuaTokenTypes::doubleAmpersand, 2) : token(LuaTokenTypes::ampersand, 1);
+	case '|':
+		return next == '|' ? token(LuaTokenTypes::doubleVerticalLine, 2) : token(LuaTokenTypes::verticalLine, 1);
+	case '~':
+		return next == '=' ? token(LuaTokenTypes::tildaEquals, 2) : token(LuaTokenTypes::tilda, 1);
+	case '!':
+		return next == '=' ? token(LuaTokenTypes::exclamationMarkEquals, 2) : 0;
+	case '=':
+		return next == '=' ? token(LuaTokenTypes::doubleEquals, 2) : token(LuaTokenTypes::equals, 1);
+	case '<':
+		return next == '<' ? token(LuaTokenTypes::doubleLess, 2)
+				: next == '=' ? token(LuaTokenTypes::lessEquals, 2)
+				: token(LuaTokenTypes::less, 1);
+	case '>':
+		return next == '>' ? token(LuaTokenTypes::doubleGreater, 2)
+				: next == '=' ? token(LuaTokenTypes::greaterEquals, 2)
+				: token(LuaTokenTypes::greater, 1);
+	case '(':
+		return token(LuaTokenTypes::openingBracket, 1);
+	case ')':
+		return token(LuaTokenTypes::closingBracket, 1);
+	case '{':
+		return token(LuaTokenTypes::openingCurlyBracket, 1);
+	case '}':
+		return token(LuaTokenTypes::closingCurlyBracket, 1);
+	case '[':
+		return token(LuaTokenTypes::openingSquareBracket, 1);
+	case ']':
+		return token(LuaTokenTypes::closingSquareBracket, 1);
+	case ':':
+		return next == ':' ? token(LuaTokenTypes::doubleColon, 2) : token(LuaTokenTypes::colon, 1);
+	case ';':
+		return token(LuaTokenTypes::semicolon, 1);
+	case ',':
+		return token(LuaTokenTypes::comma, 1);
+	case '.':
+		if (next == '.') {
+			return at(position + 2) == '.' ? token(LuaTokenTypes::tripleDot, 3) : token(LuaTokenTypes::doubleDot, 2);
+		}
+
+		return token(LuaTokenTypes::dot, 1);
+	default:
+		return 0;
+	}
+}
+
+int LuaLexer::scanNumber(const QString &input, int position, LuaTokenTypes &tokenType)
+{
+	// Follows integer and float literal patterns: mantissa is followed by optional fraction and optional exponent,
+	// a literal with fraction or exponent is float. Fraction requires at least one digit after the dot, exponent
+	// sign requires at least one digit after it, otherwise the sign is not a part of the literal.
+	const bool isHex = input.at(position) == QLatin1Char('0') && isOneOf(input, position + 1, 'x', 'X')
+			&& hasClass(input, position + 2, hexDigit);
+
+	const quint8 digits = isHex ? hexDigit : digit;
+	const char exponentLower = isHex ? 'p' : 'e';
+	const char exponentUpper = isHex ? 'P' : 'E';
+
+	int end = isHex ? position + 2 : position;
+	while (hasClass(input, end, digits)) {
+		++end;
+	}
+
+	tokenType = LuaTokenTypes::integerLiteral;
+
+	if (input.length() > end && input.at(end) == QLatin1Char('.') && hasClass(input, end + 1, digits)) {
+		tokenType = LuaTokenTypes::floatLiteral;
+		end += 2;
+		while (hasClass(input, end, digits)) {
+			++end;
+		}
+	}
+
+	if (isOneOf(input, end, exponentLower, exponentUpper)) {
+		tokenType = LuaTokenTypes::floatLiteral;
+		++end;
+		if (isOneOf(input, end, '+', '-') && hasClass(input, end + 1, digits)) {
+			++end;
+		}
+
+		while (hasClass(input, end, digits)) {
+			++end;
+		}
+	}
+
+	return end - position;
+}
+
+int LuaLexer::scanString(const QString &input, int position)
+{
+	const QChar quote = input.at(position);
+	int end = position + 1;
+	while (end < input.length()) {
+		const QChar c = input.at(end);
+		if (c == quote) {
+			return end + 1 - position;
+		}
+
+		// Escaped symbol may be anything, including newline and quote.
+		end += c == QLatin1Char('\\') ? 2 : 1;
+	}
+
+	// Unterminated string is not a token at all.
+	return 0;
+}
@@ -23,11 +23,14 @@ namespace qrtext {
 namespace lua {
 namespace details {
 
-/// Lexer of something like Lua 5.3 based on regular expressions. Provides a list of tokens by given input string.
-/// Allows Unicode input.
+/// Lexer of something like Lua 5.3. Provides a list of tokens by given input string. Allows Unicode input.
 ///
-/// Now lexer (with default token patterns) follows Lua 5.3 specification with following exceptions:
+/// Now lexer follows Lua 5.3 specification with following exceptions:
 /// - long brackets are not supported, either for string literals or for comments.
+///
+/// Token patterns are still defined as regular expressions for generic core::Lexer (they give user-friendly token
+/// names and serve as a reference implementation), but tokenize() scans input by hand, looking at each symbol once.
+/// It produces exactly the same tokens, connections, comments and errors as regexp-based lexer, only much faster.
 class LuaLexer: public core::Lexer<LuaTokenTypes>
 {
 public:
@@ -35,8 +38,25 @@ public:
 	/// @param errors - error stream to report errors to.
 	LuaLexer(QList<core::Error> &errors);
 
+	/// Tokenizes input string, returns list of detected tokens, reports errors and collects comments.
+	/// Hides core::Lexer::tokenize() which can still be called explicitly to get regexp-based result.
+	QList<core::Token<LuaTokenTypes>> tokenize(const QString &input);
+
+	/// Returns a list of comments from last tokenize() call.
+	QList<core::Token<LuaTokenTypes>> comments() const;
+
 private:
 	static core::TokenPatterns<LuaTokenTypes> initPatterns();
+
+	/// Returns the length of a token starting at \a position and writes its type to \a tokenType, or returns 0 if
+	/// no token starts there. Keywords are reported as identifiers.
+	static int scanToken(const QString &input, int position, LuaTokenTypes &tokenType);
+
+	static int scanNumber(const QString &input, int position, LuaTokenTypes &tokenType);
+	static int scanString(const QString &input, int position);
+
+	QList<core::Error> &mErrors;
+	QList<core::Token<LuaTokenTypes>> mComments;
 };
 
 }
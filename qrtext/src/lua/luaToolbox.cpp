@@ -20,16 +20,26 @@
 #include "qrtext/src/lua/luaParser.h"
 #include "qrtext/src/lua/luaSemanticAnalyzer.h"
 #include "qrtext/src/lua/luaInterpreter.h"
+#include "qrtext/src/lua/luaCompiler.h"
+#include "qrtext/src/lua/luaVirtualMachine.h"
+#include "qrtext/src/lua/luaAstCache.h"
 
 using namespace qrtext::lua;
 using namespace qrtext::core;
 using namespace qrtext::core::ast;
 
+/// Number of distinct code fragments whose ASTs are kept. Real diagrams rarely have so many different expressions,
+/// so the bound only keeps memory of long editing sessions in check.
+static const int astCacheCapacity = 4096;
+
 LuaToolbox::LuaToolbox()
 	: mLexer(new details::LuaLexer(mErrors))
 	, mParser(new details::LuaParser(mErrors))
 	, mAnalyzer(new details::LuaSemanticAnalyzer(mErrors))
 	, mInterpreter(new details::LuaInterpreter(mErrors))
+	, mCompiler(new details::LuaCompiler(*mInterpreter))
+	, mVirtualMachine(new details::LuaVirtualMachine(*mInterpreter, mErrors))
+	, mAstCache(new details::LuaAstCache(astCacheCapacity))
 {
 }
 
@@ -39,7 +49,10 @@ LuaToolbox::~LuaToolbox()
 
 QVariant LuaToolbox::interpret(QSharedPointer<Node> const &root)
 {
-	const auto result = mInterpreter->interpret(root, *mAnalyzer);
+	const QSharedPointer<details::LuaBytecode> bytecode = mBytecode.value(root);
+	const auto result = bytecode
+			? mVirtualMachine->run(*bytecode, *mAnalyzer)
+			: mInterpreter->interpret(root, *mAnalyzer);
 	reportErrors();
 	return result;
 }
@@ -59,35 +72,72 @@ QSharedPointer<Node> const &LuaToolbox::parse(const qReal::Id &id, const QString
 {
 	mErrors.clear();
 
-	QSharedPointer<Node> ast;
+	QSharedPointer<Node> ast = mParsedCache[id].contains(propertyName) && mParsedCache[id][propertyName] == code
+			? mAstRoots[id][propertyName]
+			: mAstCache->find(code);
 
-	if (mParsedCache[id][propertyName] != code) {
+	if (!ast) {
 		auto tokenStream = mLexer->tokenize(code);
-
 		ast = mParser->parse(tokenStream, mLexer->userFriendlyTokenNames());
-
-		if (mErrors.isEmpty()) {
-			mAnalyzer->forget(mAstRoots[id][propertyName]);
-			mAstRoots[id][propertyName] = ast;
-		}
-
-		mParsedCache[id][propertyName] = code;
-	} else {
-		ast = mAstRoots[id][propertyName];
 	}
 
 	if (mErrors.isEmpty()) {
 		mAnalyzer->analyze(ast);
 	}
 
-	if (!mErrors.isEmpty()) {
+	if (mErrors.isEmpty()) {
+		if (!mBytecode.contains(ast)) {
+			mBytecode.insert(ast, mCompiler->compile(ast));
+		}
+
+		setAst(id, propertyName, code, ast);
+		if (ast) {
+			for (const QSharedPointer<Node> &evicted : mAstCache->insert(code, ast)) {
+				release(evicted);
+			}
+		}
+	} else {
+		// The property gets AST of its new code even if the code is wrong, not the one of the code it had before.
+		// Code shall be parsed anew next time, types of this AST may be already spoiled by this analysis.
+		setAst(id, propertyName, code, ast);
 		mParsedCache[id].remove(propertyName);
+		mAstCache->remove(code);
 		reportErrors();
 	}
 
 	return mAstRoots[id][propertyName];
 }
 
+void LuaToolbox::setAst(const qReal::Id &id, const QString &propertyName, const QString &code
+		, const QSharedPointer<Node> &ast)
+{
+	const QSharedPointer<Node> previous = mAstRoots[id].value(propertyName);
+	mAstRoots[id][propertyName] = ast;
+	mParsedCache[id][propertyName] = code;
+
+	if (previous != ast) {
+		if (ast) {
+			++mAstUsers[ast.data()];
+		}
+
+		if (previous) {
+			--mAstUsers[previous.data()];
+			release(previous);
+		}
+	}
+}
+
+void LuaToolbox::release(const QSharedPointer<Node> &ast)
+{
+	if (!ast || mAstUsers.value(ast.data()) > 0 || mAstCache->contains(ast)) {
+		return;
+	}
+
+	mAstUsers.remove(ast.data());
+	mAnalyzer->forget(ast);
+	mBytecode.remove(ast);
+}
+
 QSharedPointer<Node> LuaToolbox::ast(const qReal::Id &id, const QString &propertyName) const
 {
 	return mAstRoots[id][propertyName];
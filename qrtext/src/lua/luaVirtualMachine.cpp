@@ -0,0 +1,189 @@
+/* Copyright 2018 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "qrtext/src/lua/luaVirtualMachine.h"
+
+#include <QtCore/QtMath>
+#include <QtCore/QVarLengthArray>
+
+#include "qrtext/src/lua/luaInterpreter.h"
+
+using namespace qrtext;
+using namespace qrtext::lua::details;
+
+LuaVirtualMachine::LuaVirtualMachine(LuaInterpreter &interpreter, QList<core::Error> &errors)
+	: mInterpreter(interpreter)
+	, mErrors(errors)
+{
+}
+
+QVariant LuaVirtualMachine::run(const LuaBytecode &bytecode, const core::SemanticAnalyzer &semanticAnalyzer)
+{
+	QVarLengthArray<LuaValue, 16> registers(bytecode.registersCount);
+	const Instruction * const code = bytecode.code.constData();
+	const int size = bytecode.code.size();
+
+	// Operations on numbers convert operands exactly as tree interpreter does, so results do not depend on
+	// the way a chunk is executed.
+	for (int pc = 0; pc < size; ++pc) {
+		const Instruction &instruction = code[pc];
+		LuaValue &result = registers[instruction.a];
+		switch (instruction.code) {
+		case OpCode::loadConstant:
+			result = bytecode.constants[instruction.b];
+			break;
+		case OpCode::loadVariable:
+			result = LuaValue::fromVariant(mInterpreter.variableValue(instruction.b));
+			break;
+		case OpCode::storeVariable:
+			mInterpreter.assignVariable(instruction.b, result.toVariant(), bytecode.nodes[instruction.node]->start());
+			result = LuaValue();
+			break;
+		case OpCode::call: {
+			QList<QVariant> arguments;
+			arguments.reserve(instruction.c);
+			for (int i = 0; i < instruction.c; ++i) {
+				arguments << registers[instruction.a + i].toVariant();
+			}
+
+			result = LuaValue::fromVariant(mInterpreter.callIntrinsicFunction(instruction.b, arguments));
+			break;
+		}
+		case OpCode::interpret:
+			result = LuaValue::fromVariant(mInterpreter.interpret(bytecode.nodes[instruction.b], semanticAnalyzer));
+			break;
+		case OpCode::jump:
+			pc = instruction.b - 1;
+			break;
+		case OpCode::jumpIfZero:
+			if (result.toInt() == 0) {
+				pc = instruction.b - 1;
+			}
+
+			break;
+		case OpCode::jumpIfNotZero:
+			if (result.toInt() != 0) {
+				pc = instruction.b - 1;
+			}
+
+			break;
+		case OpCode::unaryMinus:
+			result = LuaValue::fromVariant(-registers[instruction.b].toVariant().toFloat());
+			break;
+		case OpCode::logicalNot: {
+			// Same as the tree interpreter: nil is false, other values are converted like QVariant::toBool() does.
+			const LuaValue &operand = registers[instruction.b];
+			result = LuaValue::fromBool(operand.isNull() || !operand.toBool());
+			break;
+		}
+		case OpCode::bitwiseNegation:
+			result = LuaValue::fromInt(~registers[instruction.b].toInt());
+			break;
+		case OpCode::addition:
+			result = LuaValue::fromReal(registers[instruction.b].toReal() + registers[instruction.c].toReal());
+			break;
+		case OpCode::subtraction:
+			result = LuaValue::fromReal(registers[instruction.b].toReal() - registers[instruction.c].toReal());
+			break;
+		case OpCode::multiplication:
+			result = LuaValue::fromReal(registers[instruction.b].toReal() * registers[instruction.c].toReal());
+			break;
+		case OpCode::division: {
+			const double left = registers[instruction.b].toReal();
+			const double right = registers[instruction.c].toReal();
+			if (right != 0) {
+				result = LuaValue::fromReal(left / right);
+			} else {
+				reportError(bytecode, instruction, QObject::tr("Division by zero"));
+				result = LuaValue::fromInt(0);
+			}
+
+			break;
+		}
+		case OpCode::integerDivision: {
+			const int left = registers[instruction.b].toInt();
+			const int right = registers[instruction.c].toInt();
+			if (right != 0) {
+				result = LuaValue::fromInt(left / right);
+			} else {
+				reportError(bytecode, instruction, QObject::tr("Division by zero"));
+				result = LuaValue::fromInt(0);
+			}
+
+			break;
+		}
+		case OpCode::modulo: {
+			const int left = registers[instruction.b].toInt();
+			const int right = registers[instruction.c].toInt();
+			if (right != 0) {
+				result = LuaValue::fromInt(left % right);
+			} else {
+				reportError(bytecode, instruction, QObject::tr("Division by zero"));
+				result = LuaValue::fromInt(0);
+			}
+
+			break;
+		}
+		case OpCode::exponentiation:
+			result = LuaValue::fromReal(qPow(registers[instruction.b].toReal(), registers[instruction.c].toReal()));
+			break;
+		case OpCode::bitwiseAnd:
+			result = LuaValue::fromInt(registers[instruction.b].toInt() & registers[instruction.c].toInt());
+			break;
+		case OpCode::bitwiseOr:
+			result = LuaValue::fromInt(registers[instruction.b].toInt() | registers[instruction.c].toInt());
+			break;
+		case OpCode::bitwiseXor:
+			result = LuaValue::fromInt(registers[instruction.b].toInt() ^ registers[instruction.c].toInt());
+			break;
+		case OpCode::bitwiseLeftShift:
+			result = LuaValue::fromInt(registers[instruction.b].toInt() << registers[instruction.c].toInt());
+			break;
+		case OpCode::bitwiseRightShift:
+			result = LuaValue::fromInt(registers[instruction.b].toInt() >> registers[instruction.c].toInt());
+			break;
+		case OpCode::concatenation:
+			result = LuaValue::fromVariant(registers[instruction.b].toVariant().toString()
+					+ registers[instruction.c].toVariant().toString());
+			break;
+		case OpCode::lessThan:
+			result = LuaValue::fromBool(registers[instruction.b].toReal() < registers[instruction.c].toReal());
+			break;
+		case OpCode::lessOrEqual:
+			result = LuaValue::fromBool(registers[instruction.b].toReal() <= registers[instruction.c].toReal());
+			break;
+		case OpCode::greaterThan:
+			result = LuaValue::fromBool(registers[instruction.b].toReal() > registers[instruction.c].toReal());
+			break;
+		case OpCode::greaterOrEqual:
+			result = LuaValue::fromBool(registers[instruction.b].toReal() >= registers[instruction.c].toReal());
+			break;
+		case OpCode::equality:
+			result = LuaValue::fromBool(registers[instruction.b].equals(registers[instruction.c]));
+			break;
+		case OpCode::inequality:
+			result = LuaValue::fromBool(!registers[instruction.b].equals(registers[instruction.c]));
+			break;
+		}
+	}
+
+	return registers[0].toVariant();
+}
+
+void LuaVirtualMachine::reportError(const LuaBytecode &bytecode, const Instruction &instruction
+		, const QString &message)
+{
+	mErrors.append(core::Error(bytecode.nodes[instruction.node]->start(), message
+			, core::ErrorType::runtimeError, core::Severity::error));
+}
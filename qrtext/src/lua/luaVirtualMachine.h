@@ -0,0 +1,50 @@
+/* Copyright 2018 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include "qrtext/core/error.h"
+#include "qrtext/core/semantics/semanticAnalyzer.h"
+#include "qrtext/src/lua/luaBytecode.h"
+
+namespace qrtext {
+namespace lua {
+namespace details {
+
+class LuaInterpreter;
+
+/// Register machine executing bytecode produced by LuaCompiler. Results and side effects are the same as
+/// LuaInterpreter gives for the AST the bytecode was compiled from, variables are shared with the interpreter.
+class LuaVirtualMachine
+{
+public:
+	/// Constructor.
+	/// @param interpreter - interpreter which owns variables and intrinsic functions.
+	/// @param errors - error stream to report errors to.
+	LuaVirtualMachine(LuaInterpreter &interpreter, QList<core::Error> &errors);
+
+	/// Executes given bytecode and returns the result of calculation or QVariant() if there is no result.
+	/// @param semanticAnalyzer - analyzer passed to tree interpreter for constructs left to it.
+	QVariant run(const LuaBytecode &bytecode, const core::SemanticAnalyzer &semanticAnalyzer);
+
+private:
+	void reportError(const LuaBytecode &bytecode, const Instruction &instruction, const QString &message);
+
+	LuaInterpreter &mInterpreter;
+	QList<core::Error> &mErrors;
+};
+
+}
+}
+}
@@ -15,7 +15,6 @@
 #include "thread.h"
 
 #include <QtWidgets/QApplication>
-#include <QtCore/QTimer>
 
 #include <qrkernel/settingsManager.h>
 
@@ -40,11 +39,9 @@ Thread::Thread(const GraphicalModelAssistInterface *graphicalModelApi
 	, mBlocksTable(blocksTable)
 	, mCurrentBlock(mBlocksTable.block(initialNode))
 	, mBlocksSincePreviousEventsProcessing(0)
-	, mProcessEventsTimer(new QTimer(this))
-	, mProcessEventsMapper(new QSignalMapper(this))
+	, mInterpretationPending(false)
 	, mId(threadId)
 {
-	initTimer();
 }
 
 Thread::Thread(const GraphicalModelAssistInterface *graphicalModelApi
@@ -60,11 +57,9 @@ Thread::Thread(const GraphicalModelAssistInterface *graphicalModelApi
 	, mCurrentBlock(nullptr)
 	, mInitialDiagram(diagramToInterpret)
 	, mBlocksSincePreviousEventsProcessing(0)
-	, mProcessEventsTimer(new QTimer(this))
-	, mProcessEventsMapper(new QSignalMapper(this))
+	, mInterpretationPending(false)
 	, mId(threadId)
 {
-	initTimer();
 }
 
 Thread::~Thread()
@@ -76,17 +71,6 @@ Thread::~Thread()
 	}
 }
 
-void Thread::initTimer()
-{
-	mProcessEventsTimer->setSingleShot(true);
-	mProcessEventsTimer->setInterval(0);
-	connect(mProcessEventsTimer, SIGNAL(timeout())
-			, mProcessEventsMapper, SLOT(map()));
-
-	connect(mProcessEventsMapper, SIGNAL(mapped(QObject*))
-			, this, SLOT(interpretAfterEventsProcessing(QObject*)));
-}
-
 void Thread::interpret()
 {
 	if (mCurrentBlock) {
@@ -204,27 +188,26 @@ void Thread::turnOn(BlockInterface * const block)
 		// Here we want to process all accumulated events and terminate blocks recursion
 		mBlocksSincePreviousEventsProcessing = 0;
 
-		// After timer was started control flow returns to event loop and
-		// among events there can be the one that destroys this thread instance.
-		// There are some suspicions that in QObject destructor children are removed
-		// not immediately but with deleteLater() method. So there is a small probability
-		// that slot will be triggered after this object is destroyed. Then
-		// we can not access fields, but can access alive block instance in mapper.
-		// Kind of hack, but quite an easy way not to suspend everything if
-		// interpreted program has an infinite loop without timers.
-		mProcessEventsMapper->removeMappings(mProcessEventsTimer);
-		mProcessEventsMapper->setMapping(mProcessEventsTimer, mCurrentBlock);
-		mProcessEventsTimer->start();
+		// Control flow returns to event loop and the block is interpreted when events posted before are processed.
+		// A posted call rather than zero timer is used so that the program is continued by any code that
+		// processes posted events, for example by 2D model timeline in fast-forward mode, not only by event loop.
+		// Posted call is dropped if this thread is destroyed meanwhile, and the block is tracked by guarded pointer.
+		// Only one call is kept in queue, it interprets the block that was deferred last.
+		mBlockAfterEventsProcessing = mCurrentBlock;
+		if (!mInterpretationPending) {
+			mInterpretationPending = true;
+			QMetaObject::invokeMethod(this, "interpretAfterEventsProcessing", Qt::QueuedConnection);
+		}
 	} else {
 		mCurrentBlock->interpret(this);
 	}
 }
 
-void Thread::interpretAfterEventsProcessing(QObject *blockObject)
+void Thread::interpretAfterEventsProcessing()
 {
-	BlockInterface * const block = dynamic_cast<BlockInterface *>(blockObject);
-	if (block) {
-		block->interpret(this);
+	mInterpretationPending = false;
+	if (mBlockAfterEventsProcessing) {
+		mBlockAfterEventsProcessing->interpret(this);
 	}
 }
 
@@ -17,7 +17,7 @@
 #include <QtCore/QObject>
 #include <QtCore/QStack>
 #include <QtCore/QQueue>
-#include <QtCore/QSignalMapper>
+#include <QtCore/QPointer>
 
 #include <qrkernel/ids.h>
 #include <qrgui/plugins/toolPluginInterface/usedInterfaces/mainWindowInterpretersInterface.h>
@@ -30,8 +30,6 @@
 #include <qrutils/interpreter/stopReason.h>
 #include <qrutils/utilsDeclSpec.h>
 
-class QTimer;
-
 namespace qReal {
 namespace interpretation {
 
@@ -106,11 +104,9 @@ private slots:
 
 	void failure();
 
-	void interpretAfterEventsProcessing(QObject *block);
+	void interpretAfterEventsProcessing();
 
 private:
-	void initTimer();
-
 	qReal::Id findStartingElement(const qReal::Id &diagram) const;
 	void error(const QString &message, const qReal::Id &source = qReal::Id());
 
@@ -127,8 +123,8 @@ private:
 	QStack<StackFrame> mStack;
 	const qReal::Id mInitialDiagram;
 	int mBlocksSincePreviousEventsProcessing;
-	QTimer *mProcessEventsTimer;  // Has ownership
-	QSignalMapper *mProcessEventsMapper;  // Has ownership
+	QPointer<BlockInterface> mBlockAfterEventsProcessing;  // Doesn't have ownership
+	bool mInterpretationPending;  // True when interpretAfterEventsProcessing() call is posted but not yet delivered.
 	QString mId;
 	QQueue<QString> mMessages;
 };